@@ -10,6 +10,7 @@
 #include "Omega_h_map.hpp"
 #include "Omega_h_profile.hpp"
 #include "Omega_h_quality.hpp"
+#include "Omega_h_quality_cache.hpp"
 #include "Omega_h_refine.hpp"
 #include "Omega_h_swap.hpp"
 #include "Omega_h_timer.hpp"
@@ -84,6 +85,9 @@ AdaptOpts::AdaptOpts(Int dim) {
   should_swap = true;
   should_coarsen_slivers = true;
   should_prevent_coarsen_flip = false;
+  should_randomize_indset = false;
+  indset_local_rounds = 1;
+  should_cache_collapse_qualities = false;
 }
 
 static Reals get_fixable_qualities(Mesh* mesh, AdaptOpts const&) {
@@ -286,9 +290,14 @@ bool adapt(Mesh* mesh, AdaptOpts const& opts) {
   if (!pre_adapt(mesh, opts)) return false;
   setup_conservation_tags(mesh, opts);
   auto t1 = now();
-  satisfy_lengths(mesh, opts);
-  auto t2 = now();
-  snap_and_satisfy_quality(mesh, opts);
+  Now t2;
+  {
+    /* cavity qualities are reused across the passes of this adapt only */
+    ScopedCavityQualityCaches cavity_quality_caches(mesh, opts);
+    satisfy_lengths(mesh, opts);
+    t2 = now();
+    snap_and_satisfy_quality(mesh, opts);
+  }
   auto t3 = now();
   correct_integral_errors(mesh, opts);
   auto t4 = now();
@@ -73,6 +73,12 @@ struct AdaptOpts {
   bool should_swap;
   bool should_coarsen_slivers;
   bool should_prevent_coarsen_flip;
+  /* see find_indset() */
+  bool should_randomize_indset;
+  Int indset_local_rounds;
+  /* keep collapse qualities across passes, see Omega_h_quality_cache.hpp.
+     off by default: few collapse cavities are evaluated twice */
+  bool should_cache_collapse_qualities;
   TransferOpts xfer_opts;
 };
 
@@ -114,6 +120,7 @@ struct MetricInput {
   bool should_limit_gradation;
   Real max_gradation_rate;
   Real gradation_convergence_tolerance;
+  bool should_use_gradation_worklist;
   bool should_limit_element_count;
   Real max_element_count;
   Real min_element_count;
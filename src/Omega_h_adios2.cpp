@@ -20,6 +20,8 @@ Omega_h_Type getOmegahDataType(const std::string &dataType)
     return OMEGA_H_I32;
   if (dataType == "int64_t")
     return OMEGA_H_I64;
+  if (dataType == "float")
+    return OMEGA_H_F32;
   if (dataType == "double")
     return OMEGA_H_F64;
 
@@ -3,6 +3,7 @@
 #include "Omega_h_align.hpp"
 #include "Omega_h_amr.hpp"
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_atomics.hpp"
 #include "Omega_h_element.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_int_scan.hpp"
@@ -10,8 +11,18 @@
 #include "Omega_h_sort.hpp"
 #include "Omega_h_timer.hpp"
 
+#include <cstdint>
+
 namespace Omega_h {
 
+static bool hashed_dedup_enabled = false;
+
+void enable_hashed_dedup() { hashed_dedup_enabled = true; }
+
+void disable_hashed_dedup() { hashed_dedup_enabled = false; }
+
+bool is_hashed_dedup_enabled() { return hashed_dedup_enabled; }
+
 Adj unmap_adjacency(LOs const a2b, Adj const b2c) {
   OMEGA_H_TIME_FUNCTION;
   auto const b2bc = b2c.a2ab;
@@ -130,7 +141,103 @@ Read<I8> find_canonical_jumps(
   return jumps;
 }
 
+/* a concurrent hash table of canonical vertex tuples:
+   open addressing with linear probing in a power-of-two array of slots.
+   a slot holds -1 if empty, otherwise the smallest index among the tuples
+   inserted with that key, so the contents don't depend on the order
+   in which threads get to insert. */
+
+template <Int deg>
+OMEGA_H_DEVICE std::uint64_t hash_tuple(LOs const& canon, LO e) {
+  std::uint64_t h = 0x9E3779B97F4A7C15ULL;
+  for (Int j = 0; j < deg; ++j) {
+    h ^= std::uint64_t(std::uint32_t(canon[e * deg + j]));
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 31;
+  }
+  return h;
+}
+
+template <Int deg>
+OMEGA_H_DEVICE bool are_equal_tuples(
+    LOs const& a_canon, LO a, LOs const& b_canon, LO b) {
+  for (Int j = 0; j < deg; ++j) {
+    if (a_canon[a * deg + j] != b_canon[b * deg + j]) return false;
+  }
+  return true;
+}
+
+static LO get_tuple_table_capacity(LO n) {
+  LO capacity = 1;
+  while (capacity < 2 * n) capacity *= 2;
+  return capacity;
+}
+
+template <Int deg>
+static Write<LO> insert_tuples(LOs const canon) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const n = divide_no_remainder(canon.size(), deg);
+  auto const capacity = get_tuple_table_capacity(n);
+  auto const mask = std::uint64_t(capacity - 1);
+  Write<LO> table(capacity, -1);
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    auto slot = LO(hash_tuple<deg>(canon, e) & mask);
+    while (true) {
+      auto const other = atomic_compare_exchange(&table[slot], -1, e);
+      if (other == -1) return;
+      if (are_equal_tuples<deg>(canon, other, canon, e)) {
+        atomic_min(&table[slot], e);
+        return;
+      }
+      slot = LO((std::uint64_t(slot) + 1) & mask);
+    }
+  };
+  parallel_for(n, std::move(f));
+  return table;
+}
+
+/* returns the table entry holding the same tuple as key_canon[key],
+   which must be there */
+template <Int deg>
+OMEGA_H_DEVICE LO find_tuple(LOs const& table, LOs const& table_canon,
+    LOs const& key_canon, LO key) {
+  auto const mask = std::uint64_t(table.size() - 1);
+  auto slot = LO(hash_tuple<deg>(key_canon, key) & mask);
+  while (true) {
+    auto const e = table[slot];
+    OMEGA_H_CHECK(e != -1);
+    if (are_equal_tuples<deg>(table_canon, e, key_canon, key)) return e;
+    slot = LO((std::uint64_t(slot) + 1) & mask);
+  }
+}
+
+template <Int deg>
+static LOs find_unique_hashed_deg(LOs const uv2v) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const codes = get_codes_to_canonical(deg, uv2v);
+  auto const uv2v_canon = align_ev2v(deg, uv2v, codes);
+  auto const table = LOs(insert_tuples<deg>(uv2v_canon));
+  auto const nu = divide_no_remainder(uv2v.size(), deg);
+  /* each occupied slot holds one unique entity */
+  Write<I8> is_first(nu, 0);
+  auto f = OMEGA_H_LAMBDA(LO slot) {
+    auto const u = table[slot];
+    if (u != -1) is_first[u] = 1;
+  };
+  parallel_for(table.size(), std::move(f));
+  auto const e2u = collect_marked(read(is_first));
+  return unmap<LO>(e2u, uv2v, deg);
+}
+
+static LOs find_unique_hashed(Int const deg, LOs const uv2v) {
+  if (deg == 2) return find_unique_hashed_deg<2>(uv2v);
+  if (deg == 3) return find_unique_hashed_deg<3>(uv2v);
+  if (deg == 4) return find_unique_hashed_deg<4>(uv2v);
+  OMEGA_H_NORETURN(LOs());
+}
+
 static LOs find_unique_deg(Int const deg, LOs const uv2v) {
+  if (hashed_dedup_enabled) return find_unique_hashed(deg, uv2v);
   OMEGA_H_TIME_FUNCTION;
   auto const codes = get_codes_to_canonical(deg, uv2v);
   auto const uv2v_canon = align_ev2v(deg, uv2v, codes);
@@ -330,6 +437,67 @@ Adj invert_adj(Adj const down, Int const nlows_per_high, LO const nlows,
   return Adj(l2lh, lh2h, codes);
 }
 
+Adj update_up(Adj const old_l2h, LOs const old_lows2new_lows,
+    LO const nnew_lows, LOs const old_highs2new_highs,
+    Adj const prods2new_lows, LOs const prods2new_highs,
+    Int const nlows_per_high, Int const high_dim, Int const low_dim) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const nold_lows = old_lows2new_lows.size();
+  Write<LO> new_lows2old_lows(nnew_lows, -1);
+  auto invert = OMEGA_H_LAMBDA(LO old_low) {
+    auto const new_low = old_lows2new_lows[old_low];
+    if (new_low >= 0) new_lows2old_lows[new_low] = old_low;
+  };
+  parallel_for(nold_lows, std::move(invert), "update_up(invert)");
+  /* only the products are inverted, the highs kept from the old mesh
+     keep their codes since their downward adjacencies were copied */
+  auto const l2prod = invert_adj(
+      prods2new_lows, nlows_per_high, nnew_lows, high_dim, low_dim);
+  auto const l2lp = l2prod.a2ab;
+  auto const lp2p = l2prod.ab2b;
+  auto const lp_codes = l2prod.codes;
+  auto const old_l2lh = old_l2h.a2ab;
+  auto const old_lh2h = old_l2h.ab2b;
+  auto const old_lh_codes = old_l2h.codes;
+  Write<LO> degrees(nnew_lows);
+  auto count = OMEGA_H_LAMBDA(LO l) {
+    LO degree = l2lp[l + 1] - l2lp[l];
+    auto const old_l = new_lows2old_lows[l];
+    if (old_l >= 0) {
+      for (auto lh = old_l2lh[old_l]; lh < old_l2lh[old_l + 1]; ++lh) {
+        if (old_highs2new_highs[old_lh2h[lh]] >= 0) ++degree;
+      }
+    }
+    degrees[l] = degree;
+  };
+  parallel_for(nnew_lows, std::move(count), "update_up(count)");
+  auto const l2lh = offset_scan(read(degrees));
+  Write<LO> lh2h(l2lh.last());
+  Write<I8> codes(l2lh.last());
+  auto fill = OMEGA_H_LAMBDA(LO l) {
+    auto lh = l2lh[l];
+    auto const old_l = new_lows2old_lows[l];
+    if (old_l >= 0) {
+      for (auto old_lh = old_l2lh[old_l]; old_lh < old_l2lh[old_l + 1];
+           ++old_lh) {
+        auto const h = old_highs2new_highs[old_lh2h[old_lh]];
+        if (h < 0) continue;
+        lh2h[lh] = h;
+        codes[lh] = old_lh_codes[old_lh];
+        ++lh;
+      }
+    }
+    for (auto lp = l2lp[l]; lp < l2lp[l + 1]; ++lp) {
+      lh2h[lh] = prods2new_highs[lp2p[lp]];
+      codes[lh] = lp_codes[lp];
+      ++lh;
+    }
+  };
+  parallel_for(nnew_lows, std::move(fill), "update_up(fill)");
+  sort_by_high_index(l2lh, lh2h, codes);
+  return Adj(l2lh, lh2h, codes);
+}
+
 Bytes filter_parents(Parents const c2p, Int const parent_dim) {
   OMEGA_H_TIME_FUNCTION;
   Write<Byte> filter(c2p.parent_idx.size());
@@ -517,8 +685,47 @@ Adj reflect_down(LOs const hv2v, LOs const lv2v, Adj const v2l,
   return Adj(read(hl2l), read(codes));
 }
 
+template <Int deg>
+static Adj reflect_down_hashed_deg(LOs const uv2v, LOs const lv2v) {
+  auto const l_codes = get_codes_to_canonical(deg, lv2v);
+  auto const lv2v_canon = align_ev2v(deg, lv2v, l_codes);
+  auto const table = LOs(insert_tuples<deg>(lv2v_canon));
+  auto const u_codes = get_codes_to_canonical(deg, uv2v);
+  auto const uv2v_canon = align_ev2v(deg, uv2v, u_codes);
+  auto const nu = divide_no_remainder(uv2v.size(), deg);
+  Write<LO> u2l(nu);
+  Write<I8> codes(nu);
+  auto f = OMEGA_H_LAMBDA(LO u) {
+    auto const l = find_tuple<deg>(table, lv2v_canon, uv2v_canon, u);
+    Int which_down = 0;
+    while (lv2v[l * deg + which_down] != uv2v[u * deg]) ++which_down;
+    I8 code = 0;
+    auto const found =
+        IsMatch<deg>::eval(uv2v, u * deg, lv2v, l * deg, which_down, &code);
+    OMEGA_H_CHECK(found);
+    u2l[u] = l;
+    codes[u] = code;
+  };
+  parallel_for(nu, std::move(f));
+  return Adj(read(u2l), read(codes));
+}
+
+Adj reflect_down_hashed(LOs const hv2v, LOs const lv2v,
+    Omega_h_Family const family, Int const high_dim, Int const low_dim) {
+  ScopedTimer timer("reflect_down(hashed)");
+  LOs const uv2v = form_uses(hv2v, family, high_dim, low_dim);
+  auto const deg = element_degree(family, low_dim, VERT);
+  if (deg == 2) return reflect_down_hashed_deg<2>(uv2v, lv2v);
+  if (deg == 3) return reflect_down_hashed_deg<3>(uv2v, lv2v);
+  if (deg == 4) return reflect_down_hashed_deg<4>(uv2v, lv2v);
+  OMEGA_H_NORETURN(Adj());
+}
+
 Adj reflect_down(LOs const hv2v, LOs const lv2v, Omega_h_Family const family,
     LO const nv, Int const high_dim, Int const low_dim) {
+  if (hashed_dedup_enabled) {
+    return reflect_down_hashed(hv2v, lv2v, family, high_dim, low_dim);
+  }
   ScopedTimer timer("reflect_down(nv)");
   auto const nverts_per_low = element_degree(family, low_dim, 0);
   auto const l2v = Adj(lv2v);
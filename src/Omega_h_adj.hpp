@@ -57,6 +57,17 @@ Adj invert_adj(Adj const down, Int const nlows_per_high, LO const nlows,
 Adj invert_adj(Adj const down, Int const nlows_per_high, LO const nlows,
     Topo_type high_type, Topo_type low_type);
 
+/* The upward adjacency of a mesh that modify_ents() built from an old
+   one, updated from old_l2h (the upward adjacency of the old mesh)
+   instead of derived again: the kept highs are renamed and the products
+   (given by their downward adjacency) are merged in, so only the
+   products are inverted. The result is the same as invert_adj() of the
+   new downward adjacency. Maps are -1 for entities that were removed. */
+Adj update_up(Adj const old_l2h, LOs const old_lows2new_lows,
+    LO const nnew_lows, LOs const old_highs2new_highs,
+    Adj const prods2new_lows, LOs const prods2new_highs,
+    Int const nlows_per_high, Int const high_dim, Int const low_dim);
+
 Children invert_parents(Parents const children2parents, Int const parent_dim,
     Int const nparent_dim_ents);
 
@@ -103,10 +114,26 @@ void find_matches_ex(Int const deg, LOs const a2fv, Read<T> const av2v,
     bool const allow_duplicates = false);
 
 /* for testing only, internally computes upward
-   adjacency */
+   adjacency (unless hashed deduplication is enabled) */
 Adj reflect_down(LOs const hv2v, LOs const lv2v, Omega_h_Family const family,
     LO const nv, Int const high_dim, Int const low_dim);
 
+/* reflect_down without the upward adjacency:
+   uses are matched to low entities through a hash table
+   of their canonical vertex tuples */
+Adj reflect_down_hashed(LOs const hv2v, LOs const lv2v,
+    Omega_h_Family const family, Int const high_dim, Int const low_dim);
+
+/* By default find_unique sorts all entity uses by their canonical
+   vertex tuples to find the unique ones. When hashed deduplication
+   is enabled it inserts the tuples into a concurrent hash table instead,
+   and building a mesh from elements to vertices also matches entity uses
+   with reflect_down_hashed.
+   Both methods find the same entities, but in a different order. */
+void enable_hashed_dedup();
+void disable_hashed_dedup();
+bool is_hashed_dedup_enabled();
+
 Adj transit(Adj const h2m, Adj const m2l, Omega_h_Family const family,
     Int const high_dim, Int const low_dim);
 
@@ -146,7 +146,7 @@ static void refine_elem_based(Mesh* mesh, TransferOpts xfer_opts) {
         prods2verts, old_lows2new_lows, /*keep_mods*/ true,
         /*mods_can_be_shared*/ true, &(prods2new_ents[prod_dim]),
         &(same_ents2old_ents[prod_dim]), &(same_ents2new_ents[prod_dim]),
-        &(old_ents2new_ents[prod_dim]));
+        &(old_ents2new_ents[prod_dim]), old_ents2new_ents[VERT]);
     if (prod_dim == VERT) {
       mods2midverts[VERT] =
           unmap(mods2mds[VERT], old_ents2new_ents[prod_dim], 1);
@@ -10,22 +10,35 @@ namespace Omega_h {
 
 namespace amr {
 
+template <typename T>
+static void transfer_linear_interp_tmpl(Mesh* old_mesh, Mesh* new_mesh,
+    Few<LOs, 4> mods2mds, Few<LOs, 4> mods2midverts, LOs same_ents2old_ents,
+    LOs same_ents2new_ents, TagBase const* tagbase) {
+  auto ncomps = tagbase->ncomps();
+  auto old_data = old_mesh->get_array<T>(VERT, tagbase->name());
+  auto new_data = Write<T>(new_mesh->nverts() * ncomps);
+  for (Int mod_dim = 1; mod_dim <= old_mesh->dim(); ++mod_dim) {
+    auto prod_data =
+        average_field(old_mesh, mod_dim, mods2mds[mod_dim], ncomps, old_data);
+    map_into(prod_data, mods2midverts[mod_dim], new_data, ncomps);
+  }
+  transfer_common2(old_mesh, new_mesh, VERT, same_ents2old_ents,
+      same_ents2new_ents, tagbase, new_data);
+}
+
 void transfer_linear_interp(Mesh* old_mesh, Mesh* new_mesh,
     Few<LOs, 4> mods2mds, Few<LOs, 4> mods2midverts, LOs same_ents2old_ents,
     LOs same_ents2new_ents, TransferOpts opts) {
   for (Int i = 0; i < old_mesh->ntags(VERT); ++i) {
     auto tagbase = old_mesh->get_tag(VERT, i);
     if (!should_interpolate(old_mesh, opts, VERT, tagbase)) continue;
-    auto ncomps = tagbase->ncomps();
-    auto old_data = old_mesh->get_array<Real>(VERT, tagbase->name());
-    auto new_data = Write<Real>(new_mesh->nverts() * ncomps);
-    for (Int mod_dim = 1; mod_dim <= old_mesh->dim(); ++mod_dim) {
-      auto prod_data =
-          average_field(old_mesh, mod_dim, mods2mds[mod_dim], ncomps, old_data);
-      map_into(prod_data, mods2midverts[mod_dim], new_data, ncomps);
+    if (tagbase->type() == OMEGA_H_F32) {
+      transfer_linear_interp_tmpl<F32>(old_mesh, new_mesh, mods2mds,
+          mods2midverts, same_ents2old_ents, same_ents2new_ents, tagbase);
+    } else {
+      transfer_linear_interp_tmpl<Real>(old_mesh, new_mesh, mods2mds,
+          mods2midverts, same_ents2old_ents, same_ents2new_ents, tagbase);
     }
-    transfer_common2(old_mesh, new_mesh, VERT, same_ents2old_ents,
-        same_ents2new_ents, tagbase, new_data);
   }
 }
 
@@ -178,6 +191,10 @@ static void transfer_inherit(Mesh* old_mesh, Mesh* new_mesh,
       amr::transfer_inherit<I64>(old_mesh, new_mesh, prods2new_ents,
           same_ents2old_ents, same_ents2new_ents, name);
       break;
+    case OMEGA_H_F32:
+      amr::transfer_inherit<F32>(old_mesh, new_mesh, prods2new_ents,
+          same_ents2old_ents, same_ents2new_ents, name);
+      break;
     case OMEGA_H_F64:
       amr::transfer_inherit<Real>(old_mesh, new_mesh, prods2new_ents,
           same_ents2old_ents, same_ents2new_ents, name);
@@ -1,6 +1,6 @@
 #include "Omega_h_adapt.hpp"
 
-#include "Omega_h_array_ops.hpp"
+#include "Omega_h_array_expr.hpp"
 #include "Omega_h_metric.hpp"
 #include "Omega_h_shape.hpp"
 
@@ -67,11 +67,11 @@ bool warp_to_limit(
           "min quality %.2e max length %.2e\n",
           i, min_fixable_quality(mesh, opts), mesh->max_length());
     }
-    auto half_warp = divide_each_by(warp, 2.0);
+    /* the step is the original warp times factor, a power of two,
+       so it is applied without storing it */
     factor /= 2.0;
-    warp = half_warp;
-    remainder = add_each(remainder, half_warp);
-    mesh->set_coords(add_each(coords, warp));
+    remainder = evaluate(lazy(remainder) + lazy(warp) * factor);
+    mesh->set_coords(evaluate(lazy(coords) + lazy(warp) * factor));
   } while (!okay(mesh, opts));
   if (opts.verbosity >= EACH_REBUILD && can_print(mesh)) {
     std::cout << "warp_to_limit moved by factor " << factor << '\n';
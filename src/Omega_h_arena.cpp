@@ -0,0 +1,144 @@
+#include <Omega_h_arena.hpp>
+#include <Omega_h_fail.hpp>
+#include <Omega_h_malloc.hpp>
+#include <cstdint>
+
+namespace Omega_h {
+
+static thread_local ScopedArena* innermost_arena = nullptr;
+
+static std::size_t round_up_to_alignment(std::size_t size) {
+  return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+static void free_chunk(ArenaChunk* chunk) {
+  maybe_pooled_host_free(chunk->storage, chunk->capacity + ARENA_ALIGNMENT);
+  delete chunk;
+}
+
+ScopedArena::ScopedArena(std::size_t chunk_bytes)
+    : active_(nullptr),
+      outer_(innermost_arena),
+      chunk_bytes_(round_up_to_alignment(chunk_bytes)),
+      nallocs_(0) {
+  OMEGA_H_CHECK(chunk_bytes_ > 0);
+  innermost_arena = this;
+}
+
+ScopedArena::~ScopedArena() {
+  OMEGA_H_CHECK(innermost_arena == this);
+  innermost_arena = outer_;
+  /* chunks with live arrays are freed when the last of them dies */
+  for (auto chunk : chunks_) {
+    if (chunk->nlive.fetch_sub(1) == 1) free_chunk(chunk);
+  }
+}
+
+ArenaChunk* ScopedArena::new_chunk() {
+  /* the chunks themselves come from the pool when it is enabled,
+     so consecutive passes recycle the same chunks */
+  auto const storage =
+      maybe_pooled_host_malloc(chunk_bytes_ + ARENA_ALIGNMENT);
+  if (storage == nullptr) return nullptr;
+  auto const address = reinterpret_cast<std::uintptr_t>(storage);
+  auto const aligned = round_up_to_alignment(address);
+  auto chunk = new ArenaChunk;
+  chunk->storage = storage;
+  chunk->data = reinterpret_cast<char*>(aligned);
+  chunk->capacity = chunk_bytes_;
+  chunk->used = 0;
+  chunk->nlive = 1;
+  chunks_.push_back(chunk);
+  return chunk;
+}
+
+/* only this thread adds to nlive, so once the arena's own reference
+   is all that is left no other thread can use the chunk */
+static void rewind_if_dead(ArenaChunk* chunk) {
+  if (chunk->nlive.load() == 1) chunk->used = 0;
+}
+
+void* ScopedArena::allocate(std::size_t size, ArenaChunk** chunk_out) {
+  if (size == 0 || size > chunk_bytes_ / 8) return nullptr;
+  auto const nbytes = round_up_to_alignment(size);
+  if (active_ != nullptr) rewind_if_dead(active_);
+  if (active_ == nullptr || active_->used + nbytes > active_->capacity) {
+    active_ = nullptr;
+    for (auto chunk : chunks_) {
+      rewind_if_dead(chunk);
+      if (chunk->used + nbytes <= chunk->capacity) {
+        active_ = chunk;
+        break;
+      }
+    }
+    if (active_ == nullptr) active_ = new_chunk();
+    if (active_ == nullptr) return nullptr;
+  }
+  auto const ptr = active_->data + active_->used;
+  active_->used += nbytes;
+  ++(active_->nlive);
+  ++nallocs_;
+  *chunk_out = active_;
+  return ptr;
+}
+
+bool ScopedArena::owns(void const* ptr) const {
+  auto const p = static_cast<char const*>(ptr);
+  for (auto chunk : chunks_) {
+    if (chunk->data <= p && p < chunk->data + chunk->capacity) return true;
+  }
+  return false;
+}
+
+std::size_t ScopedArena::nallocs() const { return nallocs_; }
+
+std::size_t ScopedArena::bytes_reserved() const {
+  return chunks_.size() * chunk_bytes_;
+}
+
+ScopedNoArena::ScopedNoArena() : suspended_(innermost_arena) {
+  innermost_arena = nullptr;
+}
+
+ScopedNoArena::~ScopedNoArena() {
+  OMEGA_H_CHECK(innermost_arena == nullptr);
+  innermost_arena = suspended_;
+}
+
+ScopedArena* current_arena() { return innermost_arena; }
+
+void* arena_allocate(std::size_t size, ArenaChunk** chunk_out) {
+  if (innermost_arena == nullptr) return nullptr;
+  return innermost_arena->allocate(size, chunk_out);
+}
+
+void arena_release(ArenaChunk* chunk) {
+  auto const nlive = chunk->nlive.fetch_sub(1);
+  OMEGA_H_CHECK(nlive > 0);
+  /* the arena closed before this, the last of its arrays */
+  if (nlive == 1) free_chunk(chunk);
+}
+
+bool is_arena_allocated(void const* ptr) {
+  for (auto arena = innermost_arena; arena; arena = arena->outer_) {
+    if (arena->owns(ptr)) return true;
+  }
+  return false;
+}
+
+template <typename T>
+Read<T> promote_from_arena(Read<T> a) {
+  if (!a.exists() || !is_arena_allocated(a.data())) return a;
+  ScopedNoArena no_arena;
+  return deep_copy(a, a.name());
+}
+
+#define INST(T) template Read<T> promote_from_arena(Read<T> a);
+INST(I8)
+INST(I32)
+INST(I64)
+INST(F32)
+INST(Real)
+#undef INST
+
+}  // end namespace Omega_h
@@ -0,0 +1,102 @@
+#ifndef OMEGA_H_ARENA_HPP
+#define OMEGA_H_ARENA_HPP
+
+#include <Omega_h_array.hpp>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Omega_h {
+
+/* arena allocations are aligned to this many bytes */
+constexpr std::size_t ARENA_ALIGNMENT = 64;
+constexpr std::size_t ARENA_DEFAULT_CHUNK_BYTES = std::size_t(16) << 20;
+
+struct ArenaChunk {
+  /* as returned by the underlying allocator */
+  void* storage;
+  char* data;
+  std::size_t capacity;
+  std::size_t used;
+  /* allocations carved from this chunk that are still alive, plus one
+     while the owning arena is open. arrays may die on any thread, so
+     this is the only field other threads touch; whoever brings it to
+     zero frees the chunk, and only the owning thread rewinds it */
+  std::atomic<int> nlive;
+};
+
+/* while a ScopedArena is open, arrays (Write<T> and friends) created by
+   this thread are carved out of large chunks with a bump pointer instead
+   of going through the pool or malloc one by one.
+   arrays larger than chunk_bytes / 8 still get their own allocation.
+   a chunk is rewound once all its arrays have died, and all chunks are
+   released when the scope closes.
+   arrays may be released by threads other than the one that created
+   them.
+   arrays that outlive the scope remain valid: their chunk is kept alive
+   until they die. Mesh promotes tags and adjacencies it is given out of
+   the arena, so arrays stored on a mesh never pin a chunk.
+   arenas nest; the innermost open one is used.
+   with Kokkos enabled arrays are not allocated through Alloc and the
+   arena is never used. */
+class ScopedArena {
+ public:
+  explicit ScopedArena(std::size_t chunk_bytes = ARENA_DEFAULT_CHUNK_BYTES);
+  ~ScopedArena();
+  ScopedArena(ScopedArena const&) = delete;
+  ScopedArena(ScopedArena&&) = delete;
+  ScopedArena& operator=(ScopedArena const&) = delete;
+  ScopedArena& operator=(ScopedArena&&) = delete;
+  void* allocate(std::size_t size, ArenaChunk** chunk_out);
+  bool owns(void const* ptr) const;
+  std::size_t nallocs() const;
+  std::size_t bytes_reserved() const;
+
+ private:
+  ArenaChunk* new_chunk();
+  friend bool is_arena_allocated(void const* ptr);
+  std::vector<ArenaChunk*> chunks_;
+  ArenaChunk* active_;
+  ScopedArena* outer_;
+  std::size_t chunk_bytes_;
+  std::size_t nallocs_;
+};
+
+/* suspends the open arenas of this thread while alive, so that arrays
+   made for long-lived structures get regular storage and don't pin a
+   chunk. arenas opened inside it are used as usual */
+class ScopedNoArena {
+ public:
+  ScopedNoArena();
+  ~ScopedNoArena();
+  ScopedNoArena(ScopedNoArena const&) = delete;
+  ScopedNoArena& operator=(ScopedNoArena const&) = delete;
+
+ private:
+  ScopedArena* suspended_;
+};
+
+/* the innermost open arena of this thread, or nullptr */
+ScopedArena* current_arena();
+/* returns nullptr if there is no open arena or the size doesn't fit one */
+void* arena_allocate(std::size_t size, ArenaChunk** chunk_out);
+void arena_release(ArenaChunk* chunk);
+/* whether ptr lies in a chunk of any open arena of this thread */
+bool is_arena_allocated(void const* ptr);
+
+/* returns a, or a copy of a in regular storage if it lives in an arena */
+template <typename T>
+Read<T> promote_from_arena(Read<T> a);
+
+#define OMEGA_H_EXPL_INST_DECL(T)                                              \
+  extern template Read<T> promote_from_arena(Read<T> a);
+OMEGA_H_EXPL_INST_DECL(I8)
+OMEGA_H_EXPL_INST_DECL(I32)
+OMEGA_H_EXPL_INST_DECL(I64)
+OMEGA_H_EXPL_INST_DECL(F32)
+OMEGA_H_EXPL_INST_DECL(Real)
+#undef OMEGA_H_EXPL_INST_DECL
+
+}  // end namespace Omega_h
+
+#endif
@@ -349,6 +349,7 @@ Write<T> deep_copy(Read<T> a, std::string const& name) {
 INST(I8)
 INST(I32)
 INST(I64)
+INST(F32)
 INST(Real)
 #undef INST
 
@@ -0,0 +1,403 @@
+#ifndef OMEGA_H_ARRAY_EXPR_HPP
+#define OMEGA_H_ARRAY_EXPR_HPP
+
+#include <type_traits>
+
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_for.hpp>
+#include <Omega_h_int_iterator.hpp>
+#include <Omega_h_reduce.hpp>
+
+/* lazily evaluated elementwise array expressions.
+   a chain such as
+     evaluate(lazy(a) * lazy(b) + lazy(c))
+   or
+     get_min(comm, each_leq_to(fabs_each(lazy(a)), tol))
+   builds a tree of small functors and runs it as a single
+   parallel_for (evaluate) or a single reduction (get_sum, get_min,
+   get_max), instead of allocating and streaming a temporary array
+   at every step like the eager functions in Omega_h_array_ops.hpp.
+   all arrays in one expression must have the same size,
+   scalars are broadcast */
+
+namespace Omega_h {
+
+namespace expr {
+
+/* the size of an expression node, or -1 for a broadcast constant */
+inline LO combine_sizes(LO a, LO b) {
+  if (a < 0) return b;
+  if (b < 0) return a;
+  OMEGA_H_CHECK(a == b);
+  return a;
+}
+
+template <typename T>
+struct Leaf {
+  using value_type = T;
+  Read<T> a;
+  OMEGA_H_INLINE T operator()(LO i) const { return a[i]; }
+  LO size() const { return a.size(); }
+};
+
+template <typename T>
+struct Constant {
+  using value_type = T;
+  T value;
+  OMEGA_H_INLINE T operator()(LO) const { return value; }
+  LO size() const { return -1; }
+};
+
+template <typename Op, typename A, typename B>
+struct Binary {
+  using value_type = typename Op::template result<typename A::value_type,
+      typename B::value_type>::type;
+  A a;
+  B b;
+  OMEGA_H_INLINE value_type operator()(LO i) const {
+    return Op::apply(a(i), b(i));
+  }
+  LO size() const { return combine_sizes(a.size(), b.size()); }
+};
+
+template <typename Op, typename A>
+struct Unary {
+  using value_type = typename A::value_type;
+  A a;
+  OMEGA_H_INLINE value_type operator()(LO i) const { return Op::apply(a(i)); }
+  LO size() const { return a.size(); }
+};
+
+template <typename A>
+struct Component {
+  using value_type = typename A::value_type;
+  A a;
+  Int ncomps;
+  Int comp;
+  OMEGA_H_INLINE value_type operator()(LO i) const {
+    return a(i * ncomps + comp);
+  }
+  LO size() const { return divide_no_remainder(a.size(), LO(ncomps)); }
+};
+
+template <typename Op, typename A, typename B, typename C>
+struct Ternary {
+  using value_type = typename Op::template result<typename B::value_type,
+      typename C::value_type>::type;
+  A a;
+  B b;
+  C c;
+  OMEGA_H_INLINE value_type operator()(LO i) const {
+    return Op::apply(a(i), b(i), c(i));
+  }
+  LO size() const {
+    return combine_sizes(a.size(), combine_sizes(b.size(), c.size()));
+  }
+};
+
+struct Arithmetic {
+  template <typename A, typename B>
+  struct result {
+    using type = typename std::common_type<A, B>::type;
+  };
+};
+
+struct Comparison {
+  template <typename A, typename B>
+  struct result {
+    using type = I8;
+  };
+};
+
+struct Add : public Arithmetic {
+  template <typename A, typename B>
+  static OMEGA_H_INLINE typename result<A, B>::type apply(A a, B b) {
+    return static_cast<typename result<A, B>::type>(a + b);
+  }
+};
+
+struct Subtract : public Arithmetic {
+  template <typename A, typename B>
+  static OMEGA_H_INLINE typename result<A, B>::type apply(A a, B b) {
+    return static_cast<typename result<A, B>::type>(a - b);
+  }
+};
+
+struct Multiply : public Arithmetic {
+  template <typename A, typename B>
+  static OMEGA_H_INLINE typename result<A, B>::type apply(A a, B b) {
+    return static_cast<typename result<A, B>::type>(a * b);
+  }
+};
+
+struct Divide : public Arithmetic {
+  template <typename A, typename B>
+  static OMEGA_H_INLINE typename result<A, B>::type apply(A a, B b) {
+    return static_cast<typename result<A, B>::type>(a / b);
+  }
+};
+
+/* like divide_each_maybe_zero, zero divided by zero is zero */
+struct DivideMaybeZero : public Arithmetic {
+  template <typename A, typename B>
+  static OMEGA_H_INLINE typename result<A, B>::type apply(A a, B b) {
+    using R = typename result<A, B>::type;
+    if (b != B(0)) return static_cast<R>(a / b);
+    OMEGA_H_CHECK(a == A(0));
+    return R(0);
+  }
+};
+
+struct Min : public Arithmetic {
+  template <typename A, typename B>
+  static OMEGA_H_INLINE typename result<A, B>::type apply(A a, B b) {
+    using R = typename result<A, B>::type;
+    return min2(static_cast<R>(a), static_cast<R>(b));
+  }
+};
+
+struct Max : public Arithmetic {
+  template <typename A, typename B>
+  static OMEGA_H_INLINE typename result<A, B>::type apply(A a, B b) {
+    using R = typename result<A, B>::type;
+    return max2(static_cast<R>(a), static_cast<R>(b));
+  }
+};
+
+struct Less : public Comparison {
+  template <typename A, typename B>
+  static OMEGA_H_INLINE I8 apply(A a, B b) {
+    return a < b;
+  }
+};
+
+struct LessEqual : public Comparison {
+  template <typename A, typename B>
+  static OMEGA_H_INLINE I8 apply(A a, B b) {
+    return a <= b;
+  }
+};
+
+struct Greater : public Comparison {
+  template <typename A, typename B>
+  static OMEGA_H_INLINE I8 apply(A a, B b) {
+    return a > b;
+  }
+};
+
+struct GreaterEqual : public Comparison {
+  template <typename A, typename B>
+  static OMEGA_H_INLINE I8 apply(A a, B b) {
+    return a >= b;
+  }
+};
+
+struct Negate {
+  template <typename A>
+  static OMEGA_H_INLINE A apply(A a) {
+    return -a;
+  }
+};
+
+struct Fabs {
+  template <typename A>
+  static OMEGA_H_INLINE A apply(A a) {
+    return (a < A(0)) ? -a : a;
+  }
+};
+
+struct Select : public Arithmetic {
+  template <typename C, typename A, typename B>
+  static OMEGA_H_INLINE typename result<A, B>::type apply(C c, A a, B b) {
+    using R = typename result<A, B>::type;
+    return c ? static_cast<R>(a) : static_cast<R>(b);
+  }
+};
+
+}  // namespace expr
+
+/* wraps an expression node so that the operators below only
+   apply to lazy expressions */
+template <typename E>
+struct Lazy {
+  using value_type = typename E::value_type;
+  E node;
+  OMEGA_H_INLINE value_type operator()(LO i) const { return node(i); }
+  LO size() const { return node.size(); }
+};
+
+template <typename T>
+Lazy<expr::Leaf<T>> lazy(Read<T> a) {
+  return {{a}};
+}
+
+template <typename T>
+Lazy<expr::Leaf<T>> lazy(Write<T> a) {
+  return {{Read<T>(a)}};
+}
+
+template <typename T>
+Lazy<expr::Constant<T>> lazy_constant(T value) {
+  return {{value}};
+}
+
+template <typename Op, typename A, typename B>
+Lazy<expr::Binary<Op, A, B>> make_binary(Lazy<A> const& a, Lazy<B> const& b) {
+  expr::combine_sizes(a.size(), b.size());
+  return {{a.node, b.node}};
+}
+
+#define OMEGA_H_LAZY_BINARY(name, Op)                                          \
+  template <typename A, typename B>                                            \
+  Lazy<expr::Binary<expr::Op, A, B>> name(                                     \
+      Lazy<A> const& a, Lazy<B> const& b) {                                    \
+    return make_binary<expr::Op>(a, b);                                        \
+  }                                                                            \
+  template <typename A, typename T,                                            \
+      typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>  \
+  Lazy<expr::Binary<expr::Op, A, expr::Constant<T>>> name(                     \
+      Lazy<A> const& a, T b) {                                                 \
+    return make_binary<expr::Op>(a, lazy_constant(b));                         \
+  }                                                                            \
+  template <typename T, typename B,                                            \
+      typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>  \
+  Lazy<expr::Binary<expr::Op, expr::Constant<T>, B>> name(                     \
+      T a, Lazy<B> const& b) {                                                 \
+    return make_binary<expr::Op>(lazy_constant(a), b);                         \
+  }
+OMEGA_H_LAZY_BINARY(operator+, Add)
+OMEGA_H_LAZY_BINARY(operator-, Subtract)
+OMEGA_H_LAZY_BINARY(operator*, Multiply)
+OMEGA_H_LAZY_BINARY(operator/, Divide)
+OMEGA_H_LAZY_BINARY(divide_each_maybe_zero, DivideMaybeZero)
+OMEGA_H_LAZY_BINARY(min_each, Min)
+OMEGA_H_LAZY_BINARY(max_each, Max)
+OMEGA_H_LAZY_BINARY(each_max_with, Max)
+OMEGA_H_LAZY_BINARY(each_lt, Less)
+OMEGA_H_LAZY_BINARY(each_leq_to, LessEqual)
+OMEGA_H_LAZY_BINARY(each_gt, Greater)
+OMEGA_H_LAZY_BINARY(each_geq_to, GreaterEqual)
+#undef OMEGA_H_LAZY_BINARY
+
+template <typename A>
+Lazy<expr::Unary<expr::Negate, A>> operator-(Lazy<A> const& a) {
+  return {{a.node}};
+}
+
+template <typename A>
+Lazy<expr::Unary<expr::Fabs, A>> fabs_each(Lazy<A> const& a) {
+  return {{a.node}};
+}
+
+template <typename A>
+Lazy<expr::Component<A>> get_component(Lazy<A> const& a, Int ncomps, Int comp) {
+  OMEGA_H_CHECK(0 <= comp && comp < ncomps);
+  divide_no_remainder(a.size(), LO(ncomps));
+  return {{a.node, ncomps, comp}};
+}
+
+template <typename C, typename A, typename B>
+Lazy<expr::Ternary<expr::Select, C, A, B>> ternary_each(
+    Lazy<C> const& cond, Lazy<A> const& a, Lazy<B> const& b) {
+  expr::combine_sizes(cond.size(), expr::combine_sizes(a.size(), b.size()));
+  return {{cond.node, a.node, b.node}};
+}
+
+/* runs the whole expression in one parallel_for */
+template <typename E>
+Read<typename E::value_type> evaluate(
+    Lazy<E> const& e, std::string const& name = "") {
+  using T = typename E::value_type;
+  auto const n = e.size();
+  OMEGA_H_CHECK(n >= 0);
+  Write<T> out(n, name);
+  auto const node = e.node;
+  auto f = OMEGA_H_LAMBDA(LO i) { out[i] = node(i); };
+  parallel_for(n, std::move(f), "lazy_evaluate");
+  return out;
+}
+
+template <typename E>
+promoted_t<typename E::value_type> get_sum(Lazy<E> const& e) {
+  using PT = promoted_t<typename E::value_type>;
+  auto const n = e.size();
+  OMEGA_H_CHECK(n >= 0);
+  auto const node = e.node;
+  auto transform = OMEGA_H_LAMBDA(LO i)->PT { return PT(node(i)); };
+#if defined(OMEGA_H_USE_KOKKOS)
+  PT r = PT(0);
+  Kokkos::parallel_reduce(
+      Kokkos::RangePolicy<>(0, n),
+      KOKKOS_LAMBDA(int i, PT& update) { update += transform(i); },
+      Kokkos::Sum<PT>(r));
+  return r;
+#else
+  return transform_reduce(IntIterator(0), IntIterator(n), PT(0), plus<PT>(),
+      std::move(transform));
+#endif
+}
+
+template <typename E>
+typename E::value_type get_min(Lazy<E> const& e) {
+  using T = typename E::value_type;
+  using PT = promoted_t<T>;
+  auto const n = e.size();
+  OMEGA_H_CHECK(n >= 0);
+  auto const node = e.node;
+  auto transform = OMEGA_H_LAMBDA(LO i)->PT { return PT(node(i)); };
+  auto const init = PT(ArithTraits<T>::max());
+#if defined(OMEGA_H_USE_KOKKOS)
+  PT r = init;
+  auto const op = minimum<PT>();
+  Kokkos::parallel_reduce(
+      Kokkos::RangePolicy<>(0, n),
+      KOKKOS_LAMBDA(int i, PT& update) { update = op(update, transform(i)); },
+      Kokkos::Min<PT>(r));
+#else
+  auto const r = transform_reduce(IntIterator(0), IntIterator(n), init,
+      minimum<PT>(), std::move(transform));
+#endif
+  return T(r);
+}
+
+template <typename E>
+typename E::value_type get_max(Lazy<E> const& e) {
+  using T = typename E::value_type;
+  using PT = promoted_t<T>;
+  auto const n = e.size();
+  OMEGA_H_CHECK(n >= 0);
+  auto const node = e.node;
+  auto transform = OMEGA_H_LAMBDA(LO i)->PT { return PT(node(i)); };
+  auto const init = PT(ArithTraits<T>::min());
+#if defined(OMEGA_H_USE_KOKKOS)
+  PT r = init;
+  auto const op = maximum<PT>();
+  Kokkos::parallel_reduce(
+      Kokkos::RangePolicy<>(0, n),
+      KOKKOS_LAMBDA(int i, PT& update) { update = op(update, transform(i)); },
+      Kokkos::Max<PT>(r));
+#else
+  auto const r = transform_reduce(IntIterator(0), IntIterator(n), init,
+      maximum<PT>(), std::move(transform));
+#endif
+  return T(r);
+}
+
+template <typename E>
+promoted_t<typename E::value_type> get_sum(CommPtr comm, Lazy<E> const& e) {
+  return comm->allreduce(get_sum(e), OMEGA_H_SUM);
+}
+
+template <typename E>
+typename E::value_type get_min(CommPtr comm, Lazy<E> const& e) {
+  return comm->allreduce(get_min(e), OMEGA_H_MIN);
+}
+
+template <typename E>
+typename E::value_type get_max(CommPtr comm, Lazy<E> const& e) {
+  return comm->allreduce(get_max(e), OMEGA_H_MAX);
+}
+
+}  // end namespace Omega_h
+
+#endif
@@ -768,10 +768,13 @@ Read<Tout> array_cast(Read<Tin> in) {
 INST(I8)
 INST(I32)
 INST(I64)
+INST(F32)
 INST(Real)
 #undef INST
 
 template Read<Real> array_cast(Read<I32>);
 template Read<I32> array_cast(Read<I8>);
+template Read<Real> array_cast(Read<F32>);
+template Read<F32> array_cast(Read<Real>);
 
 }  // end namespace Omega_h
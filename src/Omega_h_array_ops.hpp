@@ -170,11 +170,14 @@ Read<Tout> array_cast(Read<Tin> in);
 OMEGA_H_EXPL_INST_DECL(I8)
 OMEGA_H_EXPL_INST_DECL(I32)
 OMEGA_H_EXPL_INST_DECL(I64)
+OMEGA_H_EXPL_INST_DECL(F32)
 OMEGA_H_EXPL_INST_DECL(Real)
 #undef OMEGA_H_EXPL_INST_DECL
 
 extern template Read<Real> array_cast(Read<I32>);
 extern template Read<I32> array_cast(Read<I8>);
+extern template Read<Real> array_cast(Read<F32>);
+extern template Read<F32> array_cast(Read<Real>);
 
 }  // end namespace Omega_h
 
@@ -27,6 +27,8 @@ OMEGA_H_DEVICE int atomic_fetch_add(int* const dest, const int val) {
 #pragma GCC diagnostic pop
 #endif
   return oldval;
+#elif defined(OMEGA_H_USE_THREADS)
+  return __atomic_fetch_add(dest, val, __ATOMIC_SEQ_CST);
 #else
   int oldval = *dest;
   *dest += val;
@@ -37,7 +39,7 @@ OMEGA_H_DEVICE int atomic_fetch_add(int* const dest, const int val) {
 OMEGA_H_DEVICE void atomic_increment(int* const dest) {
 #if defined(OMEGA_H_USE_KOKKOS)
   Kokkos::atomic_inc(dest);
-#elif defined(OMEGA_H_USE_OPENMP)
+#elif defined(OMEGA_H_USE_OPENMP) || defined(OMEGA_H_USE_THREADS)
   atomic_fetch_add(dest, 1);
 #else
   ++(*dest);
@@ -47,13 +49,46 @@ OMEGA_H_DEVICE void atomic_increment(int* const dest) {
 OMEGA_H_DEVICE void atomic_add(int* const dest, const int val) {
 #if defined(OMEGA_H_USE_KOKKOS)
   Kokkos::atomic_add(dest, val);
-#elif defined(OMEGA_H_USE_OPENMP)
+#elif defined(OMEGA_H_USE_OPENMP) || defined(OMEGA_H_USE_THREADS)
   atomic_fetch_add(dest, val);
 #else
   *dest += val;
 #endif
 }
 
+/* if *dest == expected, sets it to desired.
+   returns the value *dest had before. */
+OMEGA_H_DEVICE int atomic_compare_exchange(
+    int* const dest, const int expected, const int desired) {
+#if defined(OMEGA_H_USE_KOKKOS)
+  return Kokkos::atomic_compare_exchange(dest, expected, desired);
+#elif defined(OMEGA_H_USE_OPENMP) || defined(OMEGA_H_USE_THREADS)
+  int oldval = expected;
+  __atomic_compare_exchange_n(
+      dest, &oldval, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+  return oldval;
+#else
+  int oldval = *dest;
+  if (oldval == expected) *dest = desired;
+  return oldval;
+#endif
+}
+
+OMEGA_H_DEVICE void atomic_min(int* const dest, const int val) {
+#if defined(OMEGA_H_USE_KOKKOS)
+  Kokkos::atomic_min(dest, val);
+#elif defined(OMEGA_H_USE_OPENMP) || defined(OMEGA_H_USE_THREADS)
+  int oldval = atomic_fetch_add(dest, 0);
+  while (val < oldval) {
+    auto const seen = atomic_compare_exchange(dest, oldval, val);
+    if (seen == oldval) break;
+    oldval = seen;
+  }
+#else
+  if (val < *dest) *dest = val;
+#endif
+}
+
 }  // end namespace Omega_h
 
 #endif
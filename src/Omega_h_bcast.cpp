@@ -53,6 +53,9 @@ void bcast_mesh(Mesh* mesh, CommPtr new_comm, bool is_source) {
           case OMEGA_H_I64:
             mesh->add_tag(d, name, ncomps, Read<I64>({}));
             break;
+          case OMEGA_H_F32:
+            mesh->add_tag(d, name, ncomps, Read<F32>({}));
+            break;
           case OMEGA_H_F64:
             mesh->add_tag(d, name, ncomps, Read<Real>({}));
             break;
@@ -13,6 +13,7 @@
 #include "Omega_h_migrate.hpp"
 #include "Omega_h_owners.hpp"
 #include "Omega_h_simplify.hpp"
+#include "Omega_h_structured.hpp"
 
 namespace Omega_h {
 
@@ -39,8 +40,13 @@ void add_ents2verts(
   } else {
     auto ldim = ent_dim - 1;
     auto lv2v = mesh->ask_verts_of(ldim);
-    auto v2l = mesh->ask_up(VERT, ldim);
-    auto down = reflect_down(ev2v, lv2v, v2l, mesh->family(), ent_dim, ldim);
+    Adj down;
+    if (is_hashed_dedup_enabled()) {
+      down = reflect_down_hashed(ev2v, lv2v, mesh->family(), ent_dim, ldim);
+    } else {
+      auto v2l = mesh->ask_up(VERT, ldim);
+      down = reflect_down(ev2v, lv2v, v2l, mesh->family(), ent_dim, ldim);
+    }
     mesh->set_ents(ent_dim, down);
   }
   if (comm->size() > 1) {
@@ -148,6 +154,29 @@ Mesh build_box(CommPtr comm, Omega_h_Family family, Real x, Real y, Real z,
   return mesh;
 }
 
+Mesh build_structured_box(CommPtr comm, Real x, Real y, Real z, LO nx,
+    LO ny, LO nz) {
+  auto lib = comm->library();
+  auto mesh = Mesh(lib);
+  if (comm->rank() == 0) {
+    auto const box = make_structured_box(nx, ny, nz);
+    mesh.set_comm(lib->self());
+    mesh.set_parting(OMEGA_H_ELEM_BASED);
+    mesh.set_family(OMEGA_H_HYPERCUBE);
+    mesh.set_dim(box.dim);
+    mesh.set_structured(box);
+    for (Int d = 0; d <= box.dim; ++d) {
+      mesh.add_tag(d, "global", 1, GOs(mesh.nents(d), 0, 1));
+    }
+    mesh.add_coords(structured_coords(box, x, y, z));
+    classify_box(&mesh, x, y, z, nx, ny, nz);
+    mesh.class_sets = get_box_class_sets(mesh.dim());
+  }
+  mesh.set_comm(comm);
+  mesh.balance();
+  return mesh;
+}
+
 /* When we try to build a mesh from _partitioned_
    element-to-vertex connectivity only, we have to derive
    consistent edges and faces in parallel.
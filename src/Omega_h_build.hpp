@@ -25,6 +25,13 @@ Mesh build_box(CommPtr comm, Omega_h_Family family, Real x, Real y, Real z,
     LO nx, LO ny, LO nz, bool symmetric = false);
 void build_box_internal(Mesh* mesh, Omega_h_Family family, Real x, Real y,
     Real z, LO nx, LO ny, LO nz, bool symmetric = false);
+/* a box of hypercubes like build_box(), but with structured connectivity
+   (see Mesh::set_structured): no adjacency arrays are stored and
+   entities keep the lexicographic (i,j,k) numbering instead of being
+   reordered along a Hilbert curve. with more than one rank the mesh is
+   balanced like build_box() does, which makes it unstructured */
+Mesh build_structured_box(CommPtr comm, Real x, Real y, Real z, LO nx,
+    LO ny, LO nz);
 
 void add_ents2verts(
     Mesh* mesh, Int edim, LOs ev2v, GOs vert_globals, GOs elem_globals = GOs());
@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include <cstdlib>
+#include "Omega_h_arena.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_collapse.hpp"
 #include "Omega_h_for.hpp"
@@ -77,7 +78,8 @@ static bool coarsen_ghosted(Mesh* mesh, AdaptOpts const& opts,
   }
   #endif
   /* cavity quality checks */
-  auto cand_edge_quals = coarsen_qualities(mesh, cands2edges, cand_edge_codes);
+  auto cand_edge_quals =
+      ask_coarsen_qualities(mesh, cands2edges, cand_edge_codes);
   cand_edge_codes = filter_coarsen_min_qual(
       cand_edge_codes, cand_edge_quals, opts.min_quality_allowed);
   if (improve == IMPROVE_LOCALLY) {
@@ -92,7 +94,8 @@ static bool coarsen_ghosted(Mesh* mesh, AdaptOpts const& opts,
   auto vert_rails = Read<GO>();
   choose_rails(mesh, cands2edges, cand_edge_codes, cand_edge_quals,
       &verts_are_cands, &vert_quals, &vert_rails);
-  auto verts_are_keys = find_indset(mesh, VERT, vert_quals, verts_are_cands);
+  auto verts_are_keys =
+      find_indset(mesh, VERT, vert_quals, verts_are_cands, opts);
   Graph verts2cav_elems;
   verts2cav_elems = mesh->ask_up(VERT, mesh->dim());
   mesh->add_tag(VERT, "key", 1, verts_are_keys);
@@ -104,6 +107,7 @@ static bool coarsen_ghosted(Mesh* mesh, AdaptOpts const& opts,
 }
 
 static void coarsen_element_based2(Mesh* mesh, AdaptOpts const& opts) {
+  ScopedArena arena;
   auto comm = mesh->comm();
   auto verts_are_keys = mesh->get_array<I8>(VERT, "key");
   auto vert_quals = mesh->get_array<Real>(VERT, "collapse_quality");
@@ -144,7 +148,8 @@ static void coarsen_element_based2(Mesh* mesh, AdaptOpts const& opts) {
     auto old_ents2new_ents = LOs();
     modify_ents_adapt(mesh, &new_mesh, ent_dim, VERT, keys2verts, keys2prods,
         prod_verts2verts, old_lows2new_lows, &prods2new_ents,
-        &same_ents2old_ents, &same_ents2new_ents, &old_ents2new_ents);
+        &same_ents2old_ents, &same_ents2new_ents, &old_ents2new_ents,
+        old_verts2new_verts);
     if (ent_dim == VERT) {
       old_verts2new_verts = old_ents2new_ents;
     }
@@ -16,6 +16,10 @@ Adj find_coarsen_domains(
     Mesh* mesh, LOs keys2verts, Int ent_dim, Read<I8> ents_are_dead);
 
 Reals coarsen_qualities(Mesh* mesh, LOs cands2edges, Read<I8> cand_codes);
+/* coarsen_qualities(), reusing and updating the "collapse_qualities"
+   cache when the mesh has one */
+Reals ask_coarsen_qualities(
+    Mesh* mesh, LOs cands2edges, Read<I8> cand_codes);
 
 Read<I8> filter_coarsen_min_qual(
     Read<I8> cand_codes, Reals cand_quals, Real min_qual);
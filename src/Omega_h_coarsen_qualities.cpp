@@ -6,7 +6,9 @@
 #include "Omega_h_file.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_profile.hpp"
 #include "Omega_h_quality.hpp"
+#include "Omega_h_quality_cache.hpp"
 
 #include <iostream>
 
@@ -87,6 +89,66 @@ Reals coarsen_qualities(Mesh* mesh, LOs cands2edges, Read<I8> cand_codes) {
   OMEGA_H_NORETURN(Reals());
 }
 
+Reals ask_coarsen_qualities(
+    Mesh* mesh, LOs cands2edges, Read<I8> cand_codes) {
+  if (!mesh->has_tag(EDGE, COLLAPSE_QUALITIES)) {
+    return coarsen_qualities(mesh, cands2edges, cand_codes);
+  }
+  auto edge_quals = mesh->get_array<Real>(EDGE, COLLAPSE_QUALITIES);
+  auto cached_quals = read(unmap(cands2edges, edge_quals, 2));
+  auto ncands = cands2edges.size();
+  Write<I8> are_misses(ncands);
+  auto find_misses = OMEGA_H_LAMBDA(LO cand) {
+    auto code = cand_codes[cand];
+    I8 is_miss = 0;
+    for (Int eev_col = 0; eev_col < 2; ++eev_col) {
+      if (collapses(code, eev_col) &&
+          cached_quals[cand * 2 + eev_col] == UNKNOWN_QUALITY) {
+        is_miss = 1;
+      }
+    }
+    are_misses[cand] = is_miss;
+  };
+  parallel_for(ncands, std::move(find_misses), "ask_coarsen_qualities(misses)");
+  /* the misses are rank-local, but coarsen_qualities() fills copies from
+     their owners, so a miss on a copy has to be a miss on its owner too.
+     it is: entries are only written from those synced values and are
+     forgotten by marks that are synced as well, so every rank holds the
+     same entries for an edge */
+  auto misses2cands = collect_marked(read(are_misses));
+  count_event(
+      "collapse quality cache miss", std::size_t(misses2cands.size()));
+  count_event(
+      "collapse quality cache hit", std::size_t(ncands - misses2cands.size()));
+  auto misses2edges = unmap(misses2cands, cands2edges, 1);
+  auto miss_codes = unmap(misses2cands, cand_codes, 1);
+  auto miss_quals = coarsen_qualities(mesh, misses2edges, miss_codes);
+  Write<Real> new_edge_quals = deep_copy(edge_quals);
+  auto remember = OMEGA_H_LAMBDA(LO miss) {
+    auto e = misses2edges[miss];
+    for (Int eev_col = 0; eev_col < 2; ++eev_col) {
+      if (collapses(miss_codes[miss], eev_col)) {
+        new_edge_quals[e * 2 + eev_col] = miss_quals[miss * 2 + eev_col];
+      }
+    }
+  };
+  parallel_for(
+      misses2cands.size(), std::move(remember), "ask_coarsen_qualities");
+  mesh->set_tag(EDGE, COLLAPSE_QUALITIES, Reals(new_edge_quals), true);
+  /* the same values coarsen_qualities() would give */
+  Write<Real> quals(ncands * 2);
+  auto gather = OMEGA_H_LAMBDA(LO cand) {
+    auto e = cands2edges[cand];
+    for (Int eev_col = 0; eev_col < 2; ++eev_col) {
+      quals[cand * 2 + eev_col] = collapses(cand_codes[cand], eev_col)
+                                      ? new_edge_quals[e * 2 + eev_col]
+                                      : -1.0;
+    }
+  };
+  parallel_for(ncands, std::move(gather), "ask_coarsen_qualities(gather)");
+  return quals;
+}
+
 Read<I8> filter_coarsen_dirs(Read<I8> codes, Read<I8> keep_dirs) {
   auto codes_w = Write<I8>(codes.size());
   auto f = OMEGA_H_LAMBDA(LO cand) {
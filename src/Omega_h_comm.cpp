@@ -116,6 +116,30 @@ CommPtr Comm::split(I32 color, I32 key) const {
 #endif
 }
 
+CommPtr Comm::split_shared() const {
+#ifdef OMEGA_H_USE_MPI
+  MPI_Comm impl2;
+  CALL(MPI_Comm_split_type(
+      impl_, MPI_COMM_TYPE_SHARED, rank(), MPI_INFO_NULL, &impl2));
+  return CommPtr(new Comm(library_, impl2));
+#else
+  return CommPtr(new Comm(library_, false, false));
+#endif
+}
+
+I32 Comm::node_leader(I32 ranks_per_node) const {
+  if (node_leader_ < 0 || node_leader_ranks_per_node_ != ranks_per_node) {
+    auto const r = rank();
+    auto const node = (ranks_per_node > 0) ? split(r / ranks_per_node, r)
+                                           : split_shared();
+    I32 leader = r;
+    node->bcast(leader);
+    node_leader_ = leader;
+    node_leader_ranks_per_node_ = ranks_per_node;
+  }
+  return node_leader_;
+}
+
 #ifdef OMEGA_H_USE_MPI
 static std::vector<int> sources_from_destinations(
     MPI_Comm comm, HostRead<I32> destinations) {
@@ -566,6 +590,61 @@ Read<T> Comm::alltoallv(Read<T> sendbuf_dev, Read<LO> sdispls_dev,
   return recvbuf_dev;
 }
 
+template <typename T>
+PersistentRequestsPtr Comm::alltoallv_init(Write<T> sendbuf,
+    Read<LO> sdispls_dev, Write<T> recvbuf, Read<LO> rdispls_dev,
+    Int width) const {
+  auto requests = std::make_shared<PersistentRequests>();
+#ifdef OMEGA_H_USE_MPI
+#if OMEGA_H_MPI_NEEDS_HOST_COPY
+  Omega_h_fail("Comm::alltoallv_init needs MPI to accept device buffers\n");
+#endif
+  HostRead<LO> sdispls(sdispls_dev);
+  HostRead<LO> rdispls(rdispls_dev);
+  OMEGA_H_CHECK(sendbuf.size() == sdispls.last() * width);
+  OMEGA_H_CHECK(recvbuf.size() == rdispls.last() * width);
+  int const tag = 42;
+  int const outdegree = host_dsts_.size();
+  int const indegree = host_srcs_.size();
+  requests->impl_.resize(static_cast<std::size_t>(outdegree + indegree));
+  for (int i = 0; i < outdegree; ++i) {
+    CALL(MPI_Send_init(nonnull(sendbuf.data()) + sdispls[i] * width,
+        (sdispls[i + 1] - sdispls[i]) * width, MpiTraits<T>::datatype(),
+        host_dsts_[i], tag, impl_, requests->impl_.data() + i));
+  }
+  for (int i = 0; i < indegree; ++i) {
+    CALL(MPI_Recv_init(nonnull(recvbuf.data()) + rdispls[i] * width,
+        (rdispls[i + 1] - rdispls[i]) * width, MpiTraits<T>::datatype(),
+        host_srcs_[i], tag, impl_,
+        requests->impl_.data() + outdegree + i));
+  }
+#else
+  (void)sdispls_dev;
+  (void)rdispls_dev;
+  (void)width;
+  requests->copy_ = [sendbuf, recvbuf]() { copy_into(read(sendbuf), recvbuf); };
+#endif
+  return requests;
+}
+
+PersistentRequests::~PersistentRequests() {
+#ifdef OMEGA_H_USE_MPI
+  for (auto& request : impl_) CALL(MPI_Request_free(&request));
+#endif
+}
+
+void PersistentRequests::start_and_wait() {
+  ScopedTimer timer("PersistentRequests::start_and_wait");
+#ifdef OMEGA_H_USE_MPI
+  if (impl_.empty()) return;
+  auto const n = static_cast<int>(impl_.size());
+  CALL(MPI_Startall(n, impl_.data()));
+  CALL(MPI_Waitall(n, impl_.data(), MPI_STATUSES_IGNORE));
+#else
+  if (copy_) copy_();
+#endif
+}
+
 void Comm::barrier() const {
 #ifdef OMEGA_H_USE_MPI
   CALL(MPI_Barrier(impl_));
@@ -583,11 +662,14 @@ void Comm::barrier() const {
   template Read<T> Comm::alltoallv(                                            \
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;   \
   template Future<T> Comm::ialltoallv(                                       \
-      Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;
+      Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;  \
+  template PersistentRequestsPtr Comm::alltoallv_init(Write<T> sendbuf,        \
+      Read<LO> sdispls, Write<T> recvbuf, Read<LO> rdispls, Int width) const;
 
 INST(I8)
 INST(I32)
 INST(I64)
+INST(F32)
 INST(Real)
 #undef INST
 
@@ -23,8 +23,10 @@ static_assert(sizeof(int) == 4, "Omega_h::Comm assumes 32-bit int");
 
 class Library;
 class Comm;
+class PersistentRequests;
 
 typedef std::shared_ptr<Comm> CommPtr;
+typedef std::shared_ptr<PersistentRequests> PersistentRequestsPtr;
 
 class Comm {
 #ifdef OMEGA_H_USE_MPI
@@ -37,6 +39,9 @@ class Comm {
   HostRead<I32> host_dsts_;
   LO self_src_;
   LO self_dst_;
+  /* what node_leader() found, and for which ranks_per_node */
+  mutable I32 node_leader_ = -1;
+  mutable I32 node_leader_ranks_per_node_ = -1;
 
  public:
   Comm();
@@ -57,6 +62,14 @@ class Comm {
   I32 size() const;
   CommPtr dup() const;
   CommPtr split(I32 color, I32 key) const;
+  /* the ranks that share memory with this one, usually those of a node */
+  CommPtr split_shared() const;
+  /* the rank of the leader of this rank's node, the lowest rank among
+     those that share memory with it, or among the groups of
+     ranks_per_node consecutive ranks if that is positive.
+     the first call for each ranks_per_node is collective, later ones
+     return what it found */
+  I32 node_leader(I32 ranks_per_node = 0) const;
   CommPtr graph(Read<I32> dsts) const;
   CommPtr graph_adjacent(Read<I32> srcs, Read<I32> dsts) const;
   CommPtr graph_inverse() const;
@@ -82,6 +95,12 @@ class Comm {
   template <typename T>
   Future<T> ialltoallv(
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;
+  /* sets up the messages of alltoallv() once, between buffers that stay
+     fixed. every PersistentRequests::start_and_wait() then exchanges
+     what sendbuf holds at that time into recvbuf */
+  template <typename T>
+  PersistentRequestsPtr alltoallv_init(Write<T> sendbuf, Read<LO> sdispls,
+      Write<T> recvbuf, Read<LO> rdispls, Int width) const;
   void barrier() const;
   template<typename T>
   void send(int rank, const T& x);
@@ -89,6 +108,24 @@ class Comm {
   void recv(int rank, T& x);
 };
 
+/* the point-to-point requests made by Comm::alltoallv_init().
+   the buffers they were made with must outlive them */
+class PersistentRequests {
+#ifdef OMEGA_H_USE_MPI
+  std::vector<MPI_Request> impl_;
+#else
+  std::function<void()> copy_;
+#endif
+  friend class Comm;
+
+ public:
+  PersistentRequests() = default;
+  PersistentRequests(PersistentRequests const&) = delete;
+  PersistentRequests& operator=(PersistentRequests const&) = delete;
+  ~PersistentRequests();
+  void start_and_wait();
+};
+
 #ifdef OMEGA_H_USE_MPI
 
 #ifdef OMPI_MPI_H
@@ -223,10 +260,14 @@ void Comm::recv(int rank, T& x) {
   extern template Read<T> Comm::alltoallv(                                     \
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;   \
   extern template Future<T> Comm::ialltoallv(                                  \
-      Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;
+      Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;   \
+  extern template PersistentRequestsPtr Comm::alltoallv_init(                  \
+      Write<T> sendbuf, Read<LO> sdispls, Write<T> recvbuf, Read<LO> rdispls,  \
+      Int width) const;
 OMEGA_H_EXPL_INST_DECL(I8)
 OMEGA_H_EXPL_INST_DECL(I32)
 OMEGA_H_EXPL_INST_DECL(I64)
+OMEGA_H_EXPL_INST_DECL(F32)
 OMEGA_H_EXPL_INST_DECL(Real)
 #undef OMEGA_H_EXPL_INST_DECL
 
@@ -149,6 +149,17 @@ struct CompareArrays<Real> {
   }
 };
 
+/* single precision fields are held to the same tolerances */
+template <>
+struct CompareArrays<F32> {
+  static bool compare(CommPtr comm, Read<F32> a, Read<F32> b,
+      VarCompareOpts opts, Int ncomps, Int dim, bool verbose) {
+    if (opts.type == VarCompareOpts::NONE) return true;
+    return CompareArrays<Real>::compare(comm, array_cast<Real>(a),
+        array_cast<Real>(b), opts, ncomps, dim, verbose);
+  }
+};
+
 template <typename T>
 bool compare_arrays(CommPtr comm, Read<T> a, Read<T> b, VarCompareOpts opts,
     Int ncomps, Int dim, bool verbose) {
@@ -247,6 +258,10 @@ Omega_h_Comparison compare_meshes(
           ok = compare_copy_data(dim, a->get_array<I64>(dim, name), a_dist,
               b->get_array<I64>(dim, name), b_dist, ncomps, tag_opts, verbose);
           break;
+        case OMEGA_H_F32:
+          ok = compare_copy_data(dim, a->get_array<F32>(dim, name), a_dist,
+              b->get_array<F32>(dim, name), b_dist, ncomps, tag_opts, verbose);
+          break;
         case OMEGA_H_F64:
           ok = compare_copy_data(dim, a->get_array<Real>(dim, name), a_dist,
               b->get_array<Real>(dim, name), b_dist, ncomps, tag_opts, verbose);
@@ -446,6 +461,7 @@ void accept_diff_program_cmdline(CmdLine const& cmdline, Mesh const* mesh,
 EXPL_INST(I8)
 EXPL_INST(I32)
 EXPL_INST(I64)
+EXPL_INST(F32)
 EXPL_INST(Real)
 #undef EXPL_INST
 
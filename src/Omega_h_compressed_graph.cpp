@@ -0,0 +1,146 @@
+#include "Omega_h_compressed_graph.hpp"
+
+#include "Omega_h_for.hpp"
+#include "Omega_h_functors.hpp"
+#include "Omega_h_int_scan.hpp"
+#include "Omega_h_profile.hpp"
+
+namespace Omega_h {
+
+LO CompressedGraph::nnodes() const { return a2ab.size() - 1; }
+
+LO CompressedGraph::nedges() const { return a2ab.last(); }
+
+std::size_t CompressedGraph::nbytes() const {
+  return std::size_t(a2ab.size() + a2byte.size()) * sizeof(LO) +
+         std::size_t(bytes.size());
+}
+
+CompressedGraph compress_graph(Graph g) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const a2ab = g.a2ab;
+  auto const ab2b = g.ab2b;
+  auto const na = g.nnodes();
+  Write<LO> row_sizes(na);
+  auto count = OMEGA_H_LAMBDA(LO a) {
+    LO prev = a;
+    LO size = 0;
+    for (auto ab = a2ab[a]; ab < a2ab[a + 1]; ++ab) {
+      auto const b = ab2b[ab];
+      auto const delta = LO(std::uint32_t(b) - std::uint32_t(prev));
+      size += varint_size(zigzag_encode(delta));
+      prev = b;
+    }
+    row_sizes[a] = size;
+  };
+  parallel_for(na, std::move(count), "compress_graph(count)");
+  auto const a2byte = offset_scan(LOs(row_sizes));
+  Write<Byte> bytes(a2byte.last());
+  auto fill = OMEGA_H_LAMBDA(LO a) {
+    LO prev = a;
+    auto byte = a2byte[a];
+    for (auto ab = a2ab[a]; ab < a2ab[a + 1]; ++ab) {
+      auto const b = ab2b[ab];
+      auto const delta = LO(std::uint32_t(b) - std::uint32_t(prev));
+      auto zigzag = zigzag_encode(delta);
+      while (zigzag >= 0x80) {
+        bytes[byte++] = Byte(std::uint8_t((zigzag & 0x7F) | 0x80));
+        zigzag >>= 7;
+      }
+      bytes[byte++] = Byte(std::uint8_t(zigzag));
+      prev = b;
+    }
+  };
+  parallel_for(na, std::move(fill), "compress_graph(fill)");
+  CompressedGraph out;
+  out.a2ab = a2ab;
+  out.a2byte = a2byte;
+  out.bytes = bytes;
+  return out;
+}
+
+Graph decompress_graph(CompressedGraph g) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const na = g.nnodes();
+  Write<LO> ab2b(g.nedges());
+  auto f = OMEGA_H_LAMBDA(LO a) {
+    CompressedRow row(g, a);
+    for (auto ab = g.a2ab[a]; ab < g.a2ab[a + 1]; ++ab) ab2b[ab] = row.next();
+  };
+  parallel_for(na, std::move(f), "decompress_graph");
+  return Graph(g.a2ab, ab2b);
+}
+
+template <typename Functor>
+static Read<typename Functor::input_type> graph_reduce_tmpl(
+    CompressedGraph a2b, Read<typename Functor::input_type> b_data,
+    Int width) {
+  using T = typename Functor::input_type;
+  using VT = typename Functor::value_type;
+  auto const na = a2b.nnodes();
+  Write<T> a_data(na * width);
+  auto f = OMEGA_H_LAMBDA(LO a) {
+    auto functor = Functor();
+    for (Int j = 0; j < width; ++j) {
+      VT res;
+      functor.init(res);
+      CompressedRow row(a2b, a);
+      for (auto ab = a2b.a2ab[a]; ab < a2b.a2ab[a + 1]; ++ab) {
+        VT update = b_data[row.next() * width + j];
+        functor.join(res, update);
+      }
+      a_data[a * width + j] = static_cast<T>(res);
+    }
+  };
+  parallel_for(na, std::move(f), "graph_reduce(compressed)");
+  return a_data;
+}
+
+template <typename T>
+Read<T> graph_reduce(
+    CompressedGraph a2b, Read<T> b_data, Int width, Omega_h_Op op) {
+  switch (op) {
+    case OMEGA_H_MIN:
+      return graph_reduce_tmpl<MinFunctor<T>>(a2b, b_data, width);
+    case OMEGA_H_MAX:
+      return graph_reduce_tmpl<MaxFunctor<T>>(a2b, b_data, width);
+    case OMEGA_H_SUM:
+      return graph_reduce_tmpl<SumFunctor<T>>(a2b, b_data, width);
+  }
+  OMEGA_H_NORETURN(Read<T>());
+}
+
+Reals graph_weighted_average(
+    CompressedGraph a2b, Reals ab_weights, Reals b_data, Int width) {
+  auto const na = a2b.nnodes();
+  OMEGA_H_CHECK(ab_weights.size() == a2b.nedges());
+  OMEGA_H_CHECK(b_data.size() % width == 0);
+  Write<Real> a_data(na * width);
+  auto f = OMEGA_H_LAMBDA(LO a) {
+    Real total_weight = 0.0;
+    for (auto ab = a2b.a2ab[a]; ab < a2b.a2ab[a + 1]; ++ab) {
+      total_weight += ab_weights[ab];
+    }
+    for (Int j = 0; j < width; ++j) {
+      Real sum = 0.0;
+      CompressedRow row(a2b, a);
+      for (auto ab = a2b.a2ab[a]; ab < a2b.a2ab[a + 1]; ++ab) {
+        sum += ab_weights[ab] * b_data[row.next() * width + j];
+      }
+      a_data[a * width + j] = sum / total_weight;
+    }
+  };
+  parallel_for(na, std::move(f), "graph_weighted_average(compressed)");
+  return a_data;
+}
+
+#define INST(T)                                                                \
+  template Read<T> graph_reduce(CompressedGraph, Read<T>, Int, Omega_h_Op);
+INST(I8)
+INST(I32)
+INST(I64)
+INST(F32)
+INST(Real)
+#undef INST
+
+}  // end namespace Omega_h
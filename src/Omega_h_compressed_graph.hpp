@@ -0,0 +1,102 @@
+#ifndef OMEGA_H_COMPRESSED_GRAPH_HPP
+#define OMEGA_H_COMPRESSED_GRAPH_HPP
+
+#include <cstdint>
+
+#include <Omega_h_graph.hpp>
+
+namespace Omega_h {
+
+/**
+ * \brief a Graph whose edge targets are stored as variable-length bytes
+ *
+ * \details the targets of each node keep their order and are stored as
+ * differences: the first one from the node itself, every other one from
+ * the target before it. differences are zigzag encoded (0,-1,1,-2,...
+ * become 0,1,2,3,...) and written seven bits per byte, the high bit of a
+ * byte telling whether another one follows. on meshes ordered for
+ * locality (Hilbert, see reorder_by_hilbert) most neighbors of an entity
+ * are numbered close to it and take one or two bytes instead of four.
+ *
+ * a2ab is the offset array of the uncompressed graph, so arc data
+ * indexed by ab still works. typical access pattern, in a kernel:
+ * CompressedRow row(g, a);
+ * for (auto ab = g.a2ab[a]; ab < g.a2ab[a + 1]; ++ab) {
+ *   auto b = row.next();
+ *   // do something with the (a,b) pair
+ * }
+ */
+struct CompressedGraph {
+  OMEGA_H_INLINE CompressedGraph() {}
+  LOs a2ab;
+  /* offset of the first byte of each node's targets */
+  LOs a2byte;
+  Bytes bytes;
+  LO nnodes() const;
+  LO nedges() const;
+  std::size_t nbytes() const;
+};
+
+/* decodes the targets of one node in order. it holds plain pointers,
+   so it is cheap to create inside kernels and must not outlive the
+   CompressedGraph it was made from */
+class CompressedRow {
+ public:
+  OMEGA_H_DEVICE CompressedRow(CompressedGraph const& g, LO a)
+      : bytes_(g.bytes.data() + g.a2byte[a]), prev_(a) {}
+  OMEGA_H_INLINE LO next() {
+    std::uint32_t zigzag = 0;
+    Int shift = 0;
+    while (true) {
+      auto const byte = std::uint32_t(std::uint8_t(*bytes_++));
+      zigzag |= (byte & 0x7F) << shift;
+      if (!(byte & 0x80)) break;
+      shift += 7;
+    }
+    auto const delta = I32(zigzag >> 1) ^ -I32(zigzag & 1);
+    prev_ = LO(std::uint32_t(prev_) + std::uint32_t(delta));
+    return prev_;
+  }
+
+ private:
+  Byte const* bytes_;
+  LO prev_;
+};
+
+OMEGA_H_INLINE std::uint32_t zigzag_encode(LO delta) {
+  return (std::uint32_t(delta) << 1) ^ std::uint32_t(delta >> 31);
+}
+
+/* bytes that zigzag_encode(delta) takes in a CompressedGraph */
+OMEGA_H_INLINE Int varint_size(std::uint32_t zigzag) {
+  Int n = 1;
+  while (zigzag >= 0x80) {
+    zigzag >>= 7;
+    ++n;
+  }
+  return n;
+}
+
+CompressedGraph compress_graph(Graph g);
+Graph decompress_graph(CompressedGraph g);
+
+/* the same as the Graph versions in Omega_h_graph.hpp */
+template <typename T>
+Read<T> graph_reduce(
+    CompressedGraph a2b, Read<T> b_data, Int width, Omega_h_Op op);
+Reals graph_weighted_average(
+    CompressedGraph a2b, Reals ab_weights, Reals b_data, Int width);
+
+#define INST_DECL(T)                                                           \
+  extern template Read<T> graph_reduce(                                        \
+      CompressedGraph, Read<T>, Int, Omega_h_Op);
+INST_DECL(I8)
+INST_DECL(I32)
+INST_DECL(I64)
+INST_DECL(F32)
+INST_DECL(Real)
+#undef INST_DECL
+
+}  // end namespace Omega_h
+
+#endif
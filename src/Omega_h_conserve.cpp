@@ -2,8 +2,10 @@
 
 #include <array>
 #include <iostream>
+#include <map>
 
 #include "Omega_h_adj.hpp"
+#include "Omega_h_array_expr.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_compare.hpp"
 #include "Omega_h_file.hpp"
@@ -13,6 +15,7 @@
 #include "Omega_h_host_few.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
+#include "Omega_h_profile.hpp"
 #include "Omega_h_r3d.hpp"
 #include "Omega_h_transfer.hpp"
 
@@ -391,14 +394,14 @@ void transfer_conserve_refine(Mesh* old_mesh, TransferOpts const& opts,
 /* intersection-based transfer of density fields.
    note that this is only used in single-material cavities,
    and so it should exactly conserve mass in those cases. */
+/* one intersection per pair of new and old elements of a cavity,
+   applied to all the tags of the batch */
 template <Int dim>
-void transfer_by_intersection_dim(Mesh* old_mesh, Mesh* new_mesh,
-    TagBase const* tagbase, Cavs cavs, Write<Real> new_data_w) {
+void transfer_by_intersection_dim(
+    Mesh* old_mesh, Mesh* new_mesh, TransferBatch<Real> batch, Cavs cavs) {
   auto keys2old_elems = cavs.keys2old_elems;
   auto keys2new_elems = cavs.keys2new_elems;
-  auto ncomps = tagbase->ncomps();
-  auto old_tag = as<Real>(tagbase);
-  auto old_data = old_tag->array();
+  auto ncomps = batch.ncomps;
   auto old_ev2v = old_mesh->ask_elem_verts();
   auto old_coords = old_mesh->coords();
   auto new_ev2v = new_mesh->ask_elem_verts();
@@ -408,8 +411,10 @@ void transfer_by_intersection_dim(Mesh* old_mesh, Mesh* new_mesh,
     for (auto kne = keys2new_elems.a2ab[key];
          kne < keys2new_elems.a2ab[key + 1]; ++kne) {
       auto new_elem = keys2new_elems.ab2b[kne];
-      for (Int comp = 0; comp < ncomps; ++comp) {
-        new_data_w[new_elem * ncomps + comp] = 0;
+      for (Int t = 0; t < batch.ntags; ++t) {
+        for (Int comp = 0; comp < ncomps; ++comp) {
+          batch.prod_data[t][new_elem * ncomps + comp] = 0;
+        }
       }
       auto new_verts = gather_verts<dim + 1>(new_ev2v, new_elem);
       auto new_points = gather_vectors<dim + 1, dim>(new_coords, new_verts);
@@ -423,56 +428,82 @@ void transfer_by_intersection_dim(Mesh* old_mesh, Mesh* new_mesh,
         r3d::intersect_simplices(
             intersection, to_r3d(new_points), to_r3d(old_points));
         auto intersection_size = r3d::measure(intersection);
-        for (Int comp = 0; comp < ncomps; ++comp) {
-          new_data_w[new_elem * ncomps + comp] +=
-              intersection_size * old_data[old_elem * ncomps + comp];
+        for (Int t = 0; t < batch.ntags; ++t) {
+          for (Int comp = 0; comp < ncomps; ++comp) {
+            batch.prod_data[t][new_elem * ncomps + comp] +=
+                intersection_size * batch.old_data[t][old_elem * ncomps + comp];
+          }
         }
         total_intersected_size += intersection_size;
       }
-      for (Int comp = 0; comp < ncomps; ++comp) {
-        new_data_w[new_elem * ncomps + comp] /= total_intersected_size;
+      for (Int t = 0; t < batch.ntags; ++t) {
+        for (Int comp = 0; comp < ncomps; ++comp) {
+          batch.prod_data[t][new_elem * ncomps + comp] /=
+              total_intersected_size;
+        }
       }
     }  // end loop over new elements
   };
   parallel_for(nkeys, f, "transfer_by_intersection");
 }
 
-static void transfer_by_intersection(Mesh* old_mesh, Mesh* new_mesh,
-    TagBase const* tagbase, Cavs cavs, Write<Real> new_elem_densities_w) {
+static void transfer_by_intersection(
+    Mesh* old_mesh, Mesh* new_mesh, TransferBatch<Real> batch, Cavs cavs) {
   auto dim = old_mesh->dim();
   if (dim == 3) {
-    transfer_by_intersection_dim<3>(
-        old_mesh, new_mesh, tagbase, cavs, new_elem_densities_w);
+    transfer_by_intersection_dim<3>(old_mesh, new_mesh, batch, cavs);
   } else if (dim == 2) {
-    transfer_by_intersection_dim<2>(
-        old_mesh, new_mesh, tagbase, cavs, new_elem_densities_w);
+    transfer_by_intersection_dim<2>(old_mesh, new_mesh, batch, cavs);
   } else if (dim == 1) {
-    transfer_by_intersection_dim<1>(
-        old_mesh, new_mesh, tagbase, cavs, new_elem_densities_w);
+    transfer_by_intersection_dim<1>(old_mesh, new_mesh, batch, cavs);
   } else {
     Omega_h_fail("unsupported dim %d\n", dim);
   }
 }
 
-void transfer_densities_and_conserve_swap(Mesh* old_mesh,
-    TransferOpts const& opts, Mesh* new_mesh, LOs keys2edges, LOs keys2prods,
-    LOs prods2new_ents, LOs same_ents2old_ents, LOs same_ents2new_ents) {
-  if (!has_densities_or_conserved(old_mesh, opts)) return;
-  auto init_cavs = form_initial_cavs(
-      old_mesh, new_mesh, EDGE, keys2edges, keys2prods, prods2new_ents);
+/* densities and conserved quantities of the new elements of the cavities,
+   in batches of tags. the new mesh gets them in the order of the tags */
+static void transfer_densities_by_intersection(Mesh* old_mesh,
+    TransferOpts const& opts, Mesh* new_mesh, std::vector<Cavs> const& cavs,
+    LOs same_ents2old_ents, LOs same_ents2new_ents) {
   auto dim = old_mesh->dim();
+  std::vector<TagBase const*> tags;
   for (Int i = 0; i < old_mesh->ntags(dim); ++i) {
     auto tagbase = old_mesh->get_tag(dim, i);
     if (should_conserve(old_mesh, opts, dim, tagbase) ||
         is_density(old_mesh, opts, dim, tagbase)) {
-      auto ncomps = tagbase->ncomps();
-      auto new_elem_densities_w = Write<Real>(new_mesh->nelems() * ncomps);
-      transfer_by_intersection(
-          old_mesh, new_mesh, tagbase, init_cavs, new_elem_densities_w);
-      transfer_common2(old_mesh, new_mesh, dim, same_ents2old_ents,
-          same_ents2new_ents, tagbase, new_elem_densities_w);
+      tags.push_back(tagbase);
     }
   }
+  std::map<TagBase const*, Write<Real>> new_elem_densities;
+  for (auto const& tag_batch : batch_tags(old_mesh, tags)) {
+    ScopedTimer timer("transfer_by_intersection(batch)");
+    std::vector<Write<Real>> new_arrays;
+    for (auto tag : tag_batch) {
+      new_arrays.push_back(Write<Real>(new_mesh->nelems() * tag->ncomps()));
+      new_elem_densities[tag] = new_arrays.back();
+    }
+    std::vector<Reals> old_arrays;
+    auto const batch =
+        make_transfer_batch(old_mesh, dim, tag_batch, new_arrays, &old_arrays);
+    for (auto const& c : cavs) {
+      transfer_by_intersection(old_mesh, new_mesh, batch, c);
+    }
+  }
+  for (auto tag : tags) {
+    transfer_common2(old_mesh, new_mesh, dim, same_ents2old_ents,
+        same_ents2new_ents, tag, new_elem_densities[tag]);
+  }
+}
+
+void transfer_densities_and_conserve_swap(Mesh* old_mesh,
+    TransferOpts const& opts, Mesh* new_mesh, LOs keys2edges, LOs keys2prods,
+    LOs prods2new_ents, LOs same_ents2old_ents, LOs same_ents2new_ents) {
+  if (!has_densities_or_conserved(old_mesh, opts)) return;
+  auto init_cavs = form_initial_cavs(
+      old_mesh, new_mesh, EDGE, keys2edges, keys2prods, prods2new_ents);
+  transfer_densities_by_intersection(old_mesh, opts, new_mesh, {init_cavs},
+      same_ents2old_ents, same_ents2new_ents);
   if (!should_conserve_any(old_mesh, opts)) return;
   OpConservation op_conservation;
   op_conservation.density.this_time[NOT_BDRY] = true;
@@ -497,25 +528,13 @@ void transfer_densities_and_conserve_coarsen(Mesh* old_mesh,
   auto bdry_keys2doms = keys2doms;
   auto cavs = separate_cavities(
       old_mesh, new_mesh, init_cavs, VERT, keys2verts, &bdry_keys2doms);
-  auto dim = old_mesh->dim();
-  for (Int i = 0; i < old_mesh->ntags(dim); ++i) {
-    auto tagbase = old_mesh->get_tag(dim, i);
-    if (should_conserve(old_mesh, opts, dim, tagbase) ||
-        is_density(old_mesh, opts, dim, tagbase)) {
-      auto ncomps = tagbase->ncomps();
-      auto new_elem_densities_w = Write<Real>(new_mesh->nelems() * ncomps);
-      transfer_by_intersection(old_mesh, new_mesh, tagbase,
-          cavs[NOT_BDRY][NO_COLOR][0], new_elem_densities_w);
-      transfer_by_intersection(old_mesh, new_mesh, tagbase,
-          cavs[TOUCH_BDRY][NO_COLOR][0], new_elem_densities_w);
-      for (auto color_cavs : cavs[KEY_BDRY][CLASS_COLOR]) {
-        transfer_by_intersection(
-            old_mesh, new_mesh, tagbase, color_cavs, new_elem_densities_w);
-      }
-      transfer_common2(old_mesh, new_mesh, dim, same_ents2old_ents,
-          same_ents2new_ents, tagbase, new_elem_densities_w);
-    }
+  std::vector<Cavs> intersection_cavs = {
+      cavs[NOT_BDRY][NO_COLOR][0], cavs[TOUCH_BDRY][NO_COLOR][0]};
+  for (auto color_cavs : cavs[KEY_BDRY][CLASS_COLOR]) {
+    intersection_cavs.push_back(color_cavs);
   }
+  transfer_densities_by_intersection(old_mesh, opts, new_mesh,
+      intersection_cavs, same_ents2old_ents, same_ents2new_ents);
   if (!should_conserve_any(old_mesh, opts)) return;
   OpConservation op_conservation;
   op_conservation.density.this_time[NOT_BDRY] = true;
@@ -667,7 +686,7 @@ struct AllBounded : public AndFunctor {
 };
 
 static bool all_bounded(CommPtr comm, Reals a, Real b) {
-  return bool(get_min(comm, each_leq_to(fabs_each(a), b)));
+  return bool(get_min(comm, each_leq_to(fabs_each(lazy(a)), b)));
 }
 
 static Reals diffuse_densities(Mesh* mesh, Graph g, Reals densities,
@@ -702,10 +721,10 @@ static Reals diffuse_integrals_weighted(Mesh* mesh, Graph g,
     }
     return out;
   }
-  auto weighted_sizes = fabs_each(quantity_integrals);
-  weighted_sizes = each_max_with(weighted_sizes, opts.floor);
-  auto weighted_densities =
-      divide_each_maybe_zero(error_integrals, weighted_sizes);
+  auto weighted_sizes =
+      evaluate(each_max_with(fabs_each(lazy(quantity_integrals)), opts.floor));
+  Reals weighted_densities = evaluate(
+      divide_each_maybe_zero(lazy(error_integrals), lazy(weighted_sizes)));
   weighted_densities = diffuse_densities(
       mesh, g, weighted_densities, weighted_sizes, opts, name, verbose);
   error_integrals = multiply_each(weighted_densities, weighted_sizes);
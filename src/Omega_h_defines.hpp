@@ -10,6 +10,7 @@ enum Omega_h_Type {
   OMEGA_H_I8 = 0,
   OMEGA_H_I32 = 2,
   OMEGA_H_I64 = 3,
+  OMEGA_H_F32 = 4,
   OMEGA_H_F64 = 5,
   OMEGA_H_REAL = OMEGA_H_F64,
 };
@@ -81,6 +82,8 @@ typedef I32 LO;
 typedef I32 ClassId;
 typedef I64 GO;
 typedef double Real;
+/* single precision, for fields that don't need more (e.g. visualization) */
+typedef float F32;
 
 template <typename F>
 auto apply_to_omega_h_types(Omega_h_Type type, const F&& f) {
@@ -97,6 +100,10 @@ auto apply_to_omega_h_types(Omega_h_Type type, const F&& f) {
       return f(I64{});
       break;
     }
+    case OMEGA_H_F32: {
+      return f(F32{});
+      break;
+    }
     case OMEGA_H_F64: {
       return f(Real{});
       break;
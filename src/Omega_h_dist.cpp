@@ -3,7 +3,9 @@
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_int_scan.hpp"
+#include "Omega_h_library.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_node_exch.hpp"
 #include "Omega_h_sort.hpp"
 
 namespace Omega_h {
@@ -71,8 +73,23 @@ void Dist::set_dest_ranks(Read<I32> items2ranks_in) {
   auto fdegrees = get_degrees(msgs2content_[F]);
   auto rdegrees = comm_[F]->alltoall(fdegrees);
   msgs2content_[R] = offset_scan(rdegrees);
+  set_node_exch();
 }
 
+void Dist::set_node_exch() {
+  node_exch_[F] = node_exch_[R] = nullptr;
+  auto const library = parent_comm_->library();
+  if (!library || !library->node_aware_comm()) return;
+  if (parent_comm_->size() == 1) return;
+  auto const leader = parent_comm_->node_leader(library->ranks_per_node());
+  for (Int i = 0; i < 2; ++i) {
+    node_exch_[i] = std::make_shared<NodeExch>(parent_comm_, leader,
+        comm_[i], comm_[1 - i], msgs2content_[i], msgs2content_[1 - i]);
+  }
+}
+
+bool Dist::is_node_aware() const { return node_exch_[F] != nullptr; }
+
 void Dist::set_dest_idxs(LOs fitems2rroots, LO nrroots) {
   OMEGA_H_TIME_FUNCTION;
   auto const rcontent2rroots = exch(fitems2rroots, 1);
@@ -101,6 +118,7 @@ Dist Dist::invert() const {
     out.items2content_[i] = items2content_[1 - i];
     out.msgs2content_[i] = msgs2content_[1 - i];
     out.comm_[i] = comm_[1 - i];
+    out.node_exch_[i] = node_exch_[1 - i];
   }
   return out;
 }
@@ -115,7 +133,12 @@ Read<T> Dist::exch(Read<T> data, Int width) const {
   if (items2content_[F].exists()) {
     data = permute(data, items2content_[F], width);
   }
-  data = comm_[F]->alltoallv(data, msgs2content_[F], msgs2content_[R], width);
+  if (node_exch_[F]) {
+    data = node_exch_[F]->exch(data, width);
+  } else {
+    data = comm_[F]->alltoallv(
+        data, msgs2content_[F], msgs2content_[R], width);
+  }
   if (items2content_[R].exists()) {
     data = unmap(items2content_[R], data, width);
   }
@@ -125,6 +148,8 @@ Read<T> Dist::exch(Read<T> data, Int width) const {
 template <typename T>
 Future<T> Dist::iexch(Read<T> data, Int width) const {
   ScopedTimer exch_timer("Dist::iexch");
+  /* the stages of a node-aware exchange depend on each other */
+  if (node_exch_[F]) return Future<T>(exch(data, width));
   if (roots2items_[F].exists()) {
     data = expand(data, roots2items_[F], width);
   }
@@ -132,9 +157,11 @@ Future<T> Dist::iexch(Read<T> data, Int width) const {
     data = permute(data, items2content_[F], width);
   }
   auto future = comm_[F]->ialltoallv(data, msgs2content_[F], msgs2content_[R], width);
-  auto callback = [this,width](Read<T> buf) {
-    if (this->items2content_[R].exists()) {
-      buf = unmap(this->items2content_[R], buf, width);
+  /* by value, the Dist may be gone by the time the future completes */
+  auto const ritems2rcontent = items2content_[R];
+  auto callback = [ritems2rcontent, width](Read<T> buf) {
+    if (ritems2rcontent.exists()) {
+      buf = unmap(ritems2rcontent, buf, width);
     }
     return buf;
   };
@@ -203,6 +230,7 @@ void Dist::change_comm(CommPtr new_comm) {
   // replace parent_comm_
   parent_comm_ = new_comm;
   // thats it! since all rank information is queried from graph comms
+  set_node_exch();
 }
 
 Remotes Dist::exch(Remotes data, Int width) const {
@@ -218,6 +246,7 @@ void Dist::copy(Dist const& other) {
     items2content_[i] = other.items2content_[i];
     msgs2content_[i] = other.msgs2content_[i];
     comm_[i] = other.comm_[i];
+    node_exch_[i] = other.node_exch_[i];
   }
 }
 
@@ -256,14 +285,86 @@ Dist create_dist_for_variable_sized(Dist copies2owners, LOs copies2data) {
   return Dist(copies2owners.parent_comm(), data_copies2owners, data_size);
 }
 
+template <typename T>
+ExchPlan<T>::ExchPlan(Dist const& dist, Int width)
+    : dist_(dist), width_(width) {
+  auto const inverse = dist_.invert();
+  ritems2rcontent_ = inverse.items2content();
+  rroots2ritems_ = inverse.roots2items();
+  nritems_ = inverse.nitems();
+#if !OMEGA_H_MPI_NEEDS_HOST_COPY
+  if (dist_.is_node_aware()) return;
+  sendbuf_ = Write<T>(dist_.nitems() * width_);
+  recvbuf_ = Write<T>(nritems_ * width_);
+  requests_ = dist_.comm()->alltoallv_init(
+      sendbuf_, dist_.msgs2content(), recvbuf_, inverse.msgs2content(), width_);
+#endif
+}
+
+template <typename T>
+Read<T> ExchPlan<T>::exch(Read<T> data) {
+  OMEGA_H_TIME_FUNCTION;
+#if OMEGA_H_MPI_NEEDS_HOST_COPY
+  return dist_.exch(data, width_);
+#else
+  if (!requests_) return dist_.exch(data, width_);
+  auto const width = width_;
+  auto const froots2fitems = dist_.roots2items();
+  auto const fitems2fcontent = dist_.items2content();
+  auto const has_fan = froots2fitems.exists();
+  auto const has_fperm = fitems2fcontent.exists();
+  auto const nfroots = has_fan ? dist_.nroots() : dist_.nitems();
+  OMEGA_H_CHECK(data.size() == nfroots * width);
+  auto const sendbuf = sendbuf_;
+  /* the expand() and permute() of Dist::exch() in one pass */
+  auto pack = OMEGA_H_LAMBDA(LO froot) {
+    auto const begin = has_fan ? froots2fitems[froot] : froot;
+    auto const end = has_fan ? froots2fitems[froot + 1] : froot + 1;
+    for (auto fitem = begin; fitem < end; ++fitem) {
+      auto const fcontent = has_fperm ? fitems2fcontent[fitem] : fitem;
+      for (Int c = 0; c < width; ++c) {
+        sendbuf[fcontent * width + c] = data[froot * width + c];
+      }
+    }
+  };
+  parallel_for(nfroots, std::move(pack), "ExchPlan::exch(pack)");
+  requests_->start_and_wait();
+  auto const ritems2rcontent = ritems2rcontent_;
+  auto const has_rperm = ritems2rcontent.exists();
+  auto const recvbuf = recvbuf_;
+  /* the result can't alias recvbuf, the next exch() overwrites it */
+  Write<T> out(nritems_ * width);
+  auto unpack = OMEGA_H_LAMBDA(LO ritem) {
+    auto const rcontent = has_rperm ? ritems2rcontent[ritem] : ritem;
+    for (Int c = 0; c < width; ++c) {
+      out[ritem * width + c] = recvbuf[rcontent * width + c];
+    }
+  };
+  parallel_for(nritems_, std::move(unpack), "ExchPlan::exch(unpack)");
+  return out;
+#endif
+}
+
+template <typename T>
+Read<T> ExchPlan<T>::exch_reduce(Read<T> data, Omega_h_Op op) {
+  return fan_reduce(rroots2ritems_, exch(data), width_, op);
+}
+
+template <typename T>
+Int ExchPlan<T>::width() const {
+  return width_;
+}
+
 #define INST_T(T)                                                              \
   template Read<T> Dist::exch(Read<T> data, Int width) const;                  \
   template Future<T> Dist::iexch(Read<T> data, Int width) const;             \
   template Read<T> Dist::exch_reduce(Read<T> data, Int width, Omega_h_Op op)   \
-      const;
+      const;                                                                   \
+  template class ExchPlan<T>;
 INST_T(I8)
 INST_T(I32)
 INST_T(I64)
+INST_T(F32)
 INST_T(Real)
 #undef INST_T
 
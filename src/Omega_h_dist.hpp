@@ -11,6 +11,8 @@
 
 namespace Omega_h {
 
+class NodeExch;
+
 /*! \brief an MPI distributor object which encapsulates the idea
           of a communication pattern between lots of small
           actors on each MPI rank.
@@ -122,6 +124,12 @@ class Dist {
   LOs items2content_[2];
   LOs msgs2content_[2];
   CommPtr comm_[2];
+  /* set when the Library asks for node-aware communication, see
+     Library::set_node_aware_comm(). exch() then uses these instead of
+     comm_[F]->alltoallv(). each sets itself up on its first exch(), so
+     the reverse one costs nothing until this Dist is inverted and used.
+     copies and inverses share them */
+  std::shared_ptr<NodeExch> node_exch_[2];
 
  public:
   Dist();
@@ -183,9 +191,11 @@ class Dist {
   LO nsrcs() const;
   void change_comm(CommPtr new_comm);
   Remotes exch(Remotes data, Int width) const;
+  bool is_node_aware() const;
 
  private:
   void copy(Dist const& other);
+  void set_node_exch();
   enum { F, R };
 };
 
@@ -198,14 +208,45 @@ class Dist {
  */
 Dist create_dist_for_variable_sized(Dist copies2owners, LOs copies2data);
 
+/*! \brief a Dist::exch() of one type and width, set up once to be
+          repeated many times
+  \details The send and receive buffers are allocated when the plan is
+   made, and the messages between them become persistent MPI requests
+   (Comm::alltoallv_init()), so each exch() only packs the data, starts
+   the requests and unpacks what was received.
+   When MPI can't take device buffers (OMEGA_H_MPI_NEEDS_HOST_COPY), or
+   the Dist is node-aware, exch() calls Dist::exch() instead.
+ */
+template <typename T>
+class ExchPlan {
+  Dist dist_;
+  Int width_;
+  LOs ritems2rcontent_;
+  LOs rroots2ritems_;
+  LO nritems_;
+  Write<T> sendbuf_;
+  Write<T> recvbuf_;
+  PersistentRequestsPtr requests_;
+
+ public:
+  ExchPlan(Dist const& dist, Int width);
+  ExchPlan(ExchPlan const&) = delete;
+  ExchPlan& operator=(ExchPlan const&) = delete;
+  Read<T> exch(Read<T> data);
+  Read<T> exch_reduce(Read<T> data, Omega_h_Op op);
+  Int width() const;
+};
+
 #define OMEGA_H_EXPL_INST_DECL(T)                                              \
   extern template Read<T> Dist::exch(Read<T> data, Int width) const;           \
   extern template Future<T> Dist::iexch(Read<T> data, Int width) const;        \
   extern template Read<T> Dist::exch_reduce<T>(                                \
-      Read<T> data, Int width, Omega_h_Op op) const;
+      Read<T> data, Int width, Omega_h_Op op) const;                           \
+  extern template class ExchPlan<T>;
 OMEGA_H_EXPL_INST_DECL(I8)
 OMEGA_H_EXPL_INST_DECL(I32)
 OMEGA_H_EXPL_INST_DECL(I64)
+OMEGA_H_EXPL_INST_DECL(F32)
 OMEGA_H_EXPL_INST_DECL(Real)
 #undef OMEGA_H_EXPL_INST_DECL
 
@@ -33,6 +33,7 @@ static_assert(sizeof(Int) == 4, "osh format assumes 32 bit Int");
 static_assert(sizeof(LO) == 4, "osh format assumes 32 bit LO");
 static_assert(sizeof(GO) == 8, "osh format assumes 64 bit GO");
 static_assert(sizeof(Real) == 8, "osh format assumes 64 bit Real");
+static_assert(sizeof(F32) == 4, "osh format assumes 32 bit F32");
 
 OMEGA_H_INLINE std::uint32_t bswap32(std::uint32_t a) {
 #if defined(__GNUC__) && !defined(__CUDA_ARCH__)
@@ -636,6 +637,7 @@ Mesh read(filesystem::path const& path, CommPtr comm, bool strict) {
 OMEGA_H_INST(I8)
 OMEGA_H_INST(I32)
 OMEGA_H_INST(I64)
+OMEGA_H_INST(F32)
 OMEGA_H_INST(Real)
 #undef OMEGA_H_INST
 
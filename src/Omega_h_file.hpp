@@ -303,6 +303,7 @@ void read(std::istream& stream, Mesh* mesh, I32 version);
 INST_DECL(I8)
 INST_DECL(I32)
 INST_DECL(I64)
+INST_DECL(F32)
 INST_DECL(Real)
 #undef INST_DECL
 
@@ -11,6 +11,10 @@
 #include <Omega_h_kokkos.hpp>
 #endif
 
+#ifdef OMEGA_H_USE_THREADS
+#include <Omega_h_thread_pool.hpp>
+#endif
+
 namespace Omega_h {
 
 template <typename InputIterator, typename UnaryFunction>
@@ -28,6 +32,11 @@ void for_each(InputIterator first, InputIterator last, UnaryFunction&& f) {
   for (LO i = 0; i < n; ++i) {
     f2(first[i]);
   }
+#elif defined(OMEGA_H_USE_THREADS)
+  LO const n = LO(last - first);
+  thread_pool_run(n, get_num_chunks(n), [&](LO, LO begin, LO end) {
+    for (LO i = begin; i < end; ++i) f2(first[i]);
+  });
 #else
   for (; first != last; ++first) {
     f2(*first);
@@ -48,10 +48,10 @@ bool Future<T>::completed() {
   OMEGA_H_CHECK(
       MPI_SUCCESS == MPI_Testall(static_cast<int>(requests_.size()),
                          requests_.data(), &flag, MPI_STATUSES_IGNORE));
-  if (flag == 0) {
+  if (flag != 0) {
     status_ = Status::completed;
   }
-  return flag == 0;
+  return flag != 0;
 #else   // !OMEGA_H_USE_MPI
   return true;
 #endif  // OMEGA_H_USE_MPI
@@ -87,6 +87,7 @@ Read<T> Future<T>::get() {
 OMEGA_H_INST(I8)
 OMEGA_H_INST(I32)
 OMEGA_H_INST(I64)
+OMEGA_H_INST(F32)
 OMEGA_H_INST(Real)
 #undef OMEGA_H_INST
 
@@ -97,6 +98,7 @@ OMEGA_H_INST(Real)
 OMEGA_H_INST(I8)
 OMEGA_H_INST(I32)
 OMEGA_H_INST(I64)
+OMEGA_H_INST(F32)
 OMEGA_H_INST(Real)
 #undef OMEGA_H_INST
 
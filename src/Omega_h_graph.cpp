@@ -7,7 +7,8 @@
 
 namespace Omega_h {
 
-LO Graph::nnodes() const { return a2ab.size() - 1; }
+/* -1 for an empty Graph() */
+LO Graph::nnodes() const { return a2ab.exists() ? a2ab.size() - 1 : -1; }
 
 LO Graph::nedges() const { return ab2b.size(); }
 
@@ -172,6 +173,7 @@ Read<T> map_onto(Read<T> a_data, Graph a2b, LO nb, T init_val, Int width) {
 INST(I8)
 INST(I32)
 INST(I64)
+INST(F32)
 INST(Real)
 #undef INST
 
@@ -1,5 +1,8 @@
 #include "Omega_h_indset_inline.hpp"
 
+#include "Omega_h_adapt.hpp"
+#include "Omega_h_random.hpp"
+
 namespace Omega_h {
 
 struct QualityCompare {
@@ -14,23 +17,35 @@ struct QualityCompare {
   }
 };
 
-Read<I8> find_indset(
-    Mesh* mesh, Int ent_dim, Graph graph, Reals quality, Read<I8> candidates) {
+Read<I8> find_indset(Mesh* mesh, Int ent_dim, Graph graph, Reals quality,
+    Read<I8> candidates, bool should_randomize, Int nlocal_rounds) {
   auto xadj = graph.a2ab;
   auto adj = graph.ab2b;
   QualityCompare compare;
-  compare.quality = quality;
   compare.global = mesh->globals(ent_dim);
-  return indset::find(mesh, ent_dim, xadj, adj, candidates, compare);
+  /* the same global number gives the same priority on every rank */
+  compare.quality = should_randomize
+                        ? unit_uniform_random_reals_from_globals(
+                              compare.global, 0, ent_dim)
+                        : quality;
+  return indset::find(
+      mesh, ent_dim, xadj, adj, candidates, compare, nlocal_rounds);
 }
 
-Read<I8> find_indset(
-    Mesh* mesh, Int ent_dim, Reals quality, Read<I8> candidates) {
+Read<I8> find_indset(Mesh* mesh, Int ent_dim, Reals quality,
+    Read<I8> candidates, bool should_randomize, Int nlocal_rounds) {
   if (ent_dim == mesh->dim()) return candidates;
   mesh->owners_have_all_upward(ent_dim);
   OMEGA_H_CHECK(mesh->owners_have_all_upward(ent_dim));
   auto graph = mesh->ask_star(ent_dim);
-  return find_indset(mesh, ent_dim, graph, quality, candidates);
+  return find_indset(mesh, ent_dim, graph, quality, candidates,
+      should_randomize, nlocal_rounds);
+}
+
+Read<I8> find_indset(Mesh* mesh, Int ent_dim, Reals quality,
+    Read<I8> candidates, AdaptOpts const& opts) {
+  return find_indset(mesh, ent_dim, quality, candidates,
+      opts.should_randomize_indset, opts.indset_local_rounds);
 }
 
 }  // end namespace Omega_h
@@ -7,11 +7,23 @@
 namespace Omega_h {
 
 class Mesh;
+struct AdaptOpts;
 
-Read<I8> find_indset(
-    Mesh* mesh, Int ent_dim, Graph graph, Reals quality, Read<I8> candidates);
-Read<I8> find_indset(
-    Mesh* mesh, Int ent_dim, Reals quality, Read<I8> candidates);
+/* neighboring candidates are ordered by quality, or with
+   should_randomize by random priorities derived from global numbers
+   (Luby's algorithm), which avoids long chains of decisions when many
+   qualities are equal. nlocal_rounds local iterations run between two
+   syncs. */
+Read<I8> find_indset(Mesh* mesh, Int ent_dim, Graph graph, Reals quality,
+    Read<I8> candidates, bool should_randomize = false,
+    Int nlocal_rounds = 1);
+Read<I8> find_indset(Mesh* mesh, Int ent_dim, Reals quality,
+    Read<I8> candidates, bool should_randomize = false,
+    Int nlocal_rounds = 1);
+/* find_indset() as configured by AdaptOpts::should_randomize_indset and
+   AdaptOpts::indset_local_rounds */
+Read<I8> find_indset(Mesh* mesh, Int ent_dim, Reals quality,
+    Read<I8> candidates, AdaptOpts const& opts);
 
 }  // end namespace Omega_h
 
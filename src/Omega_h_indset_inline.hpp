@@ -5,18 +5,22 @@
 #include <Omega_h_for.hpp>
 #include <Omega_h_indset.hpp>
 #include <Omega_h_mesh.hpp>
+#include <Omega_h_profile.hpp>
 
 namespace Omega_h {
 namespace indset {
 
 enum { NOT_IN, IN, UNKNOWN };
 
+/* only owned nodes decide, the others keep the state of their owner
+   from the last sync. an owner sees all the neighbors of its nodes, so
+   several local iterations can run between syncs without two adjacent
+   nodes both choosing to be IN. this decides the given owned nodes */
 template <class Compare>
-inline Read<I8> local_iteration(
-    LOs xadj, LOs adj, Read<I8> old_state, Compare compare) {
-  auto n = xadj.size() - 1;
-  Write<I8> new_state = deep_copy(old_state);
-  auto f = OMEGA_H_LAMBDA(LO v) {
+inline void local_iteration(LOs xadj, LOs adj, Read<I8> old_state,
+    Compare compare, LOs nodes, Write<I8> new_state) {
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto v = nodes[i];
     if (old_state[v] != UNKNOWN) return;
     auto begin = xadj[v];
     auto end = xadj[v + 1];
@@ -38,21 +42,36 @@ inline Read<I8> local_iteration(
     // only local maxima reach this line
     new_state[v] = IN;
   };
-  parallel_for(n, std::move(f));
-  return new_state;
+  parallel_for(nodes.size(), std::move(f));
 }
 
+/* the last local iteration decides the part interior while the
+   decisions of the part boundary are synced */
 template <class Compare>
 Read<I8> iteration(Mesh* mesh, Int dim, LOs xadj, LOs adj, Read<I8> old_state,
-    Compare compare) {
-  auto local_state = local_iteration(xadj, adj, old_state, compare);
-  auto synced_state = mesh->sync_array(dim, local_state, 1);
-  return synced_state;
+    Compare compare, Int nlocal_rounds = 1) {
+  auto boundary = mesh->ask_part_boundary(dim);
+  auto interior = mesh->ask_part_interior(dim);
+  auto state = old_state;
+  for (Int i = 0; i + 1 < nlocal_rounds; ++i) {
+    Write<I8> new_state = deep_copy(state);
+    local_iteration(xadj, adj, state, compare, boundary, new_state);
+    local_iteration(xadj, adj, state, compare, interior, new_state);
+    state = new_state;
+  }
+  Write<I8> new_state = deep_copy(state);
+  local_iteration(xadj, adj, state, compare, boundary, new_state);
+  auto future = mesh->isync_part_boundary(dim, new_state, 1);
+  local_iteration(xadj, adj, state, compare, interior, new_state);
+  return future.get();
 }
 
+/* counts the rounds (one sync and one reduction each) under the
+   "indset rounds" event, and the calls under "indset calls" */
 template <class Compare>
 Read<I8> find(Mesh* mesh, Int dim, LOs xadj, LOs adj, Read<I8> candidates,
-    Compare compare) {
+    Compare compare, Int nlocal_rounds = 1) {
+  OMEGA_H_CHECK(nlocal_rounds >= 1);
   auto n = xadj.size() - 1;
   OMEGA_H_CHECK(candidates.size() == n);
   auto initial_state = Write<I8>(n);
@@ -65,9 +84,13 @@ Read<I8> find(Mesh* mesh, Int dim, LOs xadj, LOs adj, Read<I8> candidates,
   parallel_for(n, f);
   auto comm = mesh->comm();
   auto state = Read<I8>(initial_state);
+  std::size_t nrounds = 0;
   while (get_max(comm, state) == UNKNOWN) {
-    state = iteration(mesh, dim, xadj, adj, state, compare);
+    state = iteration(mesh, dim, xadj, adj, state, compare, nlocal_rounds);
+    ++nrounds;
   }
+  count_event("indset calls");
+  count_event("indset rounds", nrounds);
   return state;
 }
 }  // namespace indset
@@ -4,41 +4,154 @@
 #include <iostream>
 
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_for.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mark.hpp"
 #include "Omega_h_mesh.hpp"
+#include "Omega_h_profile.hpp"
 
 namespace Omega_h {
 
+namespace {
+
+void apply_laplacian_at(CompressedGraph star, Read<I8> interior, Reals x,
+    Int width, LOs verts, Write<Real> y) {
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto const v = verts[i];
+    for (Int c = 0; c < width; ++c) {
+      Real sum = 0.0;
+      if (interior[v]) {
+        CompressedRow row(star, v);
+        for (auto vv = star.a2ab[v]; vv < star.a2ab[v + 1]; ++vv) {
+          sum += x[v * width + c] - x[row.next() * width + c];
+        }
+      }
+      y[v * width + c] = sum;
+    }
+  };
+  parallel_for(verts.size(), std::move(f), "apply_laplacian");
+}
+
+/* the graph Laplacian of the interior vertices, with the degree of a
+   vertex on the diagonal and -1 for each of its neighbors. boundary rows
+   are zero, their values are known. the rows of the part interior are
+   computed while those of the part boundary travel */
+Reals apply_laplacian(Mesh* mesh, CompressedGraph star, Read<I8> interior,
+    Reals x, Int width) {
+  Write<Real> y(mesh->nverts() * width);
+  apply_laplacian_at(
+      star, interior, x, width, mesh->ask_part_boundary(VERT), y);
+  auto future = mesh->isync_part_boundary(VERT, y, width);
+  apply_laplacian_at(
+      star, interior, x, width, mesh->ask_part_interior(VERT), y);
+  return future.get();
+}
+
+/* the diagonal of the Laplacian. rows of vertices at the edge of the
+   ghost layer are incomplete, so their owners provide it */
+Reals get_degrees(Mesh* mesh, CompressedGraph star) {
+  auto nverts = mesh->nverts();
+  Write<Real> degrees(nverts);
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    degrees[v] = Real(star.a2ab[v + 1] - star.a2ab[v]);
+  };
+  parallel_for(nverts, std::move(f), "get_degrees");
+  return mesh->sync_array(VERT, Reals(degrees), 1);
+}
+
+/* the Jacobi preconditioner, zero on the boundary */
+Reals precondition(Reals degrees, Read<I8> interior, Reals r, Int width) {
+  auto nverts = degrees.size();
+  Write<Real> z(nverts * width);
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    for (Int c = 0; c < width; ++c) {
+      z[v * width + c] = interior[v] ? (r[v * width + c] / degrees[v]) : 0.0;
+    }
+  };
+  parallel_for(nverts, std::move(f), "precondition");
+  return z;
+}
+
+/* one reproducible dot product per component, over the owned vertices */
+std::vector<Real> dot_owned(Mesh* mesh, Reals a, Reals b, Int width) {
+  std::vector<Real> out(static_cast<std::size_t>(width));
+  auto owned_prods = mesh->owned_array(VERT, read(multiply_each(a, b)), width);
+  repro_sum(mesh->comm(), owned_prods, width, out.data());
+  return out;
+}
+
+/* x + s * y, with one scale per component */
+Reals axpy_each(Reals x, std::vector<Real> const& s, Reals y, Int width) {
+  HostWrite<Real> h_scales(width);
+  for (Int c = 0; c < width; ++c) h_scales[c] = s[std::size_t(c)];
+  auto scales = Reals(h_scales.write());
+  Write<Real> out(x.size());
+  auto f = OMEGA_H_LAMBDA(LO i) { out[i] = x[i] + scales[i % width] * y[i]; };
+  parallel_for(x.size(), std::move(f), "axpy_each");
+  return out;
+}
+
+}  // end anonymous namespace
+
 Reals solve_laplacian(
     Mesh* mesh, Reals initial, Int width, Real tol, Real floor) {
+  OMEGA_H_TIME_FUNCTION;
   OMEGA_H_CHECK(mesh->owners_have_all_upward(VERT));
   OMEGA_H_CHECK(initial.size() == mesh->nverts() * width);
   auto comm = mesh->comm();
-  auto state = initial;
-  auto star = mesh->ask_star(VERT);
+  auto star = mesh->ask_compressed_star(VERT);
   auto interior = mark_by_class_dim(mesh, VERT, mesh->dim());
-  auto boundary = invert_marks(interior);
-  auto b2v = collect_marked(boundary);
-  auto weights = Reals(star.ab2b.size(), 1.0);
-  auto bc_data = read(unmap(b2v, initial, width));
-  bool done = false;
+  auto degrees = get_degrees(mesh, star);
+  /* conjugate gradients on the interior values, starting from the
+     initial ones. boundary values never change since the residual and
+     search directions are zero there */
+  auto w = width;
+  auto x = initial;
+  auto minus_r = apply_laplacian(mesh, star, interior, x, w);
+  auto r = multiply_each_by(minus_r, -1.0);
+  auto z = precondition(degrees, interior, r, w);
+  auto p = z;
+  auto rz = dot_owned(mesh, r, z, w);
+  /* stops once the preconditioned residual of every component has
+     dropped by tol relative to where it started, or below floor.
+     the sums are reproducible, so all ranks stop together */
+  auto const rz0 = rz;
+  auto is_converged = [&]() {
+    for (Int c = 0; c < w; ++c) {
+      auto i = std::size_t(c);
+      if (rz[i] > square(tol) * rz0[i] && rz[i] > square(floor)) return false;
+    }
+    return true;
+  };
   Int niters = 0;
-  do {
-    auto new_state_nobc = graph_weighted_average(star, weights, state, width);
-    auto new_state_w = deep_copy(new_state_nobc);
-    map_into(bc_data, b2v, new_state_w, width);
-    auto new_state = Reals(new_state_w);
-    new_state = mesh->sync_array(VERT, new_state, width);
-    auto local_done = are_close(state, new_state, tol, floor);
-    done = comm->reduce_and(local_done);
-    state = new_state;
+  while (!is_converged()) {
+    auto ap = apply_laplacian(mesh, star, interior, p, w);
+    auto pap = dot_owned(mesh, p, ap, w);
+    std::vector<Real> alpha(static_cast<std::size_t>(w), 0.0);
+    std::vector<Real> minus_alpha(static_cast<std::size_t>(w), 0.0);
+    for (Int c = 0; c < w; ++c) {
+      auto i = std::size_t(c);
+      if (pap[i] <= 0.0) continue;
+      alpha[i] = rz[i] / pap[i];
+      minus_alpha[i] = -alpha[i];
+    }
+    x = axpy_each(x, alpha, p, w);
+    r = axpy_each(r, minus_alpha, ap, w);
+    z = precondition(degrees, interior, r, w);
+    auto new_rz = dot_owned(mesh, r, z, w);
+    std::vector<Real> beta(static_cast<std::size_t>(w), 0.0);
+    for (Int c = 0; c < w; ++c) {
+      auto i = std::size_t(c);
+      if (rz[i] > 0.0) beta[i] = new_rz[i] / rz[i];
+    }
+    p = axpy_each(z, beta, p, w);
+    rz = new_rz;
     ++niters;
-  } while (!done);
+  }
   if (comm->rank() == 0) {
     std::cout << "laplacian solve took " << niters << " iterations\n";
   }
-  return state;
+  return x;
 }
 
 }  // end namespace Omega_h
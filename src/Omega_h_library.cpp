@@ -1,8 +1,11 @@
 #include <Omega_h_config.h>
+#include <Omega_h_adj.hpp>
 #include <Omega_h_cmdline.hpp>
 #include <Omega_h_library.hpp>
 #include <Omega_h_malloc.hpp>
 #include <Omega_h_profile.hpp>
+#include <Omega_h_thread_pool.hpp>
+#include <Omega_h_transfer.hpp>
 #include <Omega_h_dbg.hpp>
 
 #include <csignal>
@@ -116,9 +119,21 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
   cmdline.add_flag("--osh-fpe", "enable floating-point exceptions");
   cmdline.add_flag("--osh-silent", "suppress all output");
   cmdline.add_flag("--osh-pool", "use memory pooling");
+  cmdline.add_flag("--osh-node-aware",
+      "send messages between nodes through one leader rank per node");
+  cmdline.add_flag("--osh-hash-dedup",
+      "find unique edges and faces with a hash table instead of sorting");
+  cmdline.add_flag(
+      "--osh-pool-stats", "print memory pool statistics at finalization");
   auto& self_send_flag =
       cmdline.add_flag("--osh-self-send", "control self send threshold");
   self_send_flag.add_arg<int>("value");
+  auto& threads_flag = cmdline.add_flag(
+      "--osh-threads", "number of threads for parallel loops (0 for all cores)");
+  threads_flag.add_arg<int>("n");
+  auto& transfer_batch_flag = cmdline.add_flag("--osh-transfer-batch",
+      "number of tags transferred per kernel during adaptation (1 for one per tag)");
+  transfer_batch_flag.add_arg<int>("n");
   auto& mpi_ranks_flag =
       cmdline.add_flag("--osh-mpi-ranks-per-node", "mpi ranks per node (for CUDA+MPI)");
   mpi_ranks_flag.add_arg<int>("value");
@@ -147,6 +162,13 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
     self_send_threshold_ = cmdline.get<int>("--osh-self-send", "value");
   }
   silent_ = cmdline.parsed("--osh-silent");
+  print_pool_stats_ = cmdline.parsed("--osh-pool-stats");
+  node_aware_comm_ = cmdline.parsed("--osh-node-aware");
+  ranks_per_node_ = 0;
+  transfer_batch_size_ = TRANSFER_BATCH_SIZE;
+  if (cmdline.parsed("--osh-transfer-batch")) {
+    set_transfer_batch_size(cmdline.get<int>("--osh-transfer-batch", "n"));
+  }
 #ifdef OMEGA_H_USE_KOKKOS
   if (!Kokkos::is_initialized()) {
     if(argv != nullptr && argc != nullptr) {
@@ -162,6 +184,10 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
 #endif
   if (cmdline.parsed("--osh-signal")) Omega_h::protect();
   if (cmdline.parsed("--osh-pool")) enable_pooling();
+  if (cmdline.parsed("--osh-hash-dedup")) enable_hashed_dedup();
+  if (cmdline.parsed("--osh-threads")) {
+    set_num_threads(cmdline.get<int>("--osh-threads", "n"));
+  }
 #if defined(OMEGA_H_USE_SIMMODSUITE)
   MS_init();
   SimModel_start();
@@ -172,9 +198,29 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
 #endif
 }
 
+static void print_pool_stats(CommPtr comm, PoolStats const& stats) {
+  auto const max_reserved =
+      comm->allreduce(I64(stats.high_water_bytes_reserved), OMEGA_H_MAX);
+  if (comm->rank() != 0) return;
+  std::cout << "pool stats (rank 0):\n";
+  std::cout << "  bytes reserved: " << stats.bytes_reserved << '\n';
+  std::cout << "  bytes in use: " << stats.bytes_in_use << '\n';
+  std::cout << "  bytes requested: " << stats.bytes_requested << '\n';
+  std::cout << "  high water bytes reserved: "
+            << stats.high_water_bytes_reserved << '\n';
+  std::cout << "  max high water bytes reserved over ranks: " << max_reserved
+            << '\n';
+  std::cout << "  fragmentation: " << fragmentation(stats) << '\n';
+  std::cout << "  hits: " << stats.hits << ", misses: " << stats.misses
+            << ", hit rate: " << hit_rate(stats) << '\n';
+}
+
 Library::Library(Library const& other)
     : world_(other.world_),
-      self_(other.self_)
+      self_(other.self_),
+      node_aware_comm_(other.node_aware_comm_),
+      ranks_per_node_(other.ranks_per_node_),
+      transfer_batch_size_(other.transfer_batch_size_)
 #ifdef OMEGA_H_USE_MPI
       ,
       we_called_mpi_init(other.we_called_mpi_init)
@@ -184,6 +230,7 @@ Library::Library(Library const& other)
       we_called_kokkos_init(other.we_called_kokkos_init)
 #endif
 {
+  print_pool_stats_ = false;
 }
 
 Library::~Library() {
@@ -196,9 +243,14 @@ Library::~Library() {
     }
     Omega_h::profile::print_top_sorted(
           *Omega_h::profile::global_singleton_history, total_runtime);
+    Omega_h::profile::print_counters(
+          *Omega_h::profile::global_singleton_history);
     delete Omega_h::profile::global_singleton_history;
     Omega_h::profile::global_singleton_history = nullptr;
   }
+  if (print_pool_stats_ && is_pooling_enabled()) {
+    print_pool_stats(world_, pool_stats());
+  }
   // need to destroy all Comm objects prior to MPI_Finalize()
   world_ = CommPtr();
   self_ = CommPtr();
@@ -241,4 +293,27 @@ CommPtr Library::self() {
 
 LO Library::self_send_threshold() const { return self_send_threshold_; }
 
+PoolStats Library::pool_stats() const { return get_pooling_stats(); }
+
+int Library::num_threads() const { return get_num_threads(); }
+
+void Library::set_num_threads(int n) { ::Omega_h::set_num_threads(n); }
+
+bool Library::node_aware_comm() const { return node_aware_comm_; }
+
+I32 Library::ranks_per_node() const { return ranks_per_node_; }
+
+void Library::set_node_aware_comm(bool on, I32 ranks_per_node) {
+  OMEGA_H_CHECK(ranks_per_node >= 0);
+  node_aware_comm_ = on;
+  ranks_per_node_ = ranks_per_node;
+}
+
+Int Library::transfer_batch_size() const { return transfer_batch_size_; }
+
+void Library::set_transfer_batch_size(Int n) {
+  OMEGA_H_CHECK(1 <= n && n <= TRANSFER_BATCH_SIZE);
+  transfer_batch_size_ = n;
+}
+
 }  // end namespace Omega_h
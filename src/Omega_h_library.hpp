@@ -4,6 +4,7 @@
 #include <map>
 
 #include <Omega_h_comm.hpp>
+#include <Omega_h_pool.hpp>
 
 namespace Omega_h {
 
@@ -35,8 +36,27 @@ class Library {
   CommPtr self();
   void add_to_timer(std::string const& name, double nsecs);
   LO self_send_threshold() const;
+  PoolStats pool_stats() const;
+  /* threads used by parallel loops, see Omega_h_thread_pool.hpp.
+     also set by --osh-threads n */
+  int num_threads() const;
+  void set_num_threads(int n);
+  /* whether Dist sends the messages between nodes through one leader
+     rank per node, see Omega_h_node_exch.hpp. also set by
+     --osh-node-aware. ranks_per_node > 0 groups consecutive ranks into
+     nodes instead of asking MPI which ranks share memory */
+  bool node_aware_comm() const;
+  I32 ranks_per_node() const;
+  void set_node_aware_comm(bool on, I32 ranks_per_node = 0);
+  /* how many tags of the same type and size the mesh adaptation transfers
+     handle in one kernel, see Omega_h_transfer.hpp. between 1 (one kernel
+     per tag) and TRANSFER_BATCH_SIZE, the default. also set by
+     --osh-transfer-batch n */
+  Int transfer_batch_size() const;
+  void set_transfer_batch_size(Int n);
   LO self_send_threshold_;
   bool silent_;
+  bool print_pool_stats_;
   std::vector<std::string> argv_;
 
  private:
@@ -48,6 +68,9 @@ class Library {
   );
   CommPtr world_;
   CommPtr self_;
+  bool node_aware_comm_;
+  I32 ranks_per_node_;
+  Int transfer_batch_size_;
 #ifdef OMEGA_H_USE_MPI
   bool we_called_mpi_init;
 #endif
@@ -16,14 +16,22 @@ void host_free(void* ptr, std::size_t) {
   ::std::free(ptr);
 }
 
-static Pool* host_pool = nullptr;
+static ThreadSafePool* host_pool = nullptr;
+
+/* the pool may call these from several threads,
+   so unlike host_malloc/host_free they are not profiled */
+static void* unprofiled_host_malloc(std::size_t size) {
+  return ::std::malloc(size);
+}
+
+static void unprofiled_host_free(void* ptr, std::size_t) { ::std::free(ptr); }
 
 //if true then either host pooling for a non-kokkos build is enabled or
 //kokkos based pooling is enabled for the default memory space
 static bool pooling_enabled = false;
 
 void enable_pooling() {
-  host_pool = new Pool(host_malloc, host_free);
+  host_pool = new ThreadSafePool(unprofiled_host_malloc, unprofiled_host_free);
   pooling_enabled = true;
 }
 
@@ -35,6 +43,11 @@ void disable_pooling() {
 
 bool is_pooling_enabled() { return pooling_enabled; }
 
+PoolStats get_pooling_stats() {
+  if (host_pool) return get_stats(*host_pool);
+  return PoolStats();
+}
+
 void* maybe_pooled_host_malloc(std::size_t size) {
   #ifdef OMEGA_H_USE_KOKKOS
   Omega_h::fail("This function should not be called when Kokkos is enabled. "
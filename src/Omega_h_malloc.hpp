@@ -1,6 +1,7 @@
 #ifndef OMEGA_H_MALLOC_HPP
 #define OMEGA_H_MALLOC_HPP
 
+#include <Omega_h_pool.hpp>
 #include <cstddef>
 
 namespace Omega_h {
@@ -13,6 +14,9 @@ void disable_pooling();
 
 bool is_pooling_enabled();
 
+/* statistics of the host pool, all zero if it is not in use */
+PoolStats get_pooling_stats();
+
 void* maybe_pooled_host_malloc(std::size_t size);
 void maybe_pooled_host_free(void* ptr, std::size_t size);
 }  // namespace Omega_h
@@ -167,6 +167,7 @@ Read<T> fan_reduce(LOs a2b, Read<T> b_data, Int width, Omega_h_Op op);
 INST_T(I8)
 INST_T(I32)
 INST_T(I64)
+INST_T(F32)
 INST_T(Real)
 #undef INST_T
 
@@ -3,7 +3,10 @@
 #include <algorithm>
 #include <cctype>
 #include <iostream>
+#include <map>
+#include <tuple>
 
+#include "Omega_h_arena.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_bcast.hpp"
 #include "Omega_h_compare.hpp"
@@ -15,7 +18,9 @@
 #include "Omega_h_mark.hpp"
 #include "Omega_h_migrate.hpp"
 #include "Omega_h_quality.hpp"
+#include "Omega_h_quality_cache.hpp"
 #include "Omega_h_shape.hpp"
+#include "Omega_h_structured.hpp"
 #include "Omega_h_timer.hpp"
 #include "Omega_h_reduce.hpp"
 #include "Omega_h_print.hpp"
@@ -31,6 +36,10 @@ Mesh::Mesh() {
   nghost_layers_ = -1;
   library_ = nullptr;
   matched_ = -1;
+  cache_clock_ = 0;
+  cache_budget_ = 0;
+  cold_tag_period_ = 0;
+  tag_lookups_ = 0;
 }
 
 Mesh::Mesh(Library* library_in) : Mesh() { set_library(library_in); }
@@ -123,6 +132,8 @@ LOs Mesh::get_model_matches(Int ent_dim) {
 
 void Mesh::set_parents(Int ent_dim, Parents parents) {
   check_dim2(ent_dim);
+  parents.parent_idx = promote_from_arena(parents.parent_idx);
+  parents.codes = promote_from_arena(parents.codes);
   parents_[ent_dim] = std::make_shared<Parents>(parents);
 }
 
@@ -176,6 +187,7 @@ void Mesh::add_tag(Int ent_dim, std::string const& name, Int ncomps,
   }
   auto ptr = std::make_shared<Tag<T>>(name, ncomps, array_type);
   if (array.exists()) {
+    array = promote_from_arena(array);
     OMEGA_H_CHECK(array.size() == nents_[ent_dim] * ncomps);
     ptr->set_array(array);
   }
@@ -201,12 +213,36 @@ void Mesh::set_tag(
   this->add_tag(ent_dim, name, divide_no_remainder(array.size(), nents(ent_dim)), array, internal, array_type);
 }
 
+template <typename T>
+void Mesh::add_segmented_tag(Int ent_dim, std::string const& name,
+    Int ncomps, std::vector<TagSegment<T>> segments, ArrayType array_type) {
+  LO size = 0;
+  /* each source array is promoted once */
+  std::map<T const*, Read<T>> promoted;
+  for (auto& segment : segments) {
+    auto it = promoted.find(segment.array.data());
+    if (it == promoted.end()) {
+      it = promoted
+               .emplace(segment.array.data(), promote_from_arena(segment.array))
+               .first;
+    }
+    segment.array = it->second;
+    size += segment.size;
+  }
+  OMEGA_H_CHECK(size == nents_[ent_dim] * ncomps);
+  this->add_tag(ent_dim, name, ncomps, Read<T>(), true, array_type);
+  auto ptr = std::make_shared<Tag<T>>(name, ncomps, array_type);
+  ptr->set_segments(std::move(segments));
+  *(this->tag_iter(ent_dim, name)) = std::move(ptr);
+}
+
 void Mesh::react_to_set_tag(Int ent_dim, std::string const& name) {
   /* hardcoded cache invalidations */
   bool is_coordinates = (name == "coordinates");
   if ((ent_dim == VERT) && (is_coordinates || (name == "metric"))) {
     remove_tag(EDGE, "length");
     remove_tag(dim(), "quality");
+    reset_cavity_quality_caches(this);
   }
   if ((ent_dim == VERT) && is_coordinates) {
     remove_tag(dim(), "size");
@@ -220,7 +256,11 @@ TagBase const* Mesh::get_tagbase(Int ent_dim, std::string const& name) const {
     Omega_h_fail("get_tagbase(%s, %s): doesn't exist\n",
         topological_plural_name(family(), ent_dim), name.c_str());
   }
-  return it->get();
+  auto const tag = it->get();
+  if (cold_tag_period_ > 0 && ++tag_lookups_ >= cold_tag_period_) {
+    compress_cold_tags(tag);
+  }
+  return tag;
 }
 
 template <typename T>
@@ -233,6 +273,28 @@ Read<T> Mesh::get_array(Int ent_dim, std::string const& name) const {
   return get_tag<T>(ent_dim, name)->array();
 }
 
+void Mesh::set_cold_tag_compression(Int period) {
+  OMEGA_H_CHECK(period >= 0);
+  cold_tag_period_ = period;
+  tag_lookups_ = 0;
+  for (Int d = 0; d <= 3; ++d) {
+    for (auto const& tag : tags_[d]) {
+      tag->reset_naccesses();
+    }
+  }
+}
+
+void Mesh::compress_cold_tags(TagBase const* keep) const {
+  OMEGA_H_TIME_FUNCTION;
+  tag_lookups_ = 0;
+  for (Int d = 0; d <= 3; ++d) {
+    for (auto const& tag : tags_[d]) {
+      if (tag->naccesses() == 0 && tag.get() != keep) tag->compress();
+      tag->reset_naccesses();
+    }
+  }
+}
+
 void Mesh::remove_tag(Int ent_dim, std::string const& name) {
   if (!has_tag(ent_dim, name)) return;
   check_dim2(ent_dim);
@@ -265,13 +327,14 @@ bool Mesh::has_ents(Int ent_dim) const {
 bool Mesh::has_adj(Int from, Int to) const {
   check_dim(from);
   check_dim(to);
-  return bool(adjs_[from][to]);
+  return bool(adjs_[from][to]) || (structured_ && from != to);
 }
 
 Adj Mesh::get_adj(Int from, Int to) const {
   check_dim2(from);
   check_dim2(to);
   OMEGA_H_CHECK(has_adj(from, to));
+  if (!adjs_[from][to]) return structured_adj(*structured_, from, to);
   return *(adjs_[from][to]);
 }
 
@@ -289,6 +352,13 @@ Adj Mesh::ask_up(Int from, Int to) {
   return ask_adj(from, to);
 }
 
+void Mesh::add_up(Int from, Int to, Adj up) {
+  OMEGA_H_CHECK(from < to);
+  add_adj(from, to, up);
+  touch_cached(from, to, "");
+  enforce_cache_budget();
+}
+
 Graph Mesh::ask_star(Int ent_dim) {
   OMEGA_H_CHECK(ent_dim < dim());
   return ask_adj(ent_dim, ent_dim);
@@ -296,6 +366,133 @@ Graph Mesh::ask_star(Int ent_dim) {
 
 Graph Mesh::ask_dual() { return ask_adj(dim(), dim()); }
 
+CompressedGraph Mesh::ask_compressed_star(Int ent_dim) {
+  OMEGA_H_TIME_FUNCTION;
+  check_dim2(ent_dim);
+  if (compressed_stars_[ent_dim]) {
+    count_event("mesh adj cache hit");
+    touch_cached(ent_dim, ent_dim, COMPRESSED_STAR);
+    return *compressed_stars_[ent_dim];
+  }
+  count_event("mesh adj cache miss");
+  auto const star = has_adj(ent_dim, ent_dim) ? get_adj(ent_dim, ent_dim)
+                                              : derive_adj(ent_dim, ent_dim);
+  auto const compressed = compress_graph(star);
+  compressed_stars_[ent_dim] =
+      std::make_shared<CompressedGraph const>(compressed);
+  touch_cached(ent_dim, ent_dim, COMPRESSED_STAR);
+  enforce_cache_budget();
+  return compressed;
+}
+
+void Mesh::set_structured(StructuredBox const& box) {
+  OMEGA_H_CHECK(family() == OMEGA_H_HYPERCUBE);
+  OMEGA_H_CHECK(box.dim == dim());
+  for (Int d = 0; d <= dim(); ++d) {
+    OMEGA_H_CHECK(!has_ents(d));
+    nents_[d] = box.nents(d);
+  }
+  structured_ = std::make_shared<StructuredBox const>(box);
+}
+
+bool Mesh::is_structured() const { return bool(structured_); }
+
+StructuredBox const* Mesh::structured() const { return structured_.get(); }
+
+void Mesh::materialize_structured() {
+  if (!structured_) return;
+  auto const box = structured_;
+  structured_.reset();
+  for (Int d = 1; d <= dim(); ++d) {
+    if (!adjs_[d][d - 1]) add_adj(d, d - 1, structured_adj(*box, d, d - 1));
+  }
+}
+
+void Mesh::set_cache_budget(std::size_t bytes) {
+  cache_budget_ = bytes;
+  enforce_cache_budget();
+}
+
+std::size_t Mesh::cache_budget() const { return cache_budget_; }
+
+std::size_t Mesh::cache_bytes() const {
+  std::size_t bytes = 0;
+  for (auto const& entry : cache_entries_) bytes += cached_bytes(entry);
+  return bytes;
+}
+
+template <typename T>
+static std::size_t array_bytes(Read<T> a) {
+  if (!a.exists()) return 0;
+  return std::size_t(a.size()) * sizeof(T);
+}
+
+void Mesh::touch_cached(Int from, Int to, std::string const& tag_name) {
+  ++cache_clock_;
+  for (auto& entry : cache_entries_) {
+    if (entry.from == from && entry.to == to && entry.tag_name == tag_name) {
+      entry.last_use = cache_clock_;
+      return;
+    }
+  }
+  cache_entries_.push_back({from, to, tag_name, cache_clock_});
+}
+
+/* zero if the cached object no longer exists */
+std::size_t Mesh::cached_bytes(CacheEntry const& entry) const {
+  if (entry.tag_name == COMPRESSED_STAR) {
+    auto const& star = compressed_stars_[entry.from];
+    return star ? star->nbytes() : 0;
+  }
+  if (entry.tag_name == VTX_PATCHES) {
+    auto const& patches = vtx_patches_[entry.from][entry.to];
+    if (!patches) return 0;
+    return array_bytes(patches->graph.a2ab) + array_bytes(patches->graph.ab2b);
+  }
+  if (entry.tag_name.empty()) {
+    auto const& adj = adjs_[entry.from][entry.to];
+    if (!adj) return 0;
+    return array_bytes(adj->a2ab) + array_bytes(adj->ab2b) +
+           array_bytes(adj->codes);
+  }
+  auto const it = tag_iter(entry.from, entry.tag_name);
+  if (it == tags_[entry.from].end()) return 0;
+  return (*it)->nbytes();
+}
+
+void Mesh::enforce_cache_budget() {
+  std::size_t total = 0;
+  std::vector<CacheEntry> live;
+  for (auto const& entry : cache_entries_) {
+    auto const bytes = cached_bytes(entry);
+    if (bytes == 0) continue;
+    total += bytes;
+    live.push_back(entry);
+  }
+  cache_entries_ = std::move(live);
+  if (cache_budget_ == 0) return;
+  /* the most recently used entry is never evicted, it is what the
+     caller just asked for */
+  while (total > cache_budget_ && cache_entries_.size() > 1) {
+    auto victim = cache_entries_.begin();
+    for (auto it = cache_entries_.begin(); it != cache_entries_.end(); ++it) {
+      if (it->last_use < victim->last_use) victim = it;
+    }
+    total -= cached_bytes(*victim);
+    if (victim->tag_name == COMPRESSED_STAR) {
+      compressed_stars_[victim->from].reset();
+    } else if (victim->tag_name == VTX_PATCHES) {
+      vtx_patches_[victim->from][victim->to].reset();
+    } else if (victim->tag_name.empty()) {
+      adjs_[victim->from][victim->to] = AdjPtr();
+    } else {
+      remove_tag(victim->from, victim->tag_name);
+    }
+    cache_entries_.erase(victim);
+    count_event("mesh cache evict");
+  }
+}
+
 Mesh::TagIter Mesh::tag_iter(Int ent_dim, std::string const& name) {
   return std::find_if(tags_[ent_dim].begin(), tags_[ent_dim].end(),
       [&](TagPtr const& a) { return a->name() == name; });
@@ -356,6 +553,9 @@ void Mesh::add_adj(Int from, Int to, Adj adj) {
     }
     OMEGA_H_CHECK(adj.a2ab.size() == nents(from) + 1);
   }
+  adj.a2ab = promote_from_arena(adj.a2ab);
+  adj.ab2b = promote_from_arena(adj.ab2b);
+  adj.codes = promote_from_arena(adj.codes);
   adjs_[from][to] = std::make_shared<Adj>(adj);
 }
 
@@ -403,11 +603,24 @@ Adj Mesh::ask_adj(Int from, Int to) {
   OMEGA_H_TIME_FUNCTION;
   check_dim2(from);
   check_dim2(to);
+  if (structured_ && from != to && !adjs_[from][to]) {
+    count_event("mesh adj structured");
+    return structured_adj(*structured_, from, to);
+  }
   if (has_adj(from, to)) {
+    count_event("mesh adj cache hit");
+    for (auto& entry : cache_entries_) {
+      if (entry.from == from && entry.to == to && entry.tag_name.empty()) {
+        entry.last_use = ++cache_clock_;
+      }
+    }
     return get_adj(from, to);
   }
+  count_event("mesh adj cache miss");
   Adj derived = derive_adj(from, to);
   adjs_[from][to] = std::make_shared<Adj>(derived);
+  touch_cached(from, to, "");
+  enforce_cache_budget();
   return derived;
 }
 
@@ -428,26 +641,44 @@ Read<GO> Mesh::globals(Int ent_dim) const {
 
 Reals Mesh::ask_lengths() {
   if (!has_tag(EDGE, "length")) {
+    count_event("mesh tag cache miss");
     auto lengths = measure_edges_metric(this);
     add_tag(EDGE, "length", 1, lengths);
+  } else {
+    count_event("mesh tag cache hit");
   }
-  return get_array<Real>(EDGE, "length");
+  auto const lengths = get_array<Real>(EDGE, "length");
+  touch_cached(EDGE, EDGE, "length");
+  enforce_cache_budget();
+  return lengths;
 }
 
 Reals Mesh::ask_qualities() {
   if (!has_tag(dim(), "quality")) {
+    count_event("mesh tag cache miss");
     auto qualities = measure_qualities(this);
     add_tag(dim(), "quality", 1, qualities);
+  } else {
+    count_event("mesh tag cache hit");
   }
-  return get_array<Real>(dim(), "quality");
+  auto const qualities = get_array<Real>(dim(), "quality");
+  touch_cached(dim(), dim(), "quality");
+  enforce_cache_budget();
+  return qualities;
 }
 
 Reals Mesh::ask_sizes() {
   if (!has_tag(dim(), "size")) {
+    count_event("mesh tag cache miss");
     auto sizes = measure_elements_real(this);
     add_tag(dim(), "size", 1, sizes);
+  } else {
+    count_event("mesh tag cache hit");
   }
-  return get_array<Real>(dim(), "size");
+  auto const sizes = get_array<Real>(dim(), "size");
+  touch_cached(dim(), dim(), "size");
+  enforce_cache_budget();
+  return sizes;
 }
 
 Bytes Mesh::ask_levels(Int ent_dim) {
@@ -504,6 +735,8 @@ void Mesh::set_owners(Int ent_dim, Remotes owners) {
   check_dim2(ent_dim);
   OMEGA_H_CHECK(nents(ent_dim) == owners.ranks.size());
   OMEGA_H_CHECK(nents(ent_dim) == owners.idxs.size());
+  owners.ranks = promote_from_arena(owners.ranks);
+  owners.idxs = promote_from_arena(owners.idxs);
   owners_[ent_dim] = owners;
   dists_[ent_dim] = DistPtr();
 }
@@ -554,11 +787,82 @@ Dist Mesh::ask_dist(Int ent_dim) {
     auto owners = ask_owners(ent_dim);
     OMEGA_H_CHECK(owners.ranks.exists());
     OMEGA_H_CHECK(owners.idxs.exists());
+    /* kept as long as the owners are, like the plans made from it */
+    ScopedNoArena no_arena;
     dists_[ent_dim] = std::make_shared<Dist>(comm_, owners, nents(ent_dim));
   }
   return *(dists_[ent_dim]);
 }
 
+template <typename T>
+using ExchPlanMap = std::map<Int, std::shared_ptr<ExchPlan<T>>>;
+
+struct Mesh::ExchPlans {
+  DistPtr dist;
+  /* reduce_array() sends along dist, sync_array() along its inverse */
+  std::tuple<ExchPlanMap<I8>, ExchPlanMap<I32>, ExchPlanMap<I64>,
+      ExchPlanMap<F32>, ExchPlanMap<Real>>
+      plans[2];
+};
+
+template <typename T>
+ExchPlan<T>& Mesh::ask_exch_plan(Int ent_dim, Int width, bool is_sync) {
+  auto dist = ask_dist(ent_dim);
+  auto& plans = exch_plans_[ent_dim];
+  if (!plans || plans->dist != dists_[ent_dim]) {
+    plans = std::make_shared<ExchPlans>();
+    plans->dist = dists_[ent_dim];
+  }
+  auto& plan = std::get<ExchPlanMap<T>>(plans->plans[is_sync])[width];
+  if (!plan) {
+    count_event("exch plan miss");
+    /* the plan's buffers live as long as the mesh keeps the plan */
+    ScopedNoArena no_arena;
+    plan = std::make_shared<ExchPlan<T>>(
+        is_sync ? dist.invert() : dist, width);
+  }
+  return *plan;
+}
+
+struct Mesh::PartSplit {
+  DistPtr dist;
+  LOs boundary;
+  LOs interior;
+  /* the entities owned by other ranks, and a Dist from their owners
+     to them that only carries the values of the part boundary */
+  LOs copies;
+  Dist owners2copies;
+};
+
+Mesh::PartSplit const& Mesh::ask_part_split(Int ent_dim) {
+  auto& split = part_splits_[ent_dim];
+  if (!could_be_shared(ent_dim)) {
+    /* everything is owned and interior, only the count can change */
+    if (!split || split->dist || split->interior.size() != nents(ent_dim)) {
+      split = std::make_shared<PartSplit>();
+      split->boundary = LOs({});
+      split->interior = LOs(nents(ent_dim), 0, 1);
+    }
+    return *split;
+  }
+  ask_dist(ent_dim);
+  if (split && split->dist == dists_[ent_dim]) return *split;
+  OMEGA_H_TIME_FUNCTION;
+  split = std::make_shared<PartSplit>();
+  split->dist = dists_[ent_dim];
+  auto const owners = ask_owners(ent_dim);
+  auto const is_owned = owned(ent_dim);
+  split->copies = collect_marked(invert_marks(is_owned));
+  split->owners2copies =
+      Dist(comm_, unmap(split->copies, owners), nents(ent_dim)).invert();
+  auto const ncopies = get_degrees(split->owners2copies.roots2items());
+  auto const have_copies = each_gt(ncopies, LO(0));
+  split->boundary = collect_marked(have_copies);
+  split->interior =
+      collect_marked(land_each(is_owned, invert_marks(have_copies)));
+  return *split;
+}
+
 Omega_h_Parting Mesh::parting() const {
   OMEGA_H_CHECK(parting_ != -1);
   return Omega_h_Parting(parting_);
@@ -734,7 +1038,7 @@ template <typename T>
 Read<T> Mesh::sync_array(Int ent_dim, Read<T> a, Int width) {
   OMEGA_H_TIME_FUNCTION;
   if (!could_be_shared(ent_dim)) return a;
-  return ask_dist(ent_dim).invert().exch(a, width);
+  return ask_exch_plan<T>(ent_dim, width, true).exch(a);
 }
 
 template <typename T>
@@ -754,6 +1058,31 @@ Future<T> Mesh::isync_array(Int ent_dim, Read<T> a, Int width) {
   return ask_dist(ent_dim).invert().iexch(a, width);
 }
 
+LOs Mesh::ask_part_boundary(Int ent_dim) {
+  return ask_part_split(ent_dim).boundary;
+}
+
+LOs Mesh::ask_part_interior(Int ent_dim) {
+  return ask_part_split(ent_dim).interior;
+}
+
+template <typename T>
+Future<T> Mesh::isync_part_boundary(Int ent_dim, Write<T> a, Int width) {
+  OMEGA_H_CHECK(ent_dim >= 0 && ent_dim <= dim_);
+  OMEGA_H_CHECK(a.size() == nents(ent_dim) * width);
+  if (!could_be_shared(ent_dim)) {
+    return Future<T>(Read<T>(a));
+  }
+  auto const& split = ask_part_split(ent_dim);
+  auto future = split.owners2copies.iexch(Read<T>(a), width);
+  auto const copies = split.copies;
+  future.add_callback([a, copies, width](Read<T> copy_data) -> Read<T> {
+    map_into(copy_data, copies, a, width);
+    return a;
+  });
+  return future;
+}
+
 template <typename T>
 Read<T> Mesh::sync_subset_array(
     Int ent_dim, Read<T> a_data, LOs a2e, T default_val, Int width) {
@@ -767,7 +1096,7 @@ Read<T> Mesh::sync_subset_array(
 template <typename T>
 Read<T> Mesh::reduce_array(Int ent_dim, Read<T> a, Int width, Omega_h_Op op) {
   if (!could_be_shared(ent_dim)) return a;
-  return ask_dist(ent_dim).exch_reduce(a, width, op);
+  return ask_exch_plan<T>(ent_dim, width, false).exch_reduce(a, op);
 }
 
 template <typename T>
@@ -811,6 +1140,12 @@ void Mesh::sync_tag(Int ent_dim, std::string const& name) {
       set_tag(ent_dim, name, out);
       break;
     }
+    case OMEGA_H_F32: {
+      auto out =
+          sync_array(ent_dim, as<F32>(tagbase)->array(), tagbase->ncomps());
+      set_tag(ent_dim, name, out);
+      break;
+    }
     case OMEGA_H_F64: {
       auto out =
           sync_array(ent_dim, as<Real>(tagbase)->array(), tagbase->ncomps());
@@ -843,6 +1178,13 @@ void Mesh::sync_tag_matched(Int ent_dim, std::string const& name) {
       swap_root_owner(ent_dim);
       break;
     }
+    case OMEGA_H_F32: {
+      auto out =
+          sync_array_matched(ent_dim, as<F32>(tagbase)->array(), tagbase->ncomps());
+      set_tag(ent_dim, name, out);
+      swap_root_owner(ent_dim);
+      break;
+    }
     case OMEGA_H_F64: {
       auto out =
           sync_array_matched(ent_dim, as<Real>(tagbase)->array(), tagbase->ncomps());
@@ -874,6 +1216,12 @@ void Mesh::reduce_tag(Int ent_dim, std::string const& name, Omega_h_Op op) {
       set_tag(ent_dim, name, out);
       break;
     }
+    case OMEGA_H_F32: {
+      auto out = reduce_array(
+          ent_dim, as<F32>(tagbase)->array(), tagbase->ncomps(), op);
+      set_tag(ent_dim, name, out);
+      break;
+    }
     case OMEGA_H_F64: {
       auto out = reduce_array(
           ent_dim, as<Real>(tagbase)->array(), tagbase->ncomps(), op);
@@ -883,6 +1231,95 @@ void Mesh::reduce_tag(Int ent_dim, std::string const& name, Omega_h_Op op) {
   }
 }
 
+std::vector<AnyArray> Mesh::sync_arrays(
+    Int ent_dim, std::vector<AnyArray> const& arrays) {
+  OMEGA_H_TIME_FUNCTION;
+  if (!could_be_shared(ent_dim) || arrays.empty()) return arrays;
+  auto const layout = get_packed_layout(arrays);
+  auto const packed = pack_arrays(nents(ent_dim), arrays, layout);
+  auto& plan = ask_exch_plan<I64>(ent_dim, layout.nwords, true);
+  return unpack_arrays(plan.exch(packed), layout);
+}
+
+std::vector<AnyArray> Mesh::reduce_arrays(
+    Int ent_dim, std::vector<AnyArray> const& arrays, Omega_h_Op op) {
+  OMEGA_H_TIME_FUNCTION;
+  if (!could_be_shared(ent_dim) || arrays.empty()) return arrays;
+  auto const layout = get_packed_layout(arrays);
+  auto const packed = pack_arrays(nents(ent_dim), arrays, layout);
+  auto& plan = ask_exch_plan<I64>(ent_dim, layout.nwords, false);
+  auto const owners2items = ask_dist(ent_dim).invert().roots2items();
+  auto item_arrays = unpack_arrays(plan.exch(packed), layout);
+  std::vector<AnyArray> out;
+  for (auto const& item_array : item_arrays) {
+    auto f = [&](auto type) {
+      using T = decltype(type);
+      auto const ncomps = item_array.ncomps();
+      out.push_back(AnyArray(
+          fan_reduce(owners2items, item_array.get<T>(), ncomps, op), ncomps));
+    };
+    apply_to_omega_h_types(item_array.type(), std::move(f));
+  }
+  return out;
+}
+
+ArraysFuture Mesh::isync_arrays(Int ent_dim,
+    std::vector<AnyArray> const& arrays,
+    ArraysFuture::callback_type callback) {
+  auto const layout = get_packed_layout(arrays);
+  auto const packed = pack_arrays(nents(ent_dim), arrays, layout);
+  if (!could_be_shared(ent_dim) || arrays.empty()) {
+    return ArraysFuture(Future<I64>(packed), layout, std::move(callback));
+  }
+  auto future = ask_dist(ent_dim).invert().iexch(packed, layout.nwords);
+  return ArraysFuture(std::move(future), layout, std::move(callback));
+}
+
+static std::vector<AnyArray> get_tag_arrays(
+    Mesh* mesh, Int dim, std::vector<std::string> const& names) {
+  std::vector<AnyArray> arrays;
+  for (auto const& name : names) {
+    auto const tagbase = mesh->get_tagbase(dim, name);
+    auto f = [&](auto type) {
+      using T = decltype(type);
+      arrays.push_back(AnyArray(as<T>(tagbase)->array(), tagbase->ncomps()));
+    };
+    apply_to_omega_h_types(tagbase->type(), std::move(f));
+  }
+  return arrays;
+}
+
+static void set_tag_arrays(Mesh* mesh, Int dim,
+    std::vector<std::string> const& names,
+    std::vector<AnyArray> const& arrays) {
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    auto f = [&](auto type) {
+      using T = decltype(type);
+      mesh->set_tag(dim, names[i], arrays[i].get<T>());
+    };
+    apply_to_omega_h_types(arrays[i].type(), std::move(f));
+  }
+}
+
+void Mesh::sync_tags(Int ent_dim, std::vector<std::string> const& names) {
+  auto const arrays = get_tag_arrays(this, ent_dim, names);
+  set_tag_arrays(this, ent_dim, names, sync_arrays(ent_dim, arrays));
+}
+
+void Mesh::reduce_tags(
+    Int ent_dim, std::vector<std::string> const& names, Omega_h_Op op) {
+  auto const arrays = get_tag_arrays(this, ent_dim, names);
+  set_tag_arrays(this, ent_dim, names, reduce_arrays(ent_dim, arrays, op));
+}
+
+ArraysFuture Mesh::isync_tags(
+    Int ent_dim, std::vector<std::string> const& names) {
+  auto callback = [this, ent_dim, names](std::vector<AnyArray> const& out) {
+    set_tag_arrays(this, ent_dim, names, out);
+  };
+  return isync_arrays(ent_dim, get_tag_arrays(this, ent_dim, names), callback);
+}
+
 bool Mesh::operator==(Mesh& other) {
   auto opts = MeshCompareOpts::init(this, VarCompareOpts::zero_tolerance());
   return OMEGA_H_SAME == compare_meshes(this, &other, opts, false);
@@ -921,6 +1358,8 @@ Mesh Mesh::copy_meta() const {
   m.nghost_layers_ = this->nghost_layers_;
   m.rib_hints_ = this->rib_hints_;
   m.class_sets = this->class_sets;
+  m.cache_budget_ = this->cache_budget_;
+  m.cold_tag_period_ = this->cold_tag_period_;
   if (this->matched_ > 0) {
     m.matched_ = this->matched_;
     for (LO d = 0; d<DIMS; ++d) {
@@ -1019,30 +1458,42 @@ Real repro_sum_owned(Mesh* mesh, Int ent_dim, Reals a) {
   return repro_sum(mesh->comm(), mesh->owned_array(ent_dim, a, 1));
 }
 
-Reals average_field(Mesh* mesh, Int ent_dim, LOs a2e, Int ncomps, Reals v2x) {
+/* sums are always accumulated in double precision */
+template <typename T>
+static Read<T> average_field_tmpl(
+    Mesh* mesh, Int ent_dim, LOs a2e, Int ncomps, Read<T> v2x) {
   OMEGA_H_TIME_FUNCTION;
   OMEGA_H_CHECK(v2x.size() % ncomps == 0);
   if (ent_dim == 0) return unmap(a2e, v2x, ncomps);
   auto ev2v = mesh->ask_verts_of(ent_dim);
   auto degree = element_degree(mesh->family(), ent_dim, VERT);
   auto na = a2e.size();
-  Write<Real> out(na * ncomps);
+  Write<T> out(na * ncomps);
   auto f = OMEGA_H_LAMBDA(LO a) {
     auto e = a2e[a];
     for (Int j = 0; j < ncomps; ++j) {
       Real comp = 0;
       for (Int k = 0; k < degree; ++k) {
         auto v = ev2v[e * degree + k];
-        comp += v2x[v * ncomps + j];
+        comp += Real(v2x[v * ncomps + j]);
       }
       comp /= degree;
-      out[a * ncomps + j] = comp;
+      out[a * ncomps + j] = static_cast<T>(comp);
     }
   };
   parallel_for(na, f, "average_field");
   return out;
 }
 
+Reals average_field(Mesh* mesh, Int ent_dim, LOs a2e, Int ncomps, Reals v2x) {
+  return average_field_tmpl(mesh, ent_dim, a2e, ncomps, v2x);
+}
+
+Read<F32> average_field(
+    Mesh* mesh, Int ent_dim, LOs a2e, Int ncomps, Read<F32> v2x) {
+  return average_field_tmpl(mesh, ent_dim, a2e, ncomps, v2x);
+}
+
 Reals average_field(Mesh* mesh, Int ent_dim, Int ncomps, Reals v2x) {
   auto a2e = LOs(mesh->nents(ent_dim), 0, 1);
   return average_field(mesh, ent_dim, a2e, ncomps, v2x);
@@ -1121,8 +1572,14 @@ void assign(Mesh& a, Mesh const& b) {
       Read<T> array, bool internal, ArrayType array_type);                     \
   template void Mesh::set_tag(Int dim, std::string const& name,                \
       Read<T> array, bool internal, ArrayType array_type);                     \
+  template void Mesh::add_segmented_tag(Int dim, std::string const& name,      \
+      Int ncomps, std::vector<TagSegment<T>> segments, ArrayType array_type);  \
+  template ExchPlan<T>& Mesh::ask_exch_plan(                                   \
+      Int ent_dim, Int width, bool is_sync);                                   \
   template Read<T> Mesh::sync_array(Int ent_dim, Read<T> a, Int width);        \
   template Future<T> Mesh::isync_array(Int ent_dim, Read<T> a, Int width);     \
+  template Future<T> Mesh::isync_part_boundary(                                \
+      Int ent_dim, Write<T> a, Int width);                                     \
   template Read<T> Mesh::owned_array(Int ent_dim, Read<T> a, Int width);       \
   template Read<T> Mesh::sync_subset_array(                                    \
       Int ent_dim, Read<T> a_data, LOs a2e, T default_val, Int width);         \
@@ -1133,6 +1590,7 @@ void assign(Mesh& a, Mesh const& b) {
 OMEGA_H_INST(I8)
 OMEGA_H_INST(I32)
 OMEGA_H_INST(I64)
+OMEGA_H_INST(F32)
 OMEGA_H_INST(Real)
 #undef OMEGA_H_INST
 
@@ -3,8 +3,10 @@
 
 #include <Omega_h_adj.hpp>
 #include <Omega_h_comm.hpp>
+#include <Omega_h_compressed_graph.hpp>
 #include <Omega_h_dist.hpp>
 #include <Omega_h_library.hpp>
+#include <Omega_h_pack.hpp>
 #include <Omega_h_tag.hpp>
 #include <array>
 #include <map>
@@ -18,6 +20,8 @@ namespace inertia {
 struct Rib;
 }
 
+struct StructuredBox;
+
 struct ClassPair {
   inline ClassPair() = default;
   inline ClassPair(Int t_dim, LO t_id) : dim(t_dim), id(t_id) {}
@@ -70,6 +74,12 @@ class Mesh {
   template <typename T>
   void set_tag(
       Int dim, std::string const& name, Read<T> array, bool internal = false, ArrayType array_type = ArrayType::VectorND);
+  /* add_tag(..., internal=true) with the array given as slices of other
+     arrays, see Tag<T>::set_segments */
+  template <typename T>
+  void add_segmented_tag(Int dim, std::string const& name, Int ncomps,
+      std::vector<TagSegment<T>> segments,
+      ArrayType array_type = ArrayType::VectorND);
   TagBase const* get_tagbase(Int dim, std::string const& name) const;
   template <typename T>
   Tag<T> const* get_tag(Int dim, std::string const& name) const;
@@ -87,8 +97,47 @@ class Mesh {
   LOs ask_verts_of(Int dim);
   LOs ask_elem_verts();
   Adj ask_up(Int from, Int to);
+  /* stores an upward adjacency computed elsewhere (see update_up())
+     as if ask_up() had derived it */
+  void add_up(Int from, Int to, Adj up);
   Graph ask_star(Int dim);
   Graph ask_dual();
+  /* the star of ent_dim (the dual graph for dim()) with its targets
+     stored as bytes, see Omega_h_compressed_graph.hpp. it is cached
+     separately from ask_star(), and the uncompressed star is only kept
+     if it was cached already */
+  CompressedGraph ask_compressed_star(Int ent_dim);
+  /* once derived adjacencies (including stars, compressed stars and the
+     dual graph) and the cached "length", "quality" and "size" tags take
+     more than this many bytes, the least recently used ones are dropped
+     and derived again when next asked for. zero, the default, means no limit */
+  void set_cache_budget(std::size_t bytes);
+  std::size_t cache_budget() const;
+  std::size_t cache_bytes() const;
+  /* every `period` tag lookups, tags whose array was not read since the
+     previous sweep are compressed in memory (see Tag<T>::compress) and
+     decompressed again on their next read. zero, the default, disables it.
+     the sweep runs from get_tagbase() and friends, which are const because
+     compression only changes how a tag stores its values; the tag being
+     looked up is never compressed by its own lookup */
+  void set_cold_tag_compression(Int period);
+  void compress_cold_tags(TagBase const* keep = nullptr) const;
+  /* makes this a structured box mesh (see Omega_h_structured.hpp).
+     it must be a hypercube mesh of the box's dimension without entities
+     yet; every dimension gets the box's number of entities.
+     a structured mesh stores no downward or upward adjacency arrays:
+     ask_down and ask_up compute them from (i,j,k) formulas on every
+     call, and adjacencies stored with add_adj take precedence.
+     stars and the dual graph are derived from those once and cached as
+     on any other mesh.
+     meshes that modification, reordering or migration derive from it
+     are built from those arrays and are ordinary unstructured meshes */
+  void set_structured(StructuredBox const& box);
+  bool is_structured() const;
+  /* nullptr unless is_structured() */
+  StructuredBox const* structured() const;
+  /* stores the downward adjacencies as arrays and forgets the formulas */
+  void materialize_structured();
 
   /** ask_revClass (Int edim, LOs class_ids): takes input of entity dimension
    * 'edim', and an 1d array of model entity IDs to return
@@ -169,21 +218,26 @@ class Mesh {
       std::string const& name, Read<T> array);
   friend class ScopedChangeRCFieldsToMesh;
 
-  #if defined(OMEGA_H_USE_KOKKOS)
   /**
    * \brief form a patch of at least minPatchSize elements surrounding each mesh
    *        vertex
-   * \remark the patch is expanded via 2nd order adjacencies using meshDim-1 as
-   *         the bridge entity (e.g., faces for 3d, edges for 2d)
-   * \param m (in) mesh of simplices
+   * \remark the patch is expanded via 2nd order adjacencies, by default
+   *         the ones of ask_adj(tgtDim, tgtDim): meshDim-1 is the bridge
+   *         entity for elements (e.g., faces for 3d, edges for 2d)
    * \param minPatchSize (in) the minimum number of elements in each patch
+   * \param tgtDim (in) dimension of the patch entities, meshDim by default
+   * \param bridgeDim (in) dimension of the bridge entities, see
+   *        get_bridge_graph() in Omega_h_patches.hpp
    * \return a graph whose source nodes are mesh vertices, and
    *         edges are connecting to elements in the patch 
    *         OR
    *         an empty graph upon failure
+   * \details the result is cached like derived adjacencies, one per
+   *          (tgtDim, bridgeDim) pair; meshes built by modification
+   *          start without it
    */
-  [[nodiscard]] Graph get_vtx_patches(Int minPatchSize, Int tgtDim = -1);
-  #endif
+  [[nodiscard]] Graph get_vtx_patches(
+      Int minPatchSize, Int tgtDim = -1, Int bridgeDim = -1);
 
 
  private:
@@ -246,6 +300,26 @@ class Mesh {
   Adj derive_adj(Int from, Int to);
   Adj ask_adj(Int from, Int to);
   void react_to_set_tag(Int dim, std::string const& name);
+  struct CacheEntry {
+    /* tag_name is empty for an adjacency, COMPRESSED_STAR for a
+       compressed star (from == to) and VTX_PATCHES for vertex patches
+       (from is the target dimension and to the bridge dimension) */
+    Int from;
+    Int to;
+    std::string tag_name;
+    std::uint64_t last_use;
+  };
+  /* cache entry names that no tag can have */
+  static constexpr char const* COMPRESSED_STAR = " compressed star";
+  static constexpr char const* VTX_PATCHES = " vertex patches";
+  void touch_cached(Int from, Int to, std::string const& tag_name);
+  std::size_t cached_bytes(CacheEntry const& entry) const;
+  void enforce_cache_budget();
+  std::vector<CacheEntry> cache_entries_;
+  std::uint64_t cache_clock_;
+  std::size_t cache_budget_;
+  Int cold_tag_period_;
+  mutable Int tag_lookups_;
   Omega_h_Family family_;
   I8 matched_ = -1;
   CommPtr comm_;
@@ -256,8 +330,24 @@ class Mesh {
   // rc field tags stored in "rc" format
   TagVector rc_field_tags_[DIMS];
   AdjPtr adjs_[DIMS][DIMS];
+  std::shared_ptr<CompressedGraph const> compressed_stars_[DIMS];
+  struct PatchCache {
+    Int min_size;
+    Graph graph;
+  };
+  std::shared_ptr<PatchCache const> vtx_patches_[DIMS][DIMS];
+  std::shared_ptr<StructuredBox const> structured_;
   Remotes owners_[DIMS];
   DistPtr dists_[DIMS];
+  /* persistent exchanges of sync_array() and reduce_array(), per type
+     and width, valid as long as dists_ holds the Dist they came from */
+  struct ExchPlans;
+  std::shared_ptr<ExchPlans> exch_plans_[DIMS];
+  /* the split of owned entities by isync_part_boundary(), valid as long
+     as dists_ holds the Dist it came from */
+  struct PartSplit;
+  std::shared_ptr<PartSplit> part_splits_[DIMS];
+  PartSplit const& ask_part_split(Int dim);
   RibPtr rib_hints_;
   ParentPtr parents_[DIMS];
   ChildrenPtr children_[DIMS][DIMS];
@@ -291,6 +381,8 @@ protected:
   Remotes ask_owners(Int dim);
   Read<I8> owned(Int dim);
   Dist ask_dist(Int dim);
+  template <typename T>
+  ExchPlan<T>& ask_exch_plan(Int dim, Int width, bool is_sync);
   Int nghost_layers() const;
   void set_parting(Omega_h_Parting parting_in, Int nlayers, bool verbose);
   void set_parting(Omega_h_Parting parting_in, bool verbose = false);
@@ -310,6 +402,17 @@ protected:
   Read<T> sync_array(Int ent_dim, Read<T> a, Int width);
   template <typename T>
   Future<T> isync_array(Int ent_dim, Read<T> a, Int width);
+  /* the owned entities that other ranks have copies of, and the rest.
+     a loop that ends in a sync can compute the part boundary, start
+     isync_part_boundary() and compute the part interior while the
+     messages are in flight */
+  LOs ask_part_boundary(Int dim);
+  LOs ask_part_interior(Int dim);
+  /* like isync_array(), but only the part boundary entries of a need to
+     be set when it is called. get() writes the values of the owners
+     into the entries of the copies of a, and returns a */
+  template <typename T>
+  Future<T> isync_part_boundary(Int ent_dim, Write<T> a, Int width);
   template <typename T>
   Read<T> sync_subset_array(
       Int ent_dim, Read<T> a_data, LOs a2e, T default_val, Int width);
@@ -322,6 +425,20 @@ protected:
       Int ent_dim, Read<T> a_data, LOs a2e, T default_val, Int width);
   void sync_tag(Int dim, std::string const& name);
   void reduce_tag(Int dim, std::string const& name, Omega_h_Op op);
+  /* sync_array(), reduce_array() and isync_array() of several arrays
+     of any types and widths, packed into one message per neighbor */
+  std::vector<AnyArray> sync_arrays(
+      Int ent_dim, std::vector<AnyArray> const& arrays);
+  std::vector<AnyArray> reduce_arrays(
+      Int ent_dim, std::vector<AnyArray> const& arrays, Omega_h_Op op);
+  ArraysFuture isync_arrays(Int ent_dim, std::vector<AnyArray> const& arrays,
+      ArraysFuture::callback_type callback = ArraysFuture::callback_type());
+  /* likewise for tags. the tags of isync_tags() are set by the
+     ArraysFuture::get() of its result, the mesh must still exist then */
+  void sync_tags(Int dim, std::vector<std::string> const& names);
+  void reduce_tags(
+      Int dim, std::vector<std::string> const& names, Omega_h_Op op);
+  ArraysFuture isync_tags(Int dim, std::vector<std::string> const& names);
   bool operator==(Mesh& other);
   Real min_quality();
   Real max_length();
@@ -391,6 +508,8 @@ bool can_print(Mesh* mesh);
 Real repro_sum_owned(Mesh* mesh, Int dim, Reals a);
 
 Reals average_field(Mesh* mesh, Int dim, LOs a2e, Int ncomps, Reals v2x);
+Read<F32> average_field(
+    Mesh* mesh, Int dim, LOs a2e, Int ncomps, Read<F32> v2x);
 Reals average_field(Mesh* mesh, Int dim, Int ncomps, Reals v2x);
 
 using TagSet = std::array<std::set<std::string>, DIMS>;
@@ -425,9 +544,16 @@ void assign(Mesh& a, Mesh const& b);
       Int ncomps, Read<T> array, bool internal, ArrayType array_type);         \
   extern template void Mesh::set_tag(Int dim, std::string const& name,         \
       Read<T> array, bool internal, ArrayType array_type);                     \
+  extern template void Mesh::add_segmented_tag(Int dim,                        \
+      std::string const& name, Int ncomps,                                     \
+      std::vector<TagSegment<T>> segments, ArrayType array_type);              \
+  extern template ExchPlan<T>& Mesh::ask_exch_plan(                            \
+      Int ent_dim, Int width, bool is_sync);                                   \
   extern template Read<T> Mesh::sync_array(Int ent_dim, Read<T> a, Int width); \
   extern template Future<T> Mesh::isync_array(                                 \
       Int ent_dim, Read<T> a, Int width);                                      \
+  extern template Future<T> Mesh::isync_part_boundary(                         \
+      Int ent_dim, Write<T> a, Int width);                                     \
   extern template Read<T> Mesh::owned_array(                                   \
       Int ent_dim, Read<T> a, Int width);                                      \
   extern template Read<T> Mesh::sync_subset_array(                             \
@@ -465,6 +591,7 @@ void assign(Mesh& a, Mesh const& b);
 OMEGA_H_EXPL_INST_DECL(I8)
 OMEGA_H_EXPL_INST_DECL(I32)
 OMEGA_H_EXPL_INST_DECL(I64)
+OMEGA_H_EXPL_INST_DECL(F32)
 OMEGA_H_EXPL_INST_DECL(Real)
 #undef OMEGA_H_EXPL_INST_DECL
 
@@ -6,12 +6,14 @@
 #include "Omega_h_confined.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_host_few.hpp"
+#include "Omega_h_int_scan.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mark.hpp"
 #include "Omega_h_metric_intersect.hpp"
 #include "Omega_h_recover.hpp"
 #include "Omega_h_shape.hpp"
 #include "Omega_h_simplex.hpp"
+#include "Omega_h_sort.hpp"
 #include "Omega_h_surface.hpp"
 
 namespace Omega_h {
@@ -152,32 +154,56 @@ Reals delinearize_metrics(LO nmetrics, Reals linear_metrics) {
 
 /* gradation limiting code: */
 
+/* the metric of vertex v intersected with the limits its neighbors
+   put on it */
+template <Int mesh_dim, Int metric_dim>
+OMEGA_H_DEVICE Matrix<metric_dim, metric_dim> limit_gradation_at(
+    CompressedGraph const& v2v, Reals const& coords, Reals const& values,
+    Real max_rate, LO v) {
+  auto m = get_symm<metric_dim>(values, v);
+  auto x = get_vector<mesh_dim>(coords, v);
+  CompressedRow row(v2v, v);
+  for (auto vv = v2v.a2ab[v]; vv < v2v.a2ab[v + 1]; ++vv) {
+    auto av = row.next();
+    auto am = get_symm<metric_dim>(values, av);
+    auto ax = get_vector<mesh_dim>(coords, av);
+    auto vec = ax - x;
+    auto metric_dist = metric_length(am, vec);
+    auto factor = metric_eigenvalue_from_length(1.0 + metric_dist * max_rate);
+    auto limiter = am * factor;
+    auto limited = intersect_metrics(m, limiter);
+    m = limited;
+  }
+  return m;
+}
+
+template <Int mesh_dim, Int metric_dim>
+static void limit_gradation_into(CompressedGraph v2v, Reals coords, Reals values,
+    Real max_rate, LOs verts, Write<Real> out) {
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto const v = verts[i];
+    set_symm(out, v,
+        limit_gradation_at<mesh_dim, metric_dim>(
+            v2v, coords, values, max_rate, v));
+  };
+  parallel_for(verts.size(), f, "limit_metric_gradation");
+}
+
 template <Int mesh_dim, Int metric_dim>
 Reals limit_gradation_once_tmpl(
     Mesh* mesh, Reals values, Real max_rate) {
-  auto v2v = mesh->ask_star(VERT);
+  auto v2v = mesh->ask_compressed_star(VERT);
   auto coords = mesh->coords();
-  auto out = Write<Real>(mesh->nverts() * symm_ncomps(metric_dim));
-  auto f = OMEGA_H_LAMBDA(LO v) {
-    auto m = get_symm<metric_dim>(values, v);
-    auto x = get_vector<mesh_dim>(coords, v);
-    for (auto vv = v2v.a2ab[v]; vv < v2v.a2ab[v + 1]; ++vv) {
-      auto av = v2v.ab2b[vv];
-      auto am = get_symm<metric_dim>(values, av);
-      auto ax = get_vector<mesh_dim>(coords, av);
-      auto vec = ax - x;
-      auto metric_dist = metric_length(am, vec);
-      auto factor = metric_eigenvalue_from_length(1.0 + metric_dist * max_rate);
-      auto limiter = am * factor;
-      auto limited = intersect_metrics(m, limiter);
-      m = limited;
-    }
-    set_symm(out, v, m);
-  };
-  parallel_for(mesh->nverts(), f, "limit_metric_gradation");
-  values = Reals(out);
-  values = mesh->sync_array(VERT, values, symm_ncomps(metric_dim));
-  return values;
+  auto ncomps = symm_ncomps(metric_dim);
+  auto out = Write<Real>(mesh->nverts() * ncomps);
+  /* the copies only need the part boundary, the part interior is
+     limited while it travels */
+  limit_gradation_into<mesh_dim, metric_dim>(
+      v2v, coords, values, max_rate, mesh->ask_part_boundary(VERT), out);
+  auto future = mesh->isync_part_boundary(VERT, out, ncomps);
+  limit_gradation_into<mesh_dim, metric_dim>(
+      v2v, coords, values, max_rate, mesh->ask_part_interior(VERT), out);
+  return future.get();
 }
 
 static Reals limit_gradation_once(Mesh* mesh, Reals values, Real max_rate) {
@@ -218,6 +244,176 @@ Reals limit_metric_gradation(
   return values2;
 }
 
+template <Int mesh_dim, Int metric_dim>
+static Reals limit_gradation_at_tmpl(
+    Mesh* mesh, Reals values, Real max_rate, LOs work2verts) {
+  auto v2v = mesh->ask_compressed_star(VERT);
+  auto coords = mesh->coords();
+  auto out = Write<Real>(work2verts.size() * symm_ncomps(metric_dim));
+  auto f = OMEGA_H_LAMBDA(LO work) {
+    set_symm(out, work,
+        limit_gradation_at<mesh_dim, metric_dim>(
+            v2v, coords, values, max_rate, work2verts[work]));
+  };
+  parallel_for(work2verts.size(), f, "limit_metric_gradation(worklist)");
+  return out;
+}
+
+/* the limited metrics of the given vertices, without syncing */
+static Reals limit_gradation_at(
+    Mesh* mesh, Reals values, Real max_rate, LOs work2verts) {
+  auto metric_dim = get_metrics_dim(mesh->nverts(), values);
+  if (mesh->dim() == 3 && metric_dim == 3) {
+    return limit_gradation_at_tmpl<3, 3>(mesh, values, max_rate, work2verts);
+  } else if (mesh->dim() == 2 && metric_dim == 2) {
+    return limit_gradation_at_tmpl<2, 2>(mesh, values, max_rate, work2verts);
+  } else if (mesh->dim() == 3 && metric_dim == 1) {
+    return limit_gradation_at_tmpl<3, 1>(mesh, values, max_rate, work2verts);
+  } else if (mesh->dim() == 2 && metric_dim == 1) {
+    return limit_gradation_at_tmpl<2, 1>(mesh, values, max_rate, work2verts);
+  } else if (mesh->dim() == 1) {
+    return limit_gradation_at_tmpl<1, 1>(mesh, values, max_rate, work2verts);
+  }
+  OMEGA_H_NORETURN(Reals());
+}
+
+/* the vertices this rank shares with others, and a Dist from their
+   owners to all their copies that moves only their values */
+struct SharedVerts {
+  LOs shared2verts;
+  Dist owners2shared;
+};
+
+static SharedVerts get_shared_verts(Mesh* mesh) {
+  auto const owned = mesh->owned(VERT);
+  auto const nverts = mesh->nverts();
+  auto const are_copies = invert_marks(owned);
+  /* owners learn that they have copies elsewhere */
+  auto const have_copies = mesh->reduce_array(VERT, are_copies, 1, OMEGA_H_MAX);
+  auto const are_shared = lor_each(are_copies, have_copies);
+  SharedVerts out;
+  out.shared2verts = collect_marked(are_shared);
+  auto const verts2shared =
+      invert_injective_map(out.shared2verts, nverts);
+  /* copies learn the index of their vertex among the owner's shared ones */
+  auto const owner_shared = mesh->sync_array(VERT, verts2shared, 1);
+  auto const owners = mesh->ask_owners(VERT);
+  Remotes shared2owners;
+  shared2owners.ranks = unmap(out.shared2verts, owners.ranks, 1);
+  shared2owners.idxs = unmap(out.shared2verts, owner_shared, 1);
+  out.owners2shared =
+      Dist(mesh->comm(), shared2owners, out.shared2verts.size()).invert();
+  return out;
+}
+
+/* marks the entries whose metric is not close to before */
+static Read<I8> mark_changed(Reals before, Reals after, Int ncomps, Real tol) {
+  auto n = divide_no_remainder(before.size(), ncomps);
+  Write<I8> changed(n);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    I8 is_changed = 0;
+    for (Int c = 0; c < ncomps; ++c) {
+      if (!are_close(before[i * ncomps + c], after[i * ncomps + c], tol)) {
+        is_changed = 1;
+      }
+    }
+    changed[i] = is_changed;
+  };
+  parallel_for(n, f, "mark_changed");
+  return changed;
+}
+
+/* the distinct neighbors of the given vertices, in increasing order */
+static LOs get_neighbors(CompressedGraph v2v, LOs verts) {
+  auto const n = verts.size();
+  Write<LO> degrees(n);
+  auto count = OMEGA_H_LAMBDA(LO i) {
+    auto const v = verts[i];
+    degrees[i] = v2v.a2ab[v + 1] - v2v.a2ab[v];
+  };
+  parallel_for(n, count, "get_neighbors(count)");
+  auto const offsets = offset_scan(read(degrees));
+  Write<LO> dups(offsets.last());
+  auto fill = OMEGA_H_LAMBDA(LO i) {
+    auto const v = verts[i];
+    CompressedRow row(v2v, v);
+    auto j = offsets[i];
+    for (auto vv = v2v.a2ab[v]; vv < v2v.a2ab[v + 1]; ++vv) {
+      dups[j++] = row.next();
+    }
+  };
+  parallel_for(n, fill, "get_neighbors(fill)");
+  auto const sorted = read(unmap(sort_by_keys(read(dups)), read(dups), 1));
+  Write<I8> are_first(sorted.size());
+  auto first = OMEGA_H_LAMBDA(LO i) {
+    are_first[i] = (i == 0 || sorted[i] != sorted[i - 1]);
+  };
+  parallel_for(sorted.size(), first, "get_neighbors(unique)");
+  return unmap(collect_marked(read(are_first)), sorted, 1);
+}
+
+Reals limit_metric_gradation_worklist(
+    Mesh* mesh, Reals values, Real max_rate, Real tol, bool verbose) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(mesh->owners_have_all_upward(VERT));
+  OMEGA_H_CHECK(max_rate > 0.0);
+  auto const comm = mesh->comm();
+  auto const nverts = mesh->nverts();
+  auto const ncomps = divide_no_remainder(values.size(), nverts);
+  auto const v2v = mesh->ask_compressed_star(VERT);
+  auto const is_shared = mesh->could_be_shared(VERT);
+  SharedVerts shared;
+  if (is_shared) shared = get_shared_verts(mesh);
+  auto current = deep_copy(values);
+  auto work2verts = LOs(nverts, 0, 1);
+  Int i = 0;
+  GO nupdates = 0;
+  while (true) {
+    auto const before_work = unmap(work2verts, read(current), ncomps);
+    Reals before_shared;
+    if (is_shared) {
+      before_shared = unmap(shared.shared2verts, read(current), ncomps);
+    }
+    auto const limited =
+        limit_gradation_at(mesh, read(current), max_rate, work2verts);
+    map_into(limited, work2verts, current, ncomps);
+    nupdates += work2verts.size();
+    LOs changed_verts = unmap(
+        collect_marked(mark_changed(before_work, limited, ncomps, tol)),
+        work2verts, 1);
+    if (is_shared) {
+      /* only the shared vertices are exchanged, owners overwrite copies.
+         all of them are sent every step: a Dist of just the changed ones
+         would need a new graph communicator each step */
+      auto const owned_shared =
+          read(unmap(shared.shared2verts, read(current), ncomps));
+      auto const after_shared = shared.owners2shared.exch(owned_shared, ncomps);
+      map_into(after_shared, shared.shared2verts, current, ncomps);
+      LOs const changed_shared = unmap(
+          collect_marked(
+              mark_changed(before_shared, after_shared, ncomps, tol)),
+          shared.shared2verts, 1);
+      changed_verts = concat(changed_verts, changed_shared);
+    }
+    work2verts = get_neighbors(v2v, changed_verts);
+    ++i;
+    auto const nwork = comm->allreduce(GO(work2verts.size()), OMEGA_H_SUM);
+    if (nwork == 0) break;
+    if (verbose && can_print(mesh) && i % 50 == 0) {
+      std::cout << "warning: gradation limiting is up to step " << i << " ("
+                << nwork << " vertices left)\n";
+    }
+  }
+  if (verbose) {
+    nupdates = comm->allreduce(nupdates, OMEGA_H_SUM);
+    if (can_print(mesh)) {
+      std::cout << "limited gradation in " << i << " steps, " << nupdates
+                << " vertex updates\n";
+    }
+  }
+  return current;
+}
+
 template <Int metric_dim>
 Reals project_metrics_dim(Mesh* mesh, Reals e2m) {
   auto e_linear = linearize_metrics(mesh->nelems(), e2m);
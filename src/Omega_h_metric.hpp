@@ -218,6 +218,12 @@ Reals get_pure_implied_metrics(Mesh* mesh);
 Reals get_implied_metrics(Mesh* mesh);
 Reals limit_metric_gradation(Mesh* mesh, Reals values, Real max_rate,
     Real tol = 1e-2, bool verbose = false);
+/* the same limiting, which only revisits the vertices that have a
+   neighbor whose metric changed in the previous step and exchanges only
+   the metrics of vertices shared between ranks. it stops when no
+   vertex is left to revisit */
+Reals limit_metric_gradation_worklist(Mesh* mesh, Reals values,
+    Real max_rate, Real tol = 1e-2, bool verbose = false);
 Reals get_complexity_per_elem(Mesh* mesh, Reals v2m);
 Reals get_nelems_per_elem(Mesh* mesh, Reals v2m);
 Real get_complexity(Mesh* mesh, Reals v2m);
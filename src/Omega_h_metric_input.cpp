@@ -27,6 +27,7 @@ MetricInput::MetricInput() {
   should_limit_gradation = false;
   max_gradation_rate = 1.0;
   gradation_convergence_tolerance = 1e-3;
+  should_use_gradation_worklist = false;
   should_limit_element_count = false;
   max_element_count = 1e6;
   min_element_count = 1.0;
@@ -219,7 +220,11 @@ Reals generate_metrics(Mesh* mesh, MetricInput const& input) {
     for (Int i = 0; i < input.nsmoothing_steps; ++i) {
       metrics = smooth_metric_once(mesh, metrics);
     }
-    if (input.should_limit_gradation) {
+    if (input.should_limit_gradation && input.should_use_gradation_worklist) {
+      metrics = limit_metric_gradation_worklist(mesh, metrics,
+          input.max_gradation_rate, input.gradation_convergence_tolerance,
+          input.verbose);
+    } else if (input.should_limit_gradation) {
       metrics = limit_metric_gradation(mesh, metrics, input.max_gradation_rate,
           input.gradation_convergence_tolerance, input.verbose);
     }
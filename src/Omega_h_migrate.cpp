@@ -9,6 +9,7 @@
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
 #include "Omega_h_owners.hpp"
+#include "Omega_h_pack.hpp"
 
 namespace Omega_h {
 
@@ -98,14 +99,44 @@ LOs form_new_conn(Dist new_ents2old_owners, Dist old_owners2new_uses) {
   return serv_uses2new_uses.exch(LOs(serv_uses2new_idxs), 1);
 }
 
-void push_down(Mesh* old_mesh, Int ent_dim, Int low_dim,
-    Dist old_owners2new_ents, Adj& new_ents2new_lows,
-    Dist& old_low_owners2new_lows) {
+/* exchanges arrays over the roots of old_owners2new_ents packed into
+   one array, so that each pair of ranks shares a single message no
+   matter how many arrays there are. the layout of the packed records
+   follows from the types and numbers of components of the arrays, in
+   the order they were added, which every rank derives from the same
+   list of tags */
+static std::vector<AnyArray> push_arrays(
+    Dist old_owners2new_ents, std::vector<AnyArray> const& arrays) {
   OMEGA_H_TIME_FUNCTION;
+  if (arrays.empty()) return arrays;
+  auto const layout = get_packed_layout(arrays);
+  auto const packed =
+      pack_arrays(old_owners2new_ents.nroots(), arrays, layout);
+  return unpack_arrays(
+      old_owners2new_ents.exch(packed, layout.nwords), layout);
+}
+
+/* the owners of the (low_dim) entities used by each (ent_dim) entity
+   and, if the mesh has them, the codes of those uses */
+static void add_down_arrays(Mesh* old_mesh, Int ent_dim, Int low_dim,
+    std::vector<AnyArray>* arrays) {
   auto nlows_per_high = element_degree(old_mesh->family(), ent_dim, low_dim);
   auto old_use_owners = form_down_use_owners(old_mesh, ent_dim, low_dim);
+  arrays->push_back(AnyArray(old_use_owners.ranks, nlows_per_high));
+  arrays->push_back(AnyArray(old_use_owners.idxs, nlows_per_high));
+  auto old_codes = old_mesh->ask_down(ent_dim, low_dim).codes;
+  if (old_codes.exists()) {
+    arrays->push_back(AnyArray(old_codes, nlows_per_high));
+  }
+}
+
+/* the rest of push_down(), once the arrays of add_down_arrays()
+   have reached the new copies */
+static void set_pushed_down(Mesh* old_mesh, Int ent_dim, Int low_dim,
+    AnyArray const* new_arrays, Adj& new_ents2new_lows,
+    Dist& old_low_owners2new_lows) {
   auto new_use_owners =
-      old_owners2new_ents.exch(old_use_owners, nlows_per_high);
+      Remotes(new_arrays[0].get<I32>(), new_arrays[1].get<LO>());
   Dist low_uses2old_owners(
       old_mesh->comm(), new_use_owners, old_mesh->nents(low_dim));
   auto old_owner_globals = old_mesh->globals(low_dim);
@@ -115,18 +146,38 @@ void push_down(Mesh* old_mesh, Int ent_dim, Int low_dim,
   auto old_low_owners2new_uses = low_uses2old_owners.invert();
   auto new_conn = form_new_conn(new_lows2old_owners, old_low_owners2new_uses);
   new_ents2new_lows.ab2b = new_conn;
-  auto old_codes = old_mesh->ask_down(ent_dim, low_dim).codes;
-  if (old_codes.exists()) {
-    auto new_codes = old_owners2new_ents.exch(old_codes, nlows_per_high);
-    new_ents2new_lows.codes = new_codes;
+  if (old_mesh->ask_down(ent_dim, low_dim).codes.exists()) {
+    new_ents2new_lows.codes = new_arrays[2].get<I8>();
   }
 }
 
-void push_tags(Mesh *old_mesh, Mesh* new_mesh, Int ent_dim,
-    Dist old_owners2new_ents) {
+void push_down(Mesh* old_mesh, Int ent_dim, Int low_dim,
+    Dist old_owners2new_ents, Adj& new_ents2new_lows,
+    Dist& old_low_owners2new_lows) {
   OMEGA_H_TIME_FUNCTION;
-  OMEGA_H_CHECK(old_owners2new_ents.nroots() == old_mesh->nents(ent_dim));
-  ScopedChangeRCFieldsToMesh rc_to_mesh(*old_mesh);
+  std::vector<AnyArray> old_arrays;
+  add_down_arrays(old_mesh, ent_dim, low_dim, &old_arrays);
+  auto new_arrays = push_arrays(old_owners2new_ents, old_arrays);
+  set_pushed_down(old_mesh, ent_dim, low_dim, new_arrays.data(),
+      new_ents2new_lows, old_low_owners2new_lows);
+}
+
+/* all the tags of (ent_dim) entities, including their class ids and
+   global numbers, in the order of Mesh::get_tag() */
+static void add_tag_arrays(
+    Mesh* old_mesh, Int ent_dim, std::vector<AnyArray>* arrays) {
+  for (Int i = 0; i < old_mesh->ntags(ent_dim); ++i) {
+    auto tag = old_mesh->get_tag(ent_dim, i);
+    apply_to_omega_h_types(tag->type(), [&](auto t) {
+      using T = decltype(t);
+      auto array = old_mesh->get_array<T>(ent_dim, tag->name());
+      arrays->push_back(AnyArray(array, tag->ncomps()));
+    });
+  }
+}
+
+static void set_pushed_tags(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
+    bool rc_converted, AnyArray const* new_arrays) {
   for (Int i = 0; i < old_mesh->ntags(ent_dim); ++i) {
     auto tag = old_mesh->get_tag(ent_dim, i);
     auto const& name = tag->name();
@@ -134,10 +185,9 @@ void push_tags(Mesh *old_mesh, Mesh* new_mesh, Int ent_dim,
     const auto class_ids = tag->class_ids();
     apply_to_omega_h_types(tag->type(), [&](auto t){
       using T = decltype(t);
-      auto array = old_mesh->get_array<T>(ent_dim,name);
-      array = old_owners2new_ents.exch(array, ncomps);
+      auto array = new_arrays[i].get<T>();
 
-      if(is_rc_tag(name) && rc_to_mesh.did_conversion() ) {
+      if(is_rc_tag(name) && rc_converted ) {
         new_mesh->set_rc_from_mesh_array(ent_dim,ncomps,class_ids,name,array);
       }
       else {
@@ -149,26 +199,72 @@ void push_tags(Mesh *old_mesh, Mesh* new_mesh, Int ent_dim,
   }
 }
 
-void push_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
-    Dist new_ents2old_owners, Dist old_owners2new_ents, Omega_h_Parting mode) {
-  push_tags(old_mesh, new_mesh, ent_dim, old_owners2new_ents);
-  Read<I32> own_ranks;
-  /* if we are ghosting, each entity should remain owned by the
-   * same rank that owned it before ghosting, as this is the only
-   * mechanism we have to identify the ghost layers.
-   * if we are doing a vertex-based partitioning, at least the
-   * vertices ought to retain their original owners, for similar
-   * reasons.
-   */
-  if ((mode == OMEGA_H_GHOSTED) ||
-      ((mode == OMEGA_H_VERT_BASED) && (ent_dim == VERT))) {
+void push_tags(Mesh *old_mesh, Mesh* new_mesh, Int ent_dim,
+    Dist old_owners2new_ents) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(old_owners2new_ents.nroots() == old_mesh->nents(ent_dim));
+  ScopedChangeRCFieldsToMesh rc_to_mesh(*old_mesh);
+  std::vector<AnyArray> old_arrays;
+  add_tag_arrays(old_mesh, ent_dim, &old_arrays);
+  auto new_arrays = push_arrays(old_owners2new_ents, old_arrays);
+  set_pushed_tags(old_mesh, new_mesh, ent_dim, rc_to_mesh.did_conversion(),
+      new_arrays.data());
+}
+
+/* if we are ghosting, each entity should remain owned by the
+ * same rank that owned it before ghosting, as this is the only
+ * mechanism we have to identify the ghost layers.
+ * if we are doing a vertex-based partitioning, at least the
+ * vertices ought to retain their original owners, for similar
+ * reasons.
+ */
+static bool keeps_own_ranks(Int ent_dim, Omega_h_Parting mode) {
+  return (mode == OMEGA_H_GHOSTED) ||
+         ((mode == OMEGA_H_VERT_BASED) && (ent_dim == VERT));
+}
+
+/* push_ents(), preceded by push_down() to (ent_dim - 1) if
+   old_low_owners2new_lows is given, with one exchange for all the
+   arrays they send */
+static void push_ents_and_down(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
+    Dist new_ents2old_owners, Dist old_owners2new_ents, Omega_h_Parting mode,
+    Dist* old_low_owners2new_lows) {
+  OMEGA_H_CHECK(old_owners2new_ents.nroots() == old_mesh->nents(ent_dim));
+  ScopedChangeRCFieldsToMesh rc_to_mesh(*old_mesh);
+  std::vector<AnyArray> old_arrays;
+  if (old_low_owners2new_lows) {
+    add_down_arrays(old_mesh, ent_dim, ent_dim - 1, &old_arrays);
+  }
+  auto const first_tag = old_arrays.size();
+  add_tag_arrays(old_mesh, ent_dim, &old_arrays);
+  auto const own_ranks_array = old_arrays.size();
+  auto const keep_own_ranks = keeps_own_ranks(ent_dim, mode);
+  if (keep_own_ranks) {
     auto old_own_ranks = old_mesh->ask_owners(ent_dim).ranks;
-    own_ranks = old_owners2new_ents.exch(old_own_ranks, 1);
+    old_arrays.push_back(AnyArray(old_own_ranks, 1));
+  }
+  auto new_arrays = push_arrays(old_owners2new_ents, old_arrays);
+  if (old_low_owners2new_lows) {
+    Adj new_ents2new_lows;
+    set_pushed_down(old_mesh, ent_dim, ent_dim - 1, new_arrays.data(),
+        new_ents2new_lows, *old_low_owners2new_lows);
+    new_mesh->set_ents(ent_dim, new_ents2new_lows);
   }
+  set_pushed_tags(old_mesh, new_mesh, ent_dim, rc_to_mesh.did_conversion(),
+      new_arrays.data() + first_tag);
+  Read<I32> own_ranks;
+  if (keep_own_ranks) own_ranks = new_arrays[own_ranks_array].get<I32>();
   auto owners = update_ownership(new_ents2old_owners, own_ranks);
   new_mesh->set_owners(ent_dim, owners);
 }
 
+void push_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
+    Dist new_ents2old_owners, Dist old_owners2new_ents, Omega_h_Parting mode) {
+  OMEGA_H_TIME_FUNCTION;
+  push_ents_and_down(old_mesh, new_mesh, ent_dim, new_ents2old_owners,
+      old_owners2new_ents, mode, nullptr);
+}
+
 static void print_migrate_stats(CommPtr comm, Dist new_elems2old_owners) {
   auto msgs2ranks = new_elems2old_owners.msgs2ranks();
   auto msgs2content = new_elems2old_owners.msgs2content();
@@ -384,17 +480,12 @@ void migrate_mesh(
   auto comm = mesh->comm();
   auto dim = mesh->dim();
   if (verbose) print_migrate_stats(comm, new_elems2old_owners);
-  Dist new_ents2old_owners = new_elems2old_owners;
-  auto old_owners2new_ents = new_ents2old_owners.invert();
+  auto old_owners2new_ents = new_elems2old_owners.invert();
   for (Int d = dim; d > VERT; --d) {
-    Adj high2low;
     Dist old_low_owners2new_lows;
-    push_down(
-        mesh, d, d - 1, old_owners2new_ents, high2low, old_low_owners2new_lows);
-    new_mesh.set_ents(d, high2low);
-    new_ents2old_owners = old_owners2new_ents.invert();
-    push_ents(
-        mesh, &new_mesh, d, new_ents2old_owners, old_owners2new_ents, mode);
+    auto new_ents2old_owners = old_owners2new_ents.invert();
+    push_ents_and_down(mesh, &new_mesh, d, new_ents2old_owners,
+        old_owners2new_ents, mode, &old_low_owners2new_lows);
 
     if ((mesh->is_matched() > 0) && (d < dim)) {
       migrate_matches(mesh, &new_mesh, d, &old_owners2new_ents);
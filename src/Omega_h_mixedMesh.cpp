@@ -383,6 +383,7 @@ void get_all_type_tags(MixedMesh* mesh, Int dim, Topo_type ent_type, TagSet* tag
 OMEGA_H_INST(I8)
 OMEGA_H_INST(I32)
 OMEGA_H_INST(I64)
+OMEGA_H_INST(F32)
 OMEGA_H_INST(Real)
 #undef OMEGA_H_INST
 
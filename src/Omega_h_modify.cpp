@@ -17,9 +17,39 @@
 
 namespace Omega_h {
 
+/* carries the upward adjacencies to ent_dim that old_mesh has over to
+   new_mesh, so they are not derived again from scratch. the one from
+   vertices needs old_verts2new_verts unless ent_dim is EDGE */
+static void modify_up(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
+    Adj prods2new_lows, LOs prods2new_ents, LOs old_ents2new_ents,
+    LOs old_lows2new_lows, LOs old_verts2new_verts) {
+  if (old_mesh->is_structured()) return;
+  auto const family = old_mesh->family();
+  auto const low_dim = ent_dim - 1;
+  if (old_mesh->has_adj(low_dim, ent_dim)) {
+    auto const new_up = update_up(old_mesh->get_adj(low_dim, ent_dim),
+        old_lows2new_lows, new_mesh->nents(low_dim), old_ents2new_ents,
+        prods2new_lows, prods2new_ents,
+        element_degree(family, ent_dim, low_dim), ent_dim, low_dim);
+    new_mesh->add_up(low_dim, ent_dim, new_up);
+  }
+  if (low_dim > VERT && old_verts2new_verts.exists() &&
+      old_mesh->has_adj(VERT, ent_dim)) {
+    auto const verts_per_ent = element_degree(family, ent_dim, VERT);
+    auto const prod_verts2new_verts = unmap(
+        prods2new_ents, new_mesh->ask_verts_of(ent_dim), verts_per_ent);
+    auto const new_up = update_up(old_mesh->get_adj(VERT, ent_dim),
+        old_verts2new_verts, new_mesh->nverts(), old_ents2new_ents,
+        Adj(LOs(prod_verts2new_verts)), prods2new_ents, verts_per_ent,
+        ent_dim, VERT);
+    new_mesh->add_up(VERT, ent_dim, new_up);
+  }
+}
+
 static void modify_conn(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
     LOs prod_verts2verts, LOs prods2new_ents, LOs same_ents2old_ents,
-    LOs same_ents2new_ents, LOs old_lows2new_lows) {
+    LOs same_ents2new_ents, LOs old_ents2new_ents, LOs old_lows2new_lows,
+    LOs old_verts2new_verts) {
   OMEGA_H_TIME_FUNCTION;
   auto low_dim = ent_dim - 1;
   auto down_degree = element_degree(old_mesh->family(), ent_dim, low_dim);
@@ -67,6 +97,8 @@ static void modify_conn(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
   auto new_ents2new_lows =
       Adj(LOs(new_ent_lows2new_lows), Read<I8>(new_ent_low_codes));
   new_mesh->set_ents(ent_dim, new_ents2new_lows);
+  modify_up(old_mesh, new_mesh, ent_dim, prods2new_lows, prods2new_ents,
+      old_ents2new_ents, old_lows2new_lows, old_verts2new_verts);
 }
 
 /* this is the case of AMR-style refinement where
@@ -446,7 +478,7 @@ static void modify_globals(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
 void modify_ents_adapt(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim, Int key_dim,
     LOs keys2kds, LOs keys2prods, LOs prod_verts2verts, LOs old_lows2new_lows,
     LOs* p_prods2new_ents, LOs* p_same_ents2old_ents, LOs* p_same_ents2new_ents,
-    LOs* p_old_ents2new_ents) {
+    LOs* p_old_ents2new_ents, LOs old_verts2new_verts) {
   OMEGA_H_TIME_FUNCTION;
   Few<LOs, 4> mods2mds;
   Few<Bytes, 4> mds_are_mods;
@@ -462,14 +494,16 @@ void modify_ents_adapt(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim, Int key_dim,
   modify_ents(old_mesh, new_mesh, ent_dim, mods2mds, mds_are_mods, mods2prods,
       prod_verts2verts, old_lows2new_lows,
       /*keep_mods*/ false, /*mods_can_be_shared*/ false, p_prods2new_ents,
-      p_same_ents2old_ents, p_same_ents2new_ents, p_old_ents2new_ents);
+      p_same_ents2old_ents, p_same_ents2new_ents, p_old_ents2new_ents,
+      old_verts2new_verts);
 }
 
 void modify_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
     Few<LOs, 4> mods2mds, Few<Bytes, 4> mds_are_mods, Few<LOs, 4> mods2prods,
     LOs prod_verts2verts, LOs old_lows2new_lows, bool keep_mods,
     bool mods_can_be_shared, LOs* p_prods2new_ents, LOs* p_same_ents2old_ents,
-    LOs* p_same_ents2new_ents, LOs* p_old_ents2new_ents) {
+    LOs* p_same_ents2new_ents, LOs* p_old_ents2new_ents,
+    LOs old_verts2new_verts) {
   OMEGA_H_TIME_FUNCTION;
   *p_same_ents2old_ents =
       collect_same(old_mesh, ent_dim, mds_are_mods, keep_mods);
@@ -502,7 +536,7 @@ void modify_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
   } else {
     modify_conn(old_mesh, new_mesh, ent_dim, prod_verts2verts,
         *p_prods2new_ents, *p_same_ents2old_ents, *p_same_ents2new_ents,
-        old_lows2new_lows);
+        *p_old_ents2new_ents, old_lows2new_lows, old_verts2new_verts);
   }
   if (old_mesh->comm()->size() > 1) {
     modify_owners(old_mesh, new_mesh, ent_dim, mods2mds, mods2prods,
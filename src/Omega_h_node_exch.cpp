@@ -0,0 +1,241 @@
+#include "Omega_h_node_exch.hpp"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "Omega_h_arena.hpp"
+#include "Omega_h_map.hpp"
+#include "Omega_h_profile.hpp"
+
+namespace Omega_h {
+
+namespace {
+
+/* the items that one rank sends to another in a single message of the
+   graph communicator, wherever they are on their way */
+struct Segment {
+  I32 src;
+  I32 dst;
+  I32 dst_leader;
+  LO count;
+  /* of the first item, among those this rank holds at this stage */
+  LO offset;
+};
+
+enum { SEGMENT_WIDTH = 4 };
+
+template <typename T>
+Read<T> to_device(std::vector<T> const& v) {
+  HostWrite<T> h(LO(v.size()));
+  for (LO i = 0; i < h.size(); ++i) h[i] = v[std::size_t(i)];
+  return h.write();
+}
+
+struct Routed {
+  CommPtr comm;
+  LOs sends;
+  LOs sdispls;
+  LOs rdispls;
+  std::vector<Segment> segments;
+};
+
+/* sends each segment to rank dsts[i]. segments with the same
+   destination must be adjacent, and the destinations increasing.
+   this is a collective call over parent */
+Routed route(CommPtr parent, std::vector<Segment> const& segments,
+    std::vector<I32> const& dsts) {
+  std::vector<I32> msgs2ranks;
+  std::vector<LO> msgs2segments = {0};
+  std::vector<LO> sdispls = {0};
+  std::vector<LO> sends;
+  std::vector<I32> send_meta;
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    auto const& s = segments[i];
+    if (msgs2ranks.empty() || msgs2ranks.back() != dsts[i]) {
+      OMEGA_H_CHECK(msgs2ranks.empty() || msgs2ranks.back() < dsts[i]);
+      msgs2ranks.push_back(dsts[i]);
+      msgs2segments.push_back(msgs2segments.back());
+      sdispls.push_back(sdispls.back());
+    }
+    ++msgs2segments.back();
+    sdispls.back() += s.count;
+    for (LO j = 0; j < s.count; ++j) sends.push_back(s.offset + j);
+    send_meta.insert(send_meta.end(), {s.src, s.dst, s.dst_leader, s.count});
+  }
+  Routed out;
+  out.comm = parent->graph(to_device(msgs2ranks));
+  out.sends = to_device(sends);
+  out.sdispls = to_device(sdispls);
+  std::vector<LO> send_nsegments;
+  for (std::size_t i = 0; i + 1 < msgs2segments.size(); ++i) {
+    send_nsegments.push_back(msgs2segments[i + 1] - msgs2segments[i]);
+  }
+  auto const recv_nsegments =
+      HostRead<LO>(out.comm->alltoall(to_device(send_nsegments)));
+  std::vector<LO> recv_msgs2segments = {0};
+  for (LO i = 0; i < recv_nsegments.size(); ++i) {
+    recv_msgs2segments.push_back(
+        recv_msgs2segments.back() + recv_nsegments[i]);
+  }
+  auto const recv_meta = HostRead<I32>(
+      out.comm->alltoallv(to_device(send_meta), to_device(msgs2segments),
+          to_device(recv_msgs2segments), SEGMENT_WIDTH));
+  std::vector<LO> rdispls = {0};
+  LO offset = 0;
+  for (LO i = 0; i < recv_nsegments.size(); ++i) {
+    for (auto j = recv_msgs2segments[std::size_t(i)];
+         j < recv_msgs2segments[std::size_t(i + 1)]; ++j) {
+      Segment s;
+      s.src = recv_meta[j * SEGMENT_WIDTH + 0];
+      s.dst = recv_meta[j * SEGMENT_WIDTH + 1];
+      s.dst_leader = recv_meta[j * SEGMENT_WIDTH + 2];
+      s.count = recv_meta[j * SEGMENT_WIDTH + 3];
+      s.offset = offset;
+      offset += s.count;
+      out.segments.push_back(s);
+    }
+    rdispls.push_back(offset);
+  }
+  out.rdispls = to_device(rdispls);
+  return out;
+}
+
+}  // end anonymous namespace
+
+NodeExch::NodeExch(CommPtr parent, I32 leader, CommPtr graph,
+    CommPtr graph_inverse, LOs sdispls, LOs rdispls)
+    : parent_(parent),
+      leader_(leader),
+      graph_(graph),
+      graph_inverse_(graph_inverse),
+      sdispls_(sdispls),
+      rdispls_(rdispls) {}
+
+NodeExch::Plan const& NodeExch::ask_plan() const {
+  if (plan_) return *plan_;
+  OMEGA_H_TIME_FUNCTION;
+  /* the plan is kept as long as the Dist, past any arena */
+  ScopedNoArena no_arena;
+  std::unique_ptr<Plan> plan(new Plan);
+  auto const rank = parent_->rank();
+  auto const dsts = HostRead<I32>(graph_->destinations());
+  auto const srcs = HostRead<I32>(graph_->sources());
+  auto const dst_leaders = HostRead<I32>(graph_inverse_->allgather(leader_));
+  auto const src_leaders = HostRead<I32>(graph_->allgather(leader_));
+  auto const sdispls = HostRead<LO>(sdispls_);
+  auto const rdispls = HostRead<LO>(rdispls_);
+  plan->nrecvd = rdispls.last();
+  /* messages within the node go directly */
+  std::vector<I32> direct_dsts;
+  std::vector<LO> direct_sends;
+  std::vector<LO> direct_sdispls = {0};
+  std::vector<Segment> off_node;
+  for (LO i = 0; i < dsts.size(); ++i) {
+    auto const begin = sdispls[i];
+    auto const end = sdispls[i + 1];
+    if (dst_leaders[i] == leader_) {
+      direct_dsts.push_back(dsts[i]);
+      for (auto j = begin; j < end; ++j) direct_sends.push_back(j);
+      direct_sdispls.push_back(LO(direct_sends.size()));
+    } else {
+      off_node.push_back({rank, dsts[i], dst_leaders[i], end - begin, begin});
+    }
+  }
+  std::vector<I32> direct_srcs;
+  std::vector<LO> direct_recvs;
+  std::vector<LO> direct_rdispls = {0};
+  std::map<I32, LO> ranks2srcs;
+  for (LO i = 0; i < srcs.size(); ++i) {
+    ranks2srcs[srcs[i]] = i;
+    if (src_leaders[i] != leader_) continue;
+    direct_srcs.push_back(srcs[i]);
+    for (auto j = rdispls[i]; j < rdispls[i + 1]; ++j) {
+      direct_recvs.push_back(j);
+    }
+    direct_rdispls.push_back(LO(direct_recvs.size()));
+  }
+  plan->direct.comm =
+      parent_->graph_adjacent(to_device(direct_srcs), to_device(direct_dsts));
+  plan->direct.sends = to_device(direct_sends);
+  plan->direct.sdispls = to_device(direct_sdispls);
+  plan->direct.rdispls = to_device(direct_rdispls);
+  plan->direct_recvs = to_device(direct_recvs);
+  /* the leader gathers the rest of its node's messages */
+  auto gathered =
+      route(parent_, off_node, std::vector<I32>(off_node.size(), leader_));
+  plan->gather = {
+      gathered.comm, gathered.sends, gathered.sdispls, gathered.rdispls};
+  /* and sends one message to the leader of each node they go to */
+  auto by_node = gathered.segments;
+  std::stable_sort(by_node.begin(), by_node.end(),
+      [](Segment const& a, Segment const& b) {
+        return std::make_pair(a.dst_leader, a.dst) <
+               std::make_pair(b.dst_leader, b.dst);
+      });
+  std::vector<I32> dst_nodes;
+  for (auto const& s : by_node) dst_nodes.push_back(s.dst_leader);
+  auto crossed = route(parent_, by_node, dst_nodes);
+  plan->cross = {crossed.comm, crossed.sends, crossed.sdispls, crossed.rdispls};
+  /* which scatters them to the ranks of its node */
+  auto by_rank = crossed.segments;
+  std::stable_sort(by_rank.begin(), by_rank.end(),
+      [](Segment const& a, Segment const& b) {
+        return std::make_pair(a.dst, a.src) < std::make_pair(b.dst, b.src);
+      });
+  std::vector<I32> dst_ranks;
+  for (auto const& s : by_rank) dst_ranks.push_back(s.dst);
+  auto scattered = route(parent_, by_rank, dst_ranks);
+  plan->scatter = {
+      scattered.comm, scattered.sends, scattered.sdispls, scattered.rdispls};
+  std::vector<LO> scatter_recvs;
+  for (auto const& s : scattered.segments) {
+    OMEGA_H_CHECK(s.dst == rank);
+    auto const it = ranks2srcs.find(s.src);
+    OMEGA_H_CHECK(it != ranks2srcs.end());
+    auto const src = it->second;
+    OMEGA_H_CHECK(rdispls[src + 1] - rdispls[src] == s.count);
+    for (auto j = rdispls[src]; j < rdispls[src + 1]; ++j) {
+      scatter_recvs.push_back(j);
+    }
+  }
+  plan->scatter_recvs = to_device(scatter_recvs);
+  OMEGA_H_CHECK(
+      plan->direct_recvs.size() + plan->scatter_recvs.size() == plan->nrecvd);
+  plan_ = std::move(plan);
+  return *plan_;
+}
+
+template <typename T>
+Read<T> NodeExch::exch_stage(Stage const& stage, Read<T> data, Int width) {
+  return stage.comm->alltoallv(read(unmap(stage.sends, data, width)),
+      stage.sdispls, stage.rdispls, width);
+}
+
+template <typename T>
+Read<T> NodeExch::exch(Read<T> sendbuf, Int width) const {
+  auto const& plan = ask_plan();
+  OMEGA_H_TIME_FUNCTION;
+  /* the messages within the node travel while the leaders work */
+  auto direct = plan.direct.comm->ialltoallv(
+      read(unmap(plan.direct.sends, sendbuf, width)), plan.direct.sdispls,
+      plan.direct.rdispls, width);
+  auto const gathered = exch_stage(plan.gather, sendbuf, width);
+  auto const crossed = exch_stage(plan.cross, gathered, width);
+  auto const scattered = exch_stage(plan.scatter, crossed, width);
+  Write<T> recvbuf(plan.nrecvd * width);
+  map_into(scattered, plan.scatter_recvs, recvbuf, width);
+  map_into(direct.get(), plan.direct_recvs, recvbuf, width);
+  return recvbuf;
+}
+
+#define INST(T)                                                                \
+  template Read<T> NodeExch::exch(Read<T> sendbuf, Int width) const;
+INST(I8)
+INST(I32)
+INST(I64)
+INST(F32)
+INST(Real)
+#undef INST
+
+}  // end namespace Omega_h
@@ -0,0 +1,70 @@
+#ifndef OMEGA_H_NODE_EXCH_HPP
+#define OMEGA_H_NODE_EXCH_HPP
+
+#include <memory>
+
+#include <Omega_h_comm.hpp>
+
+namespace Omega_h {
+
+/* the alltoallv() of a graph communicator whose message sizes stay
+   fixed, done in two levels:
+   messages between ranks of the same node go directly.
+   messages to other nodes are gathered by the leader of the sending
+   node, sent as one message per pair of nodes to the leader of the
+   receiving node, and scattered by it.
+   exch() returns exactly what graph->alltoallv() would, so a Dist can
+   use either one. the stages are set up by the first exch(), which is
+   then a collective call over parent. leader is parent->node_leader() */
+class NodeExch {
+ public:
+  NodeExch(CommPtr parent, I32 leader, CommPtr graph, CommPtr graph_inverse,
+      LOs sdispls, LOs rdispls);
+  NodeExch(NodeExch const&) = delete;
+  NodeExch& operator=(NodeExch const&) = delete;
+  template <typename T>
+  Read<T> exch(Read<T> sendbuf, Int width) const;
+
+ private:
+  /* one alltoallv() of the items at the given positions of its input */
+  struct Stage {
+    CommPtr comm;
+    LOs sends;
+    LOs sdispls;
+    LOs rdispls;
+  };
+  struct Plan {
+    Stage direct;
+    Stage gather;
+    Stage cross;
+    Stage scatter;
+    /* where the items received directly and from the leader go among
+       those graph->alltoallv() receives */
+    LOs direct_recvs;
+    LOs scatter_recvs;
+    LO nrecvd;
+  };
+  template <typename T>
+  static Read<T> exch_stage(Stage const& stage, Read<T> data, Int width);
+  Plan const& ask_plan() const;
+  CommPtr parent_;
+  I32 leader_;
+  CommPtr graph_;
+  CommPtr graph_inverse_;
+  LOs sdispls_;
+  LOs rdispls_;
+  mutable std::unique_ptr<Plan> plan_;
+};
+
+#define OMEGA_H_EXPL_INST_DECL(T)                                              \
+  extern template Read<T> NodeExch::exch(Read<T> sendbuf, Int width) const;
+OMEGA_H_EXPL_INST_DECL(I8)
+OMEGA_H_EXPL_INST_DECL(I32)
+OMEGA_H_EXPL_INST_DECL(I64)
+OMEGA_H_EXPL_INST_DECL(F32)
+OMEGA_H_EXPL_INST_DECL(Real)
+#undef OMEGA_H_EXPL_INST_DECL
+
+}  // end namespace Omega_h
+
+#endif
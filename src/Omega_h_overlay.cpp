@@ -1,6 +1,7 @@
 #include <Omega_h_overlay.hpp>
 
 #include <Omega_h_build.hpp>
+#include <Omega_h_structured.hpp>
 
 namespace Omega_h {
 
@@ -19,7 +20,7 @@ Overlay::Overlay(
           comm
 #endif
           ),
-      mesh(build_box(library.world(), OMEGA_H_HYPERCUBE, Nx * cellSize,
+      mesh(build_structured_box(library.world(), Nx * cellSize,
           Ny * cellSize, Nz * cellSize, LO(Nx), LO(Ny), LO(Nz))) {
   silly_cells.reserve(size_t(mesh.nregions()));
   silly_faces.reserve(size_t(mesh.nfaces()));
@@ -39,14 +40,28 @@ Overlay::Overlay(
     set_vector(new_coords, i, x);
   }
   mesh.set_coords(new_coords);
-  mesh.ask_down(FACE, VERT);
-  mesh.ask_down(REGION, VERT);
-  mesh.ask_down(REGION, FACE);
-  mesh.ask_up(FACE, REGION);
+  /* a structured grid answers the queries below from formulas,
+     otherwise (after balancing over several ranks) store the arrays */
+  if (!mesh.is_structured()) {
+    mesh.ask_down(FACE, VERT);
+    mesh.ask_down(REGION, VERT);
+    mesh.ask_down(REGION, FACE);
+    mesh.ask_up(FACE, REGION);
+  }
 }
 
 std::array<size_t, 2> Overlay::get_face_cells(size_t face) const {
   std::array<size_t, 2> cells;
+  if (auto const box = mesh.structured()) {
+    LO face_cells[12];
+    I8 codes[12];
+    auto const ncells = box->up(FACE, LO(face), REGION, face_cells, codes);
+    for (Int i = 0; i < 2; ++i) {
+      cells[size_t(i)] =
+          (i < ncells) ? size_t(face_cells[i]) : get_invalid_cell_handle();
+    }
+    return cells;
+  }
   auto faces2cells = mesh.get_adj(FACE, REGION);
   auto face_i = LO(face);
   auto begin_i = size_t(faces2cells.a2ab[face_i]);
@@ -70,6 +85,12 @@ const std::vector<size_t>& Overlay::get_nodes() const { return silly_nodes; }
 
 std::array<size_t, 8> Overlay::get_cell_nodes(size_t cell) const {
   std::array<size_t, 8> nodes;
+  if (auto const box = mesh.structured()) {
+    LO cell_nodes[8];
+    box->ent_verts(REGION, LO(cell), cell_nodes);
+    for (size_t i = 0; i < 8; ++i) nodes[i] = size_t(cell_nodes[i]);
+    return nodes;
+  }
   auto cells2nodes = mesh.get_adj(REGION, VERT).ab2b;
   for (size_t i = 0; i < 8; ++i) {
     nodes[i] = size_t(cells2nodes[LO(cell * 8 + i)]);
@@ -79,6 +100,13 @@ std::array<size_t, 8> Overlay::get_cell_nodes(size_t cell) const {
 
 std::array<size_t, 6> Overlay::get_cell_faces(size_t cell) const {
   std::array<size_t, 6> faces;
+  if (auto const box = mesh.structured()) {
+    for (size_t i = 0; i < 6; ++i) {
+      I8 code;
+      faces[i] = size_t(box->down(REGION, LO(cell), FACE, Int(i), &code));
+    }
+    return faces;
+  }
   auto cells2faces = mesh.get_adj(REGION, FACE).ab2b;
   for (size_t i = 0; i < 6; ++i) {
     faces[i] = size_t(cells2faces[LO(cell * 6 + i)]);
@@ -88,6 +116,12 @@ std::array<size_t, 6> Overlay::get_cell_faces(size_t cell) const {
 
 std::array<size_t, 4> Overlay::get_face_nodes(size_t face) const {
   std::array<size_t, 4> nodes;
+  if (auto const box = mesh.structured()) {
+    LO face_nodes[4];
+    box->ent_verts(FACE, LO(face), face_nodes);
+    for (size_t i = 0; i < 4; ++i) nodes[i] = size_t(face_nodes[i]);
+    return nodes;
+  }
   auto faces2nodes = mesh.get_adj(FACE, VERT).ab2b;
   for (size_t i = 0; i < 4; ++i) {
     nodes[i] = size_t(faces2nodes[LO(face * 4 + i)]);
@@ -97,6 +131,12 @@ std::array<size_t, 4> Overlay::get_face_nodes(size_t face) const {
 
 std::array<size_t, 2> Overlay::get_edge_nodes(size_t edge) const {
   std::array<size_t, 2> nodes;
+  if (auto const box = mesh.structured()) {
+    LO edge_nodes[2];
+    box->ent_verts(EDGE, LO(edge), edge_nodes);
+    for (size_t i = 0; i < 2; ++i) nodes[i] = size_t(edge_nodes[i]);
+    return nodes;
+  }
   auto edges2nodes = mesh.get_adj(EDGE, VERT).ab2b;
   for (size_t i = 0; i < 2; ++i) {
     nodes[i] = size_t(edges2nodes[LO(edge * 2 + i)]);
@@ -110,9 +150,10 @@ Omega_h::Vector<3> Overlay::get_node_coordinates(size_t node) const {
 }
 
 Omega_h::Vector<3> Overlay::get_cell_center_location(size_t cell) const {
-  auto cells2nodes = mesh.get_adj(REGION, VERT).ab2b;
+  auto const nodes = get_cell_nodes(cell);
   auto nodes2coords = mesh.coords();
-  auto cell_nodes2nodes = gather_verts<8>(cells2nodes, LO(cell));
+  Few<LO, 8> cell_nodes2nodes;
+  for (Int i = 0; i < 8; ++i) cell_nodes2nodes[i] = LO(nodes[size_t(i)]);
   auto cell_nodes2coords = gather_vectors<8, 3>(nodes2coords, cell_nodes2nodes);
   return average(cell_nodes2coords);
 }
@@ -118,6 +118,7 @@ GOs globals_from_owners(Mesh* mesh, Int ent_dim) {
 INST(I8)
 INST(I32)
 INST(I64)
+INST(F32)
 INST(Real)
 #undef INST
 
@@ -46,6 +46,7 @@ GOs globals_from_owners(Mesh* mesh, Int ent_dim);
 OMEGA_H_INST_DECL(I8)
 OMEGA_H_INST_DECL(I32)
 OMEGA_H_INST_DECL(I64)
+OMEGA_H_INST_DECL(F32)
 OMEGA_H_INST_DECL(Real)
 #undef OMEGA_H_INST_DECL
 
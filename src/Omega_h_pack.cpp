@@ -0,0 +1,141 @@
+#include "Omega_h_pack.hpp"
+
+#include "Omega_h_for.hpp"
+#include "Omega_h_profile.hpp"
+#include "Omega_h_tag.hpp"
+
+namespace Omega_h {
+
+template <typename T>
+AnyArray::AnyArray(Read<T> array, Int ncomps)
+    : type_(TagTraits<T>::type()), ncomps_(ncomps), array_(array) {
+  OMEGA_H_CHECK(ncomps > 0);
+}
+
+Omega_h_Type AnyArray::type() const { return type_; }
+
+Int AnyArray::ncomps() const { return ncomps_; }
+
+template <typename T>
+Read<T> AnyArray::get() const {
+  OMEGA_H_CHECK(type_ == TagTraits<T>::type());
+  return any_cast<Read<T>>(array_);
+}
+
+PackedLayout get_packed_layout(std::vector<AnyArray> const& arrays) {
+  PackedLayout layout;
+  Int nbytes = 0;
+  for (auto const& array : arrays) {
+    auto f = [&](auto type) {
+      using T = decltype(type);
+      layout.types.push_back(array.type());
+      layout.ncomps.push_back(array.ncomps());
+      layout.offsets.push_back(nbytes);
+      nbytes += array.ncomps() * Int(sizeof(T));
+    };
+    apply_to_omega_h_types(array.type(), std::move(f));
+  }
+  layout.nwords = (nbytes + Int(sizeof(I64)) - 1) / Int(sizeof(I64));
+  return layout;
+}
+
+/* copies the bytes of one value to or from the packed words, which need
+   not be aligned for T. unlike std::memcpy this can run on the device */
+OMEGA_H_INLINE void copy_bytes(char* to, char const* from, Int nbytes) {
+  for (Int b = 0; b < nbytes; ++b) to[b] = from[b];
+}
+
+template <typename T>
+static void pack_array(
+    Write<I64> packed, Int nwords, Int offset, Read<T> array, Int ncomps) {
+  auto const bytes = reinterpret_cast<char*>(packed.data());
+  auto const stride = nwords * Int(sizeof(I64));
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    for (Int c = 0; c < ncomps; ++c) {
+      T const value = array[i * ncomps + c];
+      copy_bytes(bytes + i * stride + offset + c * Int(sizeof(T)),
+          reinterpret_cast<char const*>(&value), Int(sizeof(T)));
+    }
+  };
+  parallel_for(packed.size() / nwords, std::move(f), "pack_array");
+}
+
+template <typename T>
+static Read<T> unpack_array(
+    Read<I64> packed, Int nwords, Int offset, Int ncomps) {
+  auto const bytes = reinterpret_cast<char const*>(packed.data());
+  auto const stride = nwords * Int(sizeof(I64));
+  auto const nents = packed.size() / nwords;
+  Write<T> array(nents * ncomps);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    for (Int c = 0; c < ncomps; ++c) {
+      T value;
+      copy_bytes(reinterpret_cast<char*>(&value),
+          bytes + i * stride + offset + c * Int(sizeof(T)), Int(sizeof(T)));
+      array[i * ncomps + c] = value;
+    }
+  };
+  parallel_for(nents, std::move(f), "unpack_array");
+  return array;
+}
+
+Read<I64> pack_arrays(LO nents, std::vector<AnyArray> const& arrays,
+    PackedLayout const& layout) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(arrays.size() == layout.types.size());
+  Write<I64> packed(nents * layout.nwords);
+  if (layout.nwords == 0) return packed;
+  for (std::size_t i = 0; i < arrays.size(); ++i) {
+    auto f = [&](auto type) {
+      using T = decltype(type);
+      auto const array = arrays[i].get<T>();
+      OMEGA_H_CHECK(array.size() == nents * layout.ncomps[i]);
+      pack_array(
+          packed, layout.nwords, layout.offsets[i], array, layout.ncomps[i]);
+    };
+    apply_to_omega_h_types(layout.types[i], std::move(f));
+  }
+  return packed;
+}
+
+std::vector<AnyArray> unpack_arrays(
+    Read<I64> packed, PackedLayout const& layout) {
+  OMEGA_H_TIME_FUNCTION;
+  std::vector<AnyArray> arrays;
+  for (std::size_t i = 0; i < layout.types.size(); ++i) {
+    auto f = [&](auto type) {
+      using T = decltype(type);
+      auto const array = unpack_array<T>(
+          packed, layout.nwords, layout.offsets[i], layout.ncomps[i]);
+      arrays.push_back(AnyArray(array, layout.ncomps[i]));
+    };
+    apply_to_omega_h_types(layout.types[i], std::move(f));
+  }
+  return arrays;
+}
+
+ArraysFuture::ArraysFuture(
+    Future<I64> future, PackedLayout layout, callback_type callback)
+    : future_(std::move(future)),
+      layout_(std::move(layout)),
+      callback_(std::move(callback)) {}
+
+bool ArraysFuture::completed() { return future_.completed(); }
+
+std::vector<AnyArray> ArraysFuture::get() {
+  auto arrays = unpack_arrays(future_.get(), layout_);
+  if (callback_) callback_(arrays);
+  return arrays;
+}
+
+#define INST(T)                                                                \
+  template AnyArray::AnyArray(Read<T> array, Int ncomps);                      \
+  template Read<T> AnyArray::get() const;
+INST(I8)
+INST(I32)
+INST(I64)
+INST(F32)
+INST(Real)
+#undef INST
+
+}  // end namespace Omega_h
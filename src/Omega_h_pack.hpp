@@ -0,0 +1,79 @@
+#ifndef OMEGA_H_PACK_HPP
+#define OMEGA_H_PACK_HPP
+
+#include <functional>
+#include <vector>
+
+#include <Omega_h_any.hpp>
+#include <Omega_h_array.hpp>
+#include <Omega_h_future.hpp>
+
+namespace Omega_h {
+
+/* an array of one of the tag types together with its number of
+   components, so that arrays of different types can travel together */
+class AnyArray {
+ public:
+  AnyArray() = default;
+  template <typename T>
+  AnyArray(Read<T> array, Int ncomps);
+  Omega_h_Type type() const;
+  Int ncomps() const;
+  template <typename T>
+  Read<T> get() const;
+
+ private:
+  Omega_h_Type type_ = OMEGA_H_I8;
+  Int ncomps_ = 0;
+  any array_;
+};
+
+/* where the values of each array sit among the bytes of one entity in
+   the result of pack_arrays(). it only depends on the types and
+   numbers of components, so any rank can recompute it */
+struct PackedLayout {
+  std::vector<Omega_h_Type> types;
+  std::vector<Int> ncomps;
+  std::vector<Int> offsets;
+  /* the bytes of an entity, rounded up to whole 8-byte words */
+  Int nwords = 0;
+};
+
+PackedLayout get_packed_layout(std::vector<AnyArray> const& arrays);
+/* packs arrays over the same nents entities into one array with all the
+   values of entity i in words [i * nwords, (i + 1) * nwords), so that a
+   single Dist::exch() of width layout.nwords carries them all */
+Read<I64> pack_arrays(LO nents, std::vector<AnyArray> const& arrays,
+    PackedLayout const& layout);
+std::vector<AnyArray> unpack_arrays(
+    Read<I64> packed, PackedLayout const& layout);
+
+/* the Future of a packed exchange, unpacked once it completes.
+   the callback, if any, is given the arrays before get() returns them */
+class ArraysFuture {
+ public:
+  using callback_type = std::function<void(std::vector<AnyArray> const&)>;
+  ArraysFuture(Future<I64> future, PackedLayout layout,
+      callback_type callback = callback_type());
+  bool completed();
+  std::vector<AnyArray> get();
+
+ private:
+  Future<I64> future_;
+  PackedLayout layout_;
+  callback_type callback_;
+};
+
+#define OMEGA_H_EXPL_INST_DECL(T)                                              \
+  extern template AnyArray::AnyArray(Read<T> array, Int ncomps);               \
+  extern template Read<T> AnyArray::get() const;
+OMEGA_H_EXPL_INST_DECL(I8)
+OMEGA_H_EXPL_INST_DECL(I32)
+OMEGA_H_EXPL_INST_DECL(I64)
+OMEGA_H_EXPL_INST_DECL(F32)
+OMEGA_H_EXPL_INST_DECL(Real)
+#undef OMEGA_H_EXPL_INST_DECL
+
+}  // end namespace Omega_h
+
+#endif
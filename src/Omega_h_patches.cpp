@@ -1,134 +1,193 @@
-#include <Omega_h_mesh.hpp>
-#include <Omega_h_for.hpp> //parallel_for
+#include <Omega_h_patches.hpp>
+
 #include <Omega_h_array_ops.hpp> //get_min
+#include <Omega_h_for.hpp> //parallel_for
 #include <Omega_h_int_scan.hpp> //offset_scan
+#include <Omega_h_mesh.hpp>
+#include <Omega_h_profile.hpp>
 
-using namespace Omega_h;
-
-#if defined(OMEGA_H_USE_KOKKOS)
-#include <Kokkos_NestedSort.hpp> //sort_team
+namespace Omega_h {
 
 namespace {
-[[nodiscard]] Graph adj_segment_sort(Graph& g) {
-  using ExecSpace = Kokkos::DefaultExecutionSpace;
-  using TeamPol = Kokkos::TeamPolicy<ExecSpace>;
-  using TeamMem = typename TeamPol::member_type;
-  auto offsets = g.a2ab;
-  auto elms_r = g.ab2b.view(); //read only
-  Kokkos::View<LO*, ExecSpace> elms("elms", elms_r.size());
-  Kokkos::deep_copy(elms, elms_r);
-  auto segment_sort = KOKKOS_LAMBDA(const TeamMem& t) {
-    auto i = t.league_rank();
-    auto patch = Kokkos::subview(elms, Kokkos::make_pair(offsets[i], offsets[i+1]));
-    Kokkos::Experimental::sort_team(t, patch);
+
+/* in-place heap sort of a[0..n), usable from device code */
+OMEGA_H_INLINE void sift_down(LO* a, LO root, LO n) {
+  while (true) {
+    auto child = 2 * root + 1;
+    if (child >= n) return;
+    if (child + 1 < n && a[child] < a[child + 1]) ++child;
+    if (!(a[root] < a[child])) return;
+    auto const tmp = a[root];
+    a[root] = a[child];
+    a[child] = tmp;
+    root = child;
+  }
+}
+
+OMEGA_H_INLINE void heap_sort(LO* a, LO n) {
+  for (auto i = n / 2 - 1; i >= 0; --i) sift_down(a, i, n);
+  for (auto end = n - 1; end > 0; --end) {
+    auto const tmp = a[0];
+    a[0] = a[end];
+    a[end] = tmp;
+    sift_down(a, 0, end);
+  }
+}
+
+/* sorts the targets of every node and removes repeated ones */
+Graph sort_unique_rows(LOs a2ab, Write<LO> ab2b) {
+  auto const na = a2ab.size() - 1;
+  Write<LO> degrees(na);
+  auto sort = OMEGA_H_LAMBDA(LO a) {
+    auto const begin = a2ab[a];
+    auto const n = a2ab[a + 1] - begin;
+    auto const row = ab2b.data() + begin;
+    heap_sort(row, n);
+    LO nuniq = 0;
+    for (LO i = 0; i < n; ++i) {
+      if (i == 0 || row[i] != row[i - 1]) ++nuniq;
+    }
+    degrees[a] = nuniq;
+  };
+  parallel_for(na, std::move(sort), "sort_unique_rows(sort)");
+  auto const a2uniq = offset_scan(read(degrees));
+  Write<LO> uniq2b(a2uniq.last());
+  auto compact = OMEGA_H_LAMBDA(LO a) {
+    auto uniq = a2uniq[a];
+    for (auto ab = a2ab[a]; ab < a2ab[a + 1]; ++ab) {
+      if (ab == a2ab[a] || ab2b[ab] != ab2b[ab - 1]) uniq2b[uniq++] = ab2b[ab];
+    }
   };
-  Kokkos::parallel_for(TeamPol(g.nnodes(), Kokkos::AUTO()), segment_sort);
-  return Graph(offsets,Write<LO>(elms));
+  parallel_for(na, std::move(compact), "sort_unique_rows(compact)");
+  return Graph(a2uniq, read(uniq2b));
 }
 
-[[nodiscard]] Graph remove_duplicate_edges(Graph g) {
-  auto offsets = g.a2ab;
-  auto values = g.ab2b;
-  Write<I8> keep(g.nedges());
-  auto markDups = OMEGA_H_LAMBDA(LO i) {
-    keep[offsets[i]] = 1; //always keep the first edge in the segment
-    for(int j=offsets[i]+1; j<offsets[i+1]; j++) {
-      keep[j] = (values[j-1] != values[j]);
+/* adds the bridge neighbors of every entity of the patches
+   not marked done, all patches in one pass */
+Graph expand_patches(Graph patches, Graph bridges, Read<I8> done) {
+  auto const bridge_offsets = bridges.a2ab;
+  auto const bridge_ents = bridges.ab2b;
+  auto const npatches = patches.nnodes();
+  auto const patch_offsets = patches.a2ab;
+  auto const patch_ents = patches.ab2b;
+  Write<LO> degrees(npatches);
+  auto count = OMEGA_H_LAMBDA(LO patch) {
+    auto degree = patch_offsets[patch + 1] - patch_offsets[patch];
+    if (!done[patch]) {
+      for (auto j = patch_offsets[patch]; j < patch_offsets[patch + 1]; ++j) {
+        auto const ent = patch_ents[j];
+        /* counts duplicates */
+        degree += bridge_offsets[ent + 1] - bridge_offsets[ent];
+      }
+    }
+    degrees[patch] = degree;
+  };
+  parallel_for(npatches, std::move(count), "expand_patches(count)");
+  auto const dup_offsets = offset_scan(read(degrees));
+  Write<LO> dup_ents(dup_offsets.last());
+  auto fill = OMEGA_H_LAMBDA(LO patch) {
+    auto idx = dup_offsets[patch];
+    for (auto j = patch_offsets[patch]; j < patch_offsets[patch + 1]; ++j) {
+      auto const ent = patch_ents[j];
+      dup_ents[idx++] = ent;
+      if (done[patch]) continue;
+      for (auto k = bridge_offsets[ent]; k < bridge_offsets[ent + 1]; ++k) {
+        dup_ents[idx++] = bridge_ents[k];
+      }
     }
   };
-  parallel_for(g.nnodes(), markDups);
-  auto filtered = filter_graph_edges(g,keep);
-  return filtered;
+  parallel_for(npatches, std::move(fill), "expand_patches(fill)");
+  return sort_unique_rows(dup_offsets, dup_ents);
 }
 
-[[nodiscard]] Read<I8> patch_sufficient(Graph patches, Int minPatchSize) {
-  const auto num_patches = patches.nnodes();
-  auto offsets = patches.a2ab;
-  Write<I8> done(num_patches);
-  parallel_for(num_patches, OMEGA_H_LAMBDA(LO i) {
-    done[i] = ((offsets[i+1]-offsets[i]) >= minPatchSize);
-  });
+Read<I8> mark_sufficient(Graph patches, Int min_size) {
+  auto const offsets = patches.a2ab;
+  Write<I8> done(patches.nnodes());
+  auto f = OMEGA_H_LAMBDA(LO patch) {
+    done[patch] = ((offsets[patch + 1] - offsets[patch]) >= min_size);
+  };
+  parallel_for(patches.nnodes(), std::move(f), "mark_sufficient");
   return read(done);
 }
 
-/**
- * \brief expand the patches
- * \param m (in) mesh of simplices
- * \param patches (in) graph of key entities to elements
- * \param adjElms (in) second order element-to-element adjacencies
- *                     used for expansion
- * \return an expanded graph from key entities to elements
- *
- * The input graph of 'patches' that are not marked as done in
- * 'patchDone' are expanded by the following process.
- * 1) For each patch, loop over the elements and count the number of adjacent
- *    elements in 'adjElms'. Note, this may count the same element multiple
- *    times.
- * 2) Create an array 'patchExpDup_elms' to store the elements in the expanded
- *    patch (including duplicates) and fill it with the elements counted in
- *    step 1.
- * 3) For each expanded patch, sort the list of elements via the call to
- *    'adj_segment_sort(...)'.
- * 4) For each sorted patch, remove the duplicate elements from the list.
-*/
-//TODO use Omega_h_map and Omega_h_graph functions
-[[nodiscard]] Graph expand_patches(Mesh& m, Graph patches, Graph adjElms, Read<I8> patchDone) {
-  auto adjElms_offsets = adjElms.a2ab;
-  auto adjElms_elms = adjElms.ab2b;
-  const auto num_patches = patches.nnodes();
-  auto patch_offsets = patches.a2ab;
-  auto patch_elms = patches.ab2b;
-  Write<LO> degree(num_patches);
-  parallel_for(num_patches, OMEGA_H_LAMBDA(LO patch) {
-    degree[patch] = patch_offsets[patch+1] - patch_offsets[patch];
-    if(!patchDone[patch]) {
-      for(int j=patch_offsets[patch]; j<patch_offsets[patch+1]; j++) {
-        auto elm = patch_elms[j];
-        degree[patch] += adjElms_offsets[elm+1]-adjElms_offsets[elm]; //counts duplicates
-      }
+}  // end anonymous namespace
+
+Graph get_bridge_graph(Mesh* mesh, Int ent_dim, Int bridge_dim) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(ent_dim != bridge_dim);
+  auto const na = mesh->nents(ent_dim);
+  auto const a2b = mesh->ask_graph(ent_dim, bridge_dim);
+  auto const b2a = mesh->ask_graph(bridge_dim, ent_dim);
+  auto const a2ab = a2b.a2ab;
+  auto const ab2b = a2b.ab2b;
+  auto const b2ba = b2a.a2ab;
+  auto const ba2a = b2a.ab2b;
+  Write<LO> degrees(na);
+  auto count = OMEGA_H_LAMBDA(LO a) {
+    LO degree = 0;
+    for (auto ab = a2ab[a]; ab < a2ab[a + 1]; ++ab) {
+      auto const b = ab2b[ab];
+      /* every bridge entity lists a itself once */
+      degree += b2ba[b + 1] - b2ba[b] - 1;
     }
-  });
-  auto patchExpDup_offsets = offset_scan(read(degree));
-  Write<LO> patchExpDup_elms(patchExpDup_offsets.last());
-  parallel_for(num_patches, OMEGA_H_LAMBDA(LO patch) {
-    auto idx = patchExpDup_offsets[patch];
-    for(int j=patch_offsets[patch]; j<patch_offsets[patch+1]; j++) {
-      patchExpDup_elms[idx++] = patch_elms[j];
-      if(!patchDone[patch]) {
-        auto elm = patch_elms[j];
-        for(int k=adjElms_offsets[elm]; k<adjElms_offsets[elm+1]; k++) {
-          patchExpDup_elms[idx++] = adjElms_elms[k];
-        }
+    degrees[a] = degree;
+  };
+  parallel_for(na, std::move(count), "get_bridge_graph(count)");
+  auto const dup_offsets = offset_scan(read(degrees));
+  Write<LO> dup_ents(dup_offsets.last());
+  auto fill = OMEGA_H_LAMBDA(LO a) {
+    auto idx = dup_offsets[a];
+    for (auto ab = a2ab[a]; ab < a2ab[a + 1]; ++ab) {
+      auto const b = ab2b[ab];
+      for (auto ba = b2ba[b]; ba < b2ba[b + 1]; ++ba) {
+        if (ba2a[ba] != a) dup_ents[idx++] = ba2a[ba];
       }
     }
-  });
-  Graph patchExpDup(patchExpDup_offsets,patchExpDup_elms);
-  auto sorted = adj_segment_sort(patchExpDup);
-  auto dedup = remove_duplicate_edges(sorted);
-  return dedup;
+  };
+  parallel_for(na, std::move(fill), "get_bridge_graph(fill)");
+  return sort_unique_rows(dup_offsets, dup_ents);
 }
-}//end anonymous namespace
 
-[[nodiscard]] Graph Mesh::get_vtx_patches(Int minPatchSize, Int tgtDim) {
-  OMEGA_H_CHECK(minPatchSize > 0);
-  if(tgtDim == -1) {
-    tgtDim = dim();
+Graph grow_patches(Graph patches, Graph bridges, Int min_size) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(min_size > 0);
+  auto done = mark_sufficient(patches, min_size);
+  while (get_min(done) == 0) {
+    auto const nents = patches.nedges();
+    patches = expand_patches(patches, bridges, done);
+    /* every round adds at least one entity to a patch that can grow,
+       so no change means some patch never reaches min_size */
+    if (patches.nedges() == nents) return Graph();
+    done = mark_sufficient(patches, min_size);
   }
-  auto patches = ask_adj(VERT,tgtDim);
-  auto patchDone = patch_sufficient(patches, minPatchSize);
-  if( get_min(patchDone) == 1 )
-    return patches;
-  auto adj = ask_adj(tgtDim,tgtDim);
-  //assuming each iteration adds at least one element then
-  //the minPatchSize is a conservative upper bound on the
-  //iteration count
-  for(Int iter = 0; iter < minPatchSize; iter++) {
-    patches = expand_patches(*this, patches, adj, patchDone);
-    patchDone = patch_sufficient(patches, minPatchSize);
-    if( get_min(patchDone) == 1 ) {
-      return patches;
-    }
+  return patches;
+}
+
+Graph Mesh::get_vtx_patches(Int minPatchSize, Int tgtDim, Int bridgeDim) {
+  OMEGA_H_CHECK(minPatchSize > 0);
+  if (tgtDim == -1) tgtDim = dim();
+  check_dim2(tgtDim);
+  /* the default bridge is the one of ask_star() and ask_dual(),
+     cached under the target dimension itself */
+  auto const key = (bridgeDim == -1) ? tgtDim : bridgeDim;
+  check_dim2(key);
+  auto const& cached = vtx_patches_[tgtDim][key];
+  if (cached && cached->min_size == minPatchSize) {
+    count_event("mesh adj cache hit");
+    touch_cached(tgtDim, key, VTX_PATCHES);
+    return cached->graph;
   }
-  return Graph();
+  count_event("mesh adj cache miss");
+  auto const bridges = (key == tgtDim) ? Graph(ask_adj(tgtDim, tgtDim))
+                                       : get_bridge_graph(this, tgtDim, key);
+  auto const patches =
+      grow_patches(ask_adj(VERT, tgtDim), bridges, minPatchSize);
+  if (!patches.a2ab.exists() || structured_) return patches;
+  vtx_patches_[tgtDim][key] =
+      std::make_shared<PatchCache const>(PatchCache{minPatchSize, patches});
+  touch_cached(tgtDim, key, VTX_PATCHES);
+  enforce_cache_budget();
+  return patches;
 }
-#endif
+
+}  // end namespace Omega_h
@@ -0,0 +1,41 @@
+#ifndef OMEGA_H_PATCHES_HPP
+#define OMEGA_H_PATCHES_HPP
+
+#include <Omega_h_graph.hpp>
+
+namespace Omega_h {
+
+class Mesh;
+
+/**
+ * \brief second order adjacency through bridge entities
+ * \param ent_dim (in) dimension of the entities to connect
+ * \param bridge_dim (in) dimension of the bridge entities, lower or higher
+ *        than ent_dim
+ * \return a graph from each entity of dimension ent_dim to the other
+ *         entities of that dimension sharing at least one bridge entity
+ *         with it, in increasing order
+ * \details for example elements to elements through faces (the dual
+ *          graph without its exposed sides), through edges or through
+ *          vertices
+ */
+Graph get_bridge_graph(Mesh* mesh, Int ent_dim, Int bridge_dim);
+
+/**
+ * \brief expand patches until they are large enough
+ * \param patches (in) graph of key entities to the entities in their patch
+ * \param bridges (in) graph from patch entities to their neighbors,
+ *        e.g. from get_bridge_graph() or Mesh::ask_dual()
+ * \param min_size (in) the minimum number of entities in each patch
+ * \return the expanded patches, sorted and without repeated entities,
+ *         or an empty graph if some patch stops growing before it has
+ *         min_size entities
+ * \details every round adds the bridge neighbors of all entities of the
+ *          patches that are still too small, all patches in one pass.
+ *          patches that are large enough already are returned unchanged.
+ */
+Graph grow_patches(Graph patches, Graph bridges, Int min_size);
+
+}  // end namespace Omega_h
+
+#endif
@@ -1,14 +1,50 @@
 #include <Omega_h_fail.hpp>
 #include <Omega_h_pool.hpp>
 #include <Omega_h_profile.hpp>
-#include <algorithm>
+#include <atomic>
+#include <mutex>
 
 namespace Omega_h {
 
+double fragmentation(PoolStats const& stats) {
+  if (stats.bytes_reserved == 0) return 0.0;
+  return 1.0 - double(stats.bytes_requested) / double(stats.bytes_reserved);
+}
+
+double hit_rate(PoolStats const& stats) {
+  auto const total = stats.hits + stats.misses;
+  if (total == 0) return 0.0;
+  return double(stats.hits) / double(total);
+}
+
+/* size class (s * POOL_SUB_BINS + k) holds blocks of
+   2^s + k * 2^(s - POOL_SUB_BINS_LOG2) bytes.
+   powers of two too small to subdivide only use k = 0. */
+std::size_t pool_class_size(std::size_t size_class) {
+  auto const shift = size_class >> POOL_SUB_BINS_LOG2;
+  auto const sub = size_class & (POOL_SUB_BINS - 1);
+  auto const base = std::size_t(1) << shift;
+  return base + sub * (base >> POOL_SUB_BINS_LOG2);
+}
+
+std::size_t pool_size_class(std::size_t size) {
+  std::size_t shift = 0;
+  while ((std::size_t(1) << (shift + 1)) <= size && shift < 63) ++shift;
+  auto const base = std::size_t(1) << shift;
+  if (size <= base) return shift * POOL_SUB_BINS;
+  auto const step = base >> POOL_SUB_BINS_LOG2;
+  if (step == 0) return (shift + 1) * POOL_SUB_BINS;
+  auto const sub = (size - base + step - 1) / step;
+  if (sub == POOL_SUB_BINS) return (shift + 1) * POOL_SUB_BINS;
+  return shift * POOL_SUB_BINS + sub;
+}
+
 static void call_underlying_frees(Pool& pool, BlockList list[]) {
-  for (std::size_t i = 0; i < 64; ++i) {
+  for (std::size_t i = 0; i < POOL_NBINS; ++i) {
+    auto const block_size = pool_class_size(i);
     for (auto block : list[i]) {
-      pool.underlying_free(block, (std::size_t(1) << i));
+      pool.underlying_free(block, block_size);
+      pool.stats.bytes_reserved -= block_size;
     }
     list[i].clear();
   }
@@ -18,59 +54,226 @@ Pool::Pool(MallocFunc malloc_in, FreeFunc free_in)
     : underlying_malloc(malloc_in), underlying_free(free_in) {}
 
 Pool::~Pool() {
-  call_underlying_frees(*this, used_blocks);
+  for (auto& entry : used_blocks) {
+    underlying_free(entry.first, pool_class_size(entry.second));
+  }
+  used_blocks.clear();
   call_underlying_frees(*this, free_blocks);
 }
 
-static std::size_t underlying_total_size(Pool& pool) {
-  std::size_t total_size = 0;
-  for (std::size_t i = 0; i < 64; ++i) {
-    total_size += (std::size_t(1) << i) * pool.used_blocks[i].size();
-    total_size += (std::size_t(1) << i) * pool.free_blocks[i].size();
+/* the helpers below do no timing, the profiler is not thread-safe
+   and they are also called by ThreadSafePool */
+
+static VoidPtr take_block(Pool& pool, std::size_t size_class, bool* hit) {
+  auto const size_to_alloc = pool_class_size(size_class);
+  auto& free_list = pool.free_blocks[size_class];
+  VoidPtr data;
+  if (!free_list.empty()) {
+    data = free_list.back();
+    free_list.pop_back();
+    *hit = true;
+  } else {
+    data = pool.underlying_malloc(size_to_alloc);
+    if (data == nullptr) {
+      call_underlying_frees(pool, pool.free_blocks);
+      data = pool.underlying_malloc(size_to_alloc);
+    }
+    if (data == nullptr) {
+      Omega_h_fail(
+          "Pool failed to allocate %zu bytes, %zu bytes already allocated\n",
+          size_to_alloc, pool.stats.bytes_reserved);
+    }
+    *hit = false;
+    pool.stats.bytes_reserved += size_to_alloc;
+    if (pool.stats.bytes_reserved > pool.stats.high_water_bytes_reserved) {
+      pool.stats.high_water_bytes_reserved = pool.stats.bytes_reserved;
+    }
+  }
+  pool.used_blocks.emplace(data, size_class);
+  pool.stats.bytes_in_use += size_to_alloc;
+  return data;
+}
+
+static void give_block(Pool& pool, VoidPtr data, std::size_t size) {
+  auto const it = pool.used_blocks.find(data);
+  if (it == pool.used_blocks.end()) {
+    Omega_h_fail(
+        "Tried to deallocate %p from pool, but pool didn't allocate it\n",
+        data);
+  }
+  auto const size_class = it->second;
+  OMEGA_H_CHECK(size_class == pool_size_class(size));
+  pool.used_blocks.erase(it);
+  pool.free_blocks[size_class].push_back(data);
+  pool.stats.bytes_in_use -= pool_class_size(size_class);
+  pool.stats.bytes_requested -= size;
+}
+
+static VoidPtr allocate_untimed(Pool& pool, std::size_t size) {
+  bool hit;
+  auto const data = take_block(pool, pool_size_class(size), &hit);
+  if (hit) {
+    ++pool.stats.hits;
+  } else {
+    ++pool.stats.misses;
   }
-  return total_size;
+  pool.stats.bytes_requested += size;
+  return data;
 }
 
 void* allocate(Pool& pool, std::size_t size) {
   ScopedTimer timer("pool allocate");
-  std::size_t shift;
-  for (shift = 0; ((std::size_t(1) << shift) < size); ++shift)
-    ;
-  if (!pool.free_blocks[shift].empty()) {
-    auto const data = pool.free_blocks[shift].back();
-    pool.used_blocks[shift].push_back(data);
-    pool.free_blocks[shift].pop_back();
+  return allocate_untimed(pool, size);
+}
+
+void deallocate(Pool& pool, void* data, std::size_t size) {
+  ScopedTimer timer("pool deallocate");
+  give_block(pool, data, size);
+}
+
+/* blocks sitting in a magazine are "in use" as far as the shared Pool
+   is concerned, with the full block size counted as requested.
+   magazines are tied to one ThreadSafePool by its id; a magazine whose
+   pool has been destroyed is simply forgotten, since the Pool
+   destructor already released every block it handed out. */
+
+namespace {
+
+std::mutex& live_pools_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<std::uint64_t, ThreadSafePool*>& live_pools() {
+  static std::unordered_map<std::uint64_t, ThreadSafePool*> pools;
+  return pools;
+}
+
+std::atomic<std::uint64_t> next_pool_id(1);
+
+struct Magazines {
+  std::uint64_t pool_id = 0;
+  BlockList blocks[POOL_NBINS];
+  /* allocations served by this magazine since the last time
+     it took the lock on the shared pool */
+  std::size_t unreported_hits = 0;
+  void forget() {
+    for (auto& list : blocks) list.clear();
+    unreported_hits = 0;
+    pool_id = 0;
+  }
+  void flush_into(ThreadSafePool& tsp) {
+    for (std::size_t i = 0; i < POOL_NBINS; ++i) {
+      auto const block_size = pool_class_size(i);
+      for (auto block : blocks[i]) give_block(tsp.pool, block, block_size);
+    }
+    tsp.pool.stats.hits += unreported_hits;
+    forget();
+  }
+  void flush() {
+    if (pool_id == 0) return;
+    std::lock_guard<std::mutex> registry_lock(live_pools_mutex());
+    auto const it = live_pools().find(pool_id);
+    if (it != live_pools().end()) {
+      std::lock_guard<std::mutex> pool_lock(it->second->mutex);
+      flush_into(*(it->second));
+    } else {
+      forget();
+    }
+  }
+  void bind(ThreadSafePool& tsp) {
+    if (pool_id == tsp.id) return;
+    flush();
+    pool_id = tsp.id;
+  }
+  Magazines() = default;
+  Magazines(Magazines const&) = delete;
+  Magazines& operator=(Magazines const&) = delete;
+  ~Magazines() { flush(); }
+};
+
+thread_local Magazines thread_magazines;
+
+}  // end anonymous namespace
+
+ThreadSafePool::ThreadSafePool(MallocFunc malloc_in, FreeFunc free_in)
+    : pool(malloc_in, free_in), id(next_pool_id++) {
+  std::lock_guard<std::mutex> registry_lock(live_pools_mutex());
+  live_pools()[id] = this;
+}
+
+ThreadSafePool::~ThreadSafePool() {
+  std::lock_guard<std::mutex> registry_lock(live_pools_mutex());
+  live_pools().erase(id);
+  if (thread_magazines.pool_id == id) thread_magazines.forget();
+}
+
+void* allocate(ThreadSafePool& tsp, std::size_t size) {
+  auto const size_class = pool_size_class(size);
+  auto const block_size = pool_class_size(size_class);
+  if (block_size > POOL_MAGAZINE_MAX_BYTES) {
+    std::lock_guard<std::mutex> lock(tsp.mutex);
+    return allocate_untimed(tsp.pool, size);
+  }
+  auto& mags = thread_magazines;
+  mags.bind(tsp);
+  auto& magazine = mags.blocks[size_class];
+  if (!magazine.empty()) {
+    auto const data = magazine.back();
+    magazine.pop_back();
+    ++mags.unreported_hits;
     return data;
   }
-  auto const size_to_alloc = (std::size_t(1) << shift);
-  auto data = pool.underlying_malloc(size_to_alloc);
-  if (data == nullptr) {
-    call_underlying_frees(pool, pool.free_blocks);
-    data = pool.underlying_malloc(size_to_alloc);
+  std::lock_guard<std::mutex> lock(tsp.mutex);
+  bool all_hits = true;
+  for (std::size_t i = 0; i < POOL_MAGAZINE_CAPACITY / 2; ++i) {
+    bool hit;
+    magazine.push_back(take_block(tsp.pool, size_class, &hit));
+    all_hits = all_hits && hit;
   }
-  if (data == nullptr) {
-    Omega_h_fail(
-        "Pool failed to allocate %zu bytes, %zu bytes already allocated\n",
-        size_to_alloc, underlying_total_size(pool));
+  tsp.pool.stats.bytes_requested += block_size * magazine.size();
+  tsp.pool.stats.hits += mags.unreported_hits;
+  mags.unreported_hits = 0;
+  if (all_hits) {
+    ++tsp.pool.stats.hits;
+  } else {
+    ++tsp.pool.stats.misses;
   }
-  pool.used_blocks[shift].push_back(data);
+  auto const data = magazine.back();
+  magazine.pop_back();
   return data;
 }
 
-void deallocate(Pool& pool, void* data, std::size_t size) {
-  ScopedTimer timer("pool deallocate");
-  std::size_t shift;
-  for (shift = 0; ((std::size_t(1) << shift) < size); ++shift)
-    ;
-  auto const end = pool.used_blocks[shift].end();
-  auto const it = std::find_if(pool.used_blocks[shift].begin(), end,
-      [=](VoidPtr b) -> bool { return b == data; });
-  if (it == end) {
-    Omega_h_fail(
-        "Tried to deallocate %p from pool, but pool didn't allocate it\n",
-        data);
+void deallocate(ThreadSafePool& tsp, void* data, std::size_t size) {
+  auto const size_class = pool_size_class(size);
+  auto const block_size = pool_class_size(size_class);
+  if (block_size > POOL_MAGAZINE_MAX_BYTES) {
+    std::lock_guard<std::mutex> lock(tsp.mutex);
+    give_block(tsp.pool, data, size);
+    return;
+  }
+  auto& mags = thread_magazines;
+  mags.bind(tsp);
+  auto& magazine = mags.blocks[size_class];
+  if (magazine.size() == POOL_MAGAZINE_CAPACITY) {
+    std::lock_guard<std::mutex> lock(tsp.mutex);
+    while (magazine.size() > POOL_MAGAZINE_CAPACITY / 2) {
+      give_block(tsp.pool, magazine.back(), block_size);
+      magazine.pop_back();
+    }
+    tsp.pool.stats.hits += mags.unreported_hits;
+    mags.unreported_hits = 0;
+  }
+  magazine.push_back(data);
+}
+
+PoolStats get_stats(ThreadSafePool& tsp) {
+  std::lock_guard<std::mutex> lock(tsp.mutex);
+  auto& mags = thread_magazines;
+  if (mags.pool_id == tsp.id) {
+    tsp.pool.stats.hits += mags.unreported_hits;
+    mags.unreported_hits = 0;
   }
-  pool.free_blocks[shift].push_back(*it);
-  pool.used_blocks[shift].erase(it);
+  return tsp.pool.stats;
 }
 }  // namespace Omega_h
@@ -1,7 +1,11 @@
 #ifndef OMEGA_H_POOL_HPP
 #define OMEGA_H_POOL_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace Omega_h {
@@ -11,6 +15,29 @@ using BlockList = std::vector<VoidPtr>;
 using MallocFunc = std::function<VoidPtr(std::size_t)>;
 using FreeFunc = std::function<void(VoidPtr, std::size_t)>;
 
+/* each power of two is split into this many size classes,
+   so a block is never more than 25% larger than the request */
+constexpr std::size_t POOL_SUB_BINS_LOG2 = 2;
+constexpr std::size_t POOL_SUB_BINS = std::size_t(1) << POOL_SUB_BINS_LOG2;
+constexpr std::size_t POOL_NBINS = 64 * POOL_SUB_BINS;
+
+struct PoolStats {
+  /* bytes obtained from the underlying allocator and not yet returned */
+  std::size_t bytes_reserved = 0;
+  /* bytes in blocks currently handed out to callers */
+  std::size_t bytes_in_use = 0;
+  /* bytes the callers actually asked for, for blocks in use */
+  std::size_t bytes_requested = 0;
+  std::size_t high_water_bytes_reserved = 0;
+  /* allocations served from a free list vs. by the underlying allocator */
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+};
+
+/* fraction of reserved bytes not holding requested data */
+double fragmentation(PoolStats const& stats);
+double hit_rate(PoolStats const& stats);
+
 struct Pool {
   Pool(MallocFunc, FreeFunc);
   ~Pool();
@@ -18,14 +45,46 @@ struct Pool {
   Pool(Pool&&) = delete;
   Pool& operator=(Pool const&) = delete;
   Pool& operator=(Pool&&) = delete;
-  BlockList used_blocks[64];
-  BlockList free_blocks[64];
+  /* maps each block handed out to its size class */
+  std::unordered_map<VoidPtr, std::size_t> used_blocks;
+  BlockList free_blocks[POOL_NBINS];
   MallocFunc underlying_malloc;
   FreeFunc underlying_free;
+  PoolStats stats;
 };
 
+std::size_t pool_size_class(std::size_t size);
+std::size_t pool_class_size(std::size_t size_class);
+
 void* allocate(Pool&, std::size_t);
 void deallocate(Pool&, void*, std::size_t);
+
+/* per-thread magazines hold at most this many free blocks per size class */
+constexpr std::size_t POOL_MAGAZINE_CAPACITY = 32;
+/* larger blocks bypass the magazines and always lock the shared pool */
+constexpr std::size_t POOL_MAGAZINE_MAX_BYTES = std::size_t(1) << 20;
+
+/* a Pool that may be used from several threads at once.
+   each thread keeps a magazine of free blocks per size class and
+   only locks the shared Pool to refill an empty magazine, drain a
+   full one, or for large blocks. a thread's magazines are returned
+   to the shared Pool when the thread exits. */
+struct ThreadSafePool {
+  ThreadSafePool(MallocFunc, FreeFunc);
+  ~ThreadSafePool();
+  ThreadSafePool(ThreadSafePool const&) = delete;
+  ThreadSafePool(ThreadSafePool&&) = delete;
+  ThreadSafePool& operator=(ThreadSafePool const&) = delete;
+  ThreadSafePool& operator=(ThreadSafePool&&) = delete;
+  Pool pool;
+  std::mutex mutex;
+  std::uint64_t id;
+};
+
+void* allocate(ThreadSafePool&, std::size_t);
+void deallocate(ThreadSafePool&, void*, std::size_t);
+/* blocks held in magazines count as in use */
+PoolStats get_stats(ThreadSafePool&);
 }  // namespace Omega_h
 
 #endif
@@ -33,6 +33,7 @@ std::ostream& operator<<(std::ostream& stream, Write<T> r) {
 OMEGA_H_EXPL_INST(I8)
 OMEGA_H_EXPL_INST(I32)
 OMEGA_H_EXPL_INST(I64)
+OMEGA_H_EXPL_INST(F32)
 OMEGA_H_EXPL_INST(Real)
 #undef OMEGA_H_EXPL_INST
 
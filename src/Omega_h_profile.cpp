@@ -337,5 +337,43 @@ void print_top_sorted(History const& h_in, double total_runtime) {
   }
 }
 
+void print_counters(History const& h) {
+  auto counters = h.counters;
+  if (h.comm.get()) {
+    std::vector<char> cvec;
+    std::vector<double> dvec;
+    if (h.comm->rank()) {
+      for (auto const& i : counters) {
+        cvec.insert(cvec.end(), i.first.c_str(),
+            i.first.c_str() + i.first.length() + 1);
+        dvec.push_back(double(i.second));
+      }
+      h.comm->send(0, cvec);
+      h.comm->send(0, dvec);
+    } else {
+      for (int irank = 1; irank < h.comm->size(); ++irank) {
+        cvec.clear();
+        dvec.clear();
+        h.comm->recv(irank, cvec);
+        h.comm->recv(irank, dvec);
+        std::vector<std::string> res;
+        split_char_vec(cvec, res);
+        OMEGA_H_CHECK_OP(res.size(), ==, dvec.size());
+        for (size_t i = 0; i < res.size(); ++i) {
+          counters[res[i]] += std::size_t(dvec[i]);
+        }
+      }
+    }
+  }
+  if (counters.empty()) return;
+  TASK_0_cout << "\n";
+  TASK_0_cout << "COUNTERS (sum of all ranks):\n";
+  TASK_0_cout << "========\n";
+  for (auto const& i : counters) {
+    TASK_0_cout << std::right << std::setw(14) << i.second << "   " << i.first
+                << std::endl;
+  }
+}
+
 }  // namespace profile
 }  // namespace Omega_h
@@ -4,8 +4,10 @@
 #include <Omega_h_timer.hpp>
 #include <Omega_h_filesystem.hpp>
 #include <cstring>
-#include <vector>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 #ifdef OMEGA_H_USE_KOKKOS
 #include <Omega_h_kokkos.hpp>
 #endif
@@ -54,6 +56,8 @@ struct History {
   double chop;
   bool add_filename;
   CommPtr comm;
+  /* event counts, summed over ranks when printed */
+  std::map<std::string, std::size_t> counters;
   History(CommPtr comm = nullptr, bool dopercent=false, double chop=0.0, bool add_filename=false);
   History(const History& h);
   inline const char* get_name(std::size_t frame) const {
@@ -161,6 +165,7 @@ struct History {
     frames[current_frame].total_runtime = measure_total_runtime();
     pop();
   }
+  inline void count(char const* name, std::size_t n) { counters[name] += n; }
   std::size_t first(std::size_t parent) const;
   std::size_t next(std::size_t sibling) const;
   std::size_t parent(std::size_t child) const;
@@ -176,6 +181,7 @@ History invert(History const& h);
 void print_time_sorted(History const& h);
 void print_top_down_and_bottom_up(History const& h, double total_runtime);
 void print_top_sorted(History const& h, double total_runtime);
+void print_counters(History const& h);
 
 }  // namespace profile
 }  // namespace Omega_h
@@ -216,6 +222,13 @@ inline void end_code() {
   }
 }
 
+/* adds n to the named event counter of the profiler, if it is running */
+inline void count_event(char const* name, std::size_t n = 1) {
+  if (profile::global_singleton_history) {
+    profile::global_singleton_history->count(name, n);
+  }
+}
+
 struct ScopedTimer {
   ScopedTimer(char const* name, char const *file=0) { begin_code(name, file); }
   ~ScopedTimer() { end_code(); }
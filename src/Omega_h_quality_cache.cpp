@@ -0,0 +1,105 @@
+#include "Omega_h_quality_cache.hpp"
+
+#include "Omega_h_adapt.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
+#include "Omega_h_mesh.hpp"
+#include "Omega_h_transfer.hpp"
+
+namespace Omega_h {
+
+ScopedCavityQualityCaches::ScopedCavityQualityCaches(
+    Mesh* mesh, AdaptOpts const& opts)
+    : mesh_(mesh) {
+  if (opts.should_cache_collapse_qualities) {
+    mesh_->add_tag(EDGE, COLLAPSE_QUALITIES, 2,
+        Reals(mesh_->nedges() * 2, UNKNOWN_QUALITY), true);
+  }
+  if (mesh_->dim() == 3) {
+    mesh_->add_tag(EDGE, SWAP_QUALITIES, 3,
+        Reals(mesh_->nedges() * 3, UNKNOWN_QUALITY), true);
+  }
+}
+
+ScopedCavityQualityCaches::~ScopedCavityQualityCaches() {
+  if (mesh_->has_tag(EDGE, COLLAPSE_QUALITIES)) {
+    mesh_->remove_tag(EDGE, COLLAPSE_QUALITIES);
+  }
+  if (mesh_->has_tag(EDGE, SWAP_QUALITIES)) {
+    mesh_->remove_tag(EDGE, SWAP_QUALITIES);
+  }
+}
+
+void reset_cavity_quality_caches(Mesh* mesh) {
+  for (auto name : {COLLAPSE_QUALITIES, SWAP_QUALITIES}) {
+    if (!mesh->has_tag(EDGE, name)) continue;
+    auto ncomps = mesh->get_tagbase(EDGE, name)->ncomps();
+    mesh->set_tag(
+        EDGE, name, Reals(mesh->nedges() * ncomps, UNKNOWN_QUALITY), true);
+  }
+}
+
+/* marks entities adjacent to a new element on any rank */
+static Read<I8> mark_touched(
+    Mesh* new_mesh, Int ent_dim, Read<I8> elems_are_new) {
+  auto marks = mark_down(new_mesh, new_mesh->dim(), ent_dim, elems_are_new);
+  marks = new_mesh->reduce_array(ent_dim, marks, 1, OMEGA_H_MAX);
+  return new_mesh->sync_array(ent_dim, marks, 1);
+}
+
+/* a collapse cavity is the star of the collapsing vertex */
+static void forget_collapse_qualities(Mesh* new_mesh, Read<I8> elems_are_new) {
+  auto verts_are_touched = mark_touched(new_mesh, VERT, elems_are_new);
+  auto ev2v = new_mesh->ask_verts_of(EDGE);
+  auto old_quals = new_mesh->get_array<Real>(EDGE, COLLAPSE_QUALITIES);
+  Write<Real> quals(old_quals.size());
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    for (Int eev_col = 0; eev_col < 2; ++eev_col) {
+      auto v_col = ev2v[e * 2 + eev_col];
+      auto old_qual = old_quals[e * 2 + eev_col];
+      quals[e * 2 + eev_col] =
+          verts_are_touched[v_col] ? UNKNOWN_QUALITY : old_qual;
+    }
+  };
+  parallel_for(new_mesh->nedges(), std::move(f), "forget_collapse_qualities");
+  new_mesh->set_tag(EDGE, COLLAPSE_QUALITIES, Reals(quals), true);
+}
+
+/* a swap cavity is the elements around the edge */
+static void forget_swap_qualities(Mesh* new_mesh, Read<I8> elems_are_new) {
+  auto edges_are_touched = mark_touched(new_mesh, EDGE, elems_are_new);
+  auto old_quals = new_mesh->get_array<Real>(EDGE, SWAP_QUALITIES);
+  Write<Real> quals(old_quals.size());
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    for (Int c = 0; c < 3; ++c) quals[e * 3 + c] = old_quals[e * 3 + c];
+    if (edges_are_touched[e]) quals[e * 3 + 0] = UNKNOWN_QUALITY;
+  };
+  parallel_for(new_mesh->nedges(), std::move(f), "forget_swap_qualities");
+  new_mesh->set_tag(EDGE, SWAP_QUALITIES, Reals(quals), true);
+}
+
+void transfer_cavity_quality_caches(Mesh* old_mesh, Mesh* new_mesh,
+    Int prod_dim, LOs same_ents2old_ents, LOs same_ents2new_ents,
+    LOs prods2new_ents) {
+  if (prod_dim == EDGE) {
+    for (auto name : {COLLAPSE_QUALITIES, SWAP_QUALITIES}) {
+      if (!old_mesh->has_tag(EDGE, name)) continue;
+      auto tagbase = old_mesh->get_tagbase(EDGE, name);
+      auto prod_data =
+          Reals(prods2new_ents.size() * tagbase->ncomps(), UNKNOWN_QUALITY);
+      transfer_common(old_mesh, new_mesh, EDGE, same_ents2old_ents,
+          same_ents2new_ents, prods2new_ents, tagbase, prod_data);
+    }
+  }
+  if (prod_dim == new_mesh->dim()) {
+    auto has_collapse = new_mesh->has_tag(EDGE, COLLAPSE_QUALITIES);
+    auto has_swap = new_mesh->has_tag(EDGE, SWAP_QUALITIES);
+    if (!(has_collapse || has_swap)) return;
+    auto elems_are_new = mark_image(prods2new_ents, new_mesh->nelems());
+    if (has_collapse) forget_collapse_qualities(new_mesh, elems_are_new);
+    if (has_swap) forget_swap_qualities(new_mesh, elems_are_new);
+  }
+}
+
+}  // end namespace Omega_h
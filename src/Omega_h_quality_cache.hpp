@@ -0,0 +1,50 @@
+#ifndef OMEGA_H_QUALITY_CACHE_HPP
+#define OMEGA_H_QUALITY_CACHE_HPP
+
+#include <Omega_h_array.hpp>
+
+namespace Omega_h {
+
+class Mesh;
+struct AdaptOpts;
+
+/* edge tags caching cavity qualities across the passes of adapt().
+   "collapse_qualities" has the quality of collapsing each edge in either
+   direction, as from coarsen_qualities(). "swap_qualities" has the
+   quality and configuration chosen by swap3d_qualities() and the
+   max_length_allowed they were chosen with. */
+constexpr char const* COLLAPSE_QUALITIES = "collapse_qualities";
+constexpr char const* SWAP_QUALITIES = "swap_qualities";
+
+/* lower than any quality, marks entries that have to be computed */
+constexpr Real UNKNOWN_QUALITY = -2.0;
+
+/* the caches only exist while one of these is alive, so that meshes
+   coming out of adapt() don't carry them. the collapse cache is only kept
+   if opts.should_cache_collapse_qualities is set */
+class ScopedCavityQualityCaches {
+ public:
+  ScopedCavityQualityCaches(Mesh* mesh, AdaptOpts const& opts);
+  ~ScopedCavityQualityCaches();
+  ScopedCavityQualityCaches(ScopedCavityQualityCaches const&) = delete;
+  ScopedCavityQualityCaches& operator=(
+      ScopedCavityQualityCaches const&) = delete;
+
+ private:
+  Mesh* mesh_;
+};
+
+/* forgets every cached quality, for when coordinates or metrics change */
+void reset_cavity_quality_caches(Mesh* mesh);
+
+/* keeps the cached qualities of edges that a modification left alone,
+   for each prod_dim of transfer_refine(), transfer_coarsen() and
+   transfer_swap(). edges the new elements touch are forgotten once the
+   elements exist */
+void transfer_cavity_quality_caches(Mesh* old_mesh, Mesh* new_mesh,
+    Int prod_dim, LOs same_ents2old_ents, LOs same_ents2new_ents,
+    LOs prods2new_ents);
+
+}  // end namespace Omega_h
+
+#endif
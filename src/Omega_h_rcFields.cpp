@@ -40,6 +40,7 @@ namespace Omega_h {
 OMEGA_H_INST(I8)
 OMEGA_H_INST(I32)
 OMEGA_H_INST(I64)
+OMEGA_H_INST(F32)
 OMEGA_H_INST(Real)
 #undef OMEGA_H_INST
 
@@ -273,7 +274,8 @@ Read<T> Mesh::get_rc_mesh_array_from_rc_array(
   auto f = OMEGA_H_LAMBDA(LO i) {
     auto id = rc_ids[i];
     for (LO n = 0; n < ncomps; ++n) {
-      if ((mesh_field[id * ncomps + n] - static_cast<T>(OMEGA_H_INTERIOR_VAL)) < EPSILON) {
+      if (Real(mesh_field[id * ncomps + n] -
+               static_cast<T>(OMEGA_H_INTERIOR_VAL)) < EPSILON) {
         mesh_field[id * ncomps + n] = rc_field[i * ncomps + n];
       }
     }
@@ -8,6 +8,11 @@
 #include <Omega_h_scalar.hpp>
 #include <Omega_h_shared_alloc.hpp>
 
+#ifdef OMEGA_H_USE_THREADS
+#include <Omega_h_thread_pool.hpp>
+#include <vector>
+#endif
+
 namespace Omega_h {
 
 template <typename T>
@@ -101,7 +106,39 @@ Result transform_reduce(Iterator first, Iterator last, Result init,
   return init;
 }
 
-#else //end openmp
+#elif defined(OMEGA_H_USE_THREADS) //end openmp
+
+/* each chunk reduces its own range starting from its first transformed
+   value, then the partial results are combined in chunk order, so the
+   result only depends on the number of threads and not on scheduling */
+template <class Iterator, class Tranform, class Result, class Op>
+Result transform_reduce(
+    Iterator first, Iterator last, Result init, Op op, Tranform&& transform) {
+  LO const n = LO(last - first);
+  Omega_h::entering_parallel = true;
+  auto const transform_local = std::move(transform);
+  Omega_h::entering_parallel = false;
+  auto const nchunks = get_num_chunks(n);
+  if (nchunks == 0) return init;
+  /* wrapped so that Result = bool doesn't become a packed vector<bool> */
+  struct Partial {
+    Result value;
+  };
+  std::vector<Partial> partials(std::size_t(nchunks), Partial{init});
+  thread_pool_run(n, nchunks, [&](LO chunk, LO begin, LO end) {
+    Result partial = transform_local(first[begin]);
+    for (LO i = begin + 1; i < end; ++i) {
+      partial = op(std::move(partial), transform_local(first[i]));
+    }
+    partials[std::size_t(chunk)].value = std::move(partial);
+  });
+  for (auto& partial : partials) {
+    init = op(std::move(init), std::move(partial.value));
+  }
+  return init;
+}
+
+#else //end threads
 
 template <class Iterator, class Tranform, class Result, class Op>
 Result transform_reduce(
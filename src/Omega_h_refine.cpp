@@ -2,6 +2,7 @@
 
 #include <iostream>
 
+#include "Omega_h_arena.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_indset.hpp"
 #include "Omega_h_map.hpp"
@@ -26,7 +27,8 @@ static bool refine_ghosted(Mesh* mesh, AdaptOpts const& opts) {
   auto edges_are_initial =
       map_onto(cands_are_good, cands2edges, nedges, I8(0), 1);
   auto edge_quals = map_onto(cand_quals, cands2edges, nedges, 0.0, 1);
-  auto edges_are_keys = find_indset(mesh, EDGE, edge_quals, edges_are_initial);
+  auto edges_are_keys =
+      find_indset(mesh, EDGE, edge_quals, edges_are_initial, opts);
   mesh->add_tag(EDGE, "key", 1, edges_are_keys);
   mesh->add_tag(EDGE, "rep_vertex2md_order", 1,
       get_rep2md_order_adapt(mesh, EDGE, VERT, edges_are_keys));
@@ -41,6 +43,7 @@ static bool refine_ghosted(Mesh* mesh, AdaptOpts const& opts) {
 }
 
 static void refine_element_based(Mesh* mesh, AdaptOpts const& opts) {
+  ScopedArena arena;
   auto comm = mesh->comm();
   auto edges_are_keys = mesh->get_array<I8>(EDGE, "key");
   auto keys2edges = collect_marked(edges_are_keys);
@@ -68,7 +71,8 @@ static void refine_element_based(Mesh* mesh, AdaptOpts const& opts) {
     auto old_ents2new_ents = LOs();
     modify_ents_adapt(mesh, &new_mesh, ent_dim, EDGE, keys2edges, keys2prods,
         prod_verts2verts, old_lows2new_lows, &prods2new_ents,
-        &same_ents2old_ents, &same_ents2new_ents, &old_ents2new_ents);
+        &same_ents2old_ents, &same_ents2new_ents, &old_ents2new_ents,
+        old_verts2new_verts);
     if (ent_dim == VERT) {
       keys2midverts = prods2new_ents;
       old_verts2new_verts = old_ents2new_ents;
@@ -23,6 +23,12 @@ struct Promoted<I8> {
   typedef I32 type;
 };
 
+/* sums of single precision values accumulate in double precision */
+template <>
+struct Promoted<F32> {
+  typedef Real type;
+};
+
 template <typename T>
 using promoted_t = typename Promoted<T>::type;
 
@@ -97,6 +103,12 @@ struct ArithTraits<signed long long> {
   }
 };
 
+template <>
+struct ArithTraits<float> {
+  static constexpr OMEGA_H_INLINE float max() noexcept { return FLT_MAX; }
+  static constexpr OMEGA_H_INLINE float min() noexcept { return -FLT_MAX; }
+};
+
 template <>
 struct ArithTraits<double> {
   static constexpr OMEGA_H_INLINE double max() noexcept { return DBL_MAX; }
@@ -14,6 +14,11 @@
 
 #include <omp.h>
 
+#elif defined(OMEGA_H_USE_THREADS)
+
+#include <Omega_h_thread_pool.hpp>
+#include <vector>
+
 #endif
 
 namespace Omega_h {
@@ -155,6 +160,64 @@ OutputIterator transform_inclusive_scan(InputIterator first, InputIterator last,
   return result + n;
 }
 
+#elif defined(OMEGA_H_USE_THREADS)
+
+/* two passes over the same chunks: the first sums every chunk,
+   the second rescans each chunk starting from the sum of the
+   chunks before it */
+template <typename InputIterator, typename OutputIterator, typename BinaryOp,
+    typename UnaryOp>
+OutputIterator transform_inclusive_scan(InputIterator first, InputIterator last,
+    OutputIterator result, BinaryOp op, UnaryOp&& transform) {
+  LO const n = LO(last - first);
+  if (n <= 0) return result;
+  Omega_h::entering_parallel = true;
+  auto const transform_local = std::move(transform);
+  Omega_h::entering_parallel = false;
+  using T_const_ref = decltype(transform_local(*first));
+  using T_const = typename std::remove_reference<T_const_ref>::type;
+  using T = typename std::remove_const<T_const>::type;
+  struct Partial {
+    T value;
+  };
+  auto const nchunks = get_num_chunks(n);
+  std::vector<Partial> chunk_sums(
+      std::size_t(nchunks), Partial{transform_local(first[0])});
+  thread_pool_run(n, nchunks, [&](LO chunk, LO begin, LO end) {
+    if (chunk == nchunks - 1) return;
+    T sum = transform_local(first[begin]);
+    for (LO i = begin + 1; i < end; ++i) {
+      sum = op(std::move(sum), transform_local(first[i]));
+    }
+    chunk_sums[std::size_t(chunk)].value = std::move(sum);
+  });
+  for (LO chunk = 1; chunk + 1 < nchunks; ++chunk) {
+    chunk_sums[std::size_t(chunk)].value =
+        op(chunk_sums[std::size_t(chunk - 1)].value,
+            chunk_sums[std::size_t(chunk)].value);
+  }
+  thread_pool_run(n, nchunks, [&](LO chunk, LO begin, LO end) {
+    T value = transform_local(first[begin]);
+    if (chunk) {
+      value = op(chunk_sums[std::size_t(chunk - 1)].value, std::move(value));
+    }
+    result[begin] = value;
+    for (LO i = begin + 1; i < end; ++i) {
+      value = op(std::move(value), transform_local(first[i]));
+      result[i] = value;
+    }
+  });
+  return result + n;
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator inclusive_scan(
+    InputIterator first, InputIterator last, OutputIterator result) {
+  return transform_inclusive_scan(first, last, result,
+      [](auto const& a, auto const& b) { return a + b; },
+      [](auto const& a) { return a; });
+}
+
 #else
 
 template <typename InputIterator, typename OutputIterator>
@@ -1,3 +1,4 @@
+#include <Omega_h_arena.hpp>
 #include <Omega_h_fail.hpp>
 #include <Omega_h_library.hpp>
 #include <Omega_h_malloc.hpp>
@@ -67,7 +68,11 @@ Alloc::Alloc(std::size_t size_in, std::string&& name_in)
 }
 
 OMEGA_H_DLL Alloc::~Alloc() {
-  ::Omega_h::maybe_pooled_host_free(ptr, size);
+  if (chunk) {
+    arena_release(chunk);
+  } else {
+    ::Omega_h::maybe_pooled_host_free(ptr, size);
+  }
   auto ga = global_allocs;
   if (ga) {
     if (next == nullptr) {
@@ -86,7 +91,9 @@ OMEGA_H_DLL Alloc::~Alloc() {
 
 void Alloc::init() {
   failIfKokkosEnabled(__func__);
-  ptr = ::Omega_h::maybe_pooled_host_malloc(size);
+  chunk = nullptr;
+  ptr = arena_allocate(size, &chunk);
+  if (ptr == nullptr) ptr = ::Omega_h::maybe_pooled_host_malloc(size);
   use_count = 1;
   auto ga = global_allocs;
   if (size && (ptr == nullptr)) {
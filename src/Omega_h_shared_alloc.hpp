@@ -11,6 +11,7 @@ namespace Omega_h {
 class Library;
 
 struct Allocs;
+struct ArenaChunk;
 
 OMEGA_H_DLL extern bool entering_parallel;
 extern Allocs* global_allocs;
@@ -25,6 +26,8 @@ struct Alloc {
   int use_count;
   Alloc* prev;
   Alloc* next;
+  /* non-null if ptr was carved out of a ScopedArena chunk */
+  ArenaChunk* chunk;
   Alloc(std::size_t size_in, std::string const& name_in);
   Alloc(std::size_t size_in, std::string&& name_in);
   OMEGA_H_DLL ~Alloc();
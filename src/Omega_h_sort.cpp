@@ -11,6 +11,7 @@
 #include <Omega_h_sort.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <vector>
 
 #if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP)
@@ -99,7 +100,7 @@ static LOs sort_by_keys_tmpl(Read<T> keys) {
 }
 
 template <typename T>
-LOs sort_by_keys(Read<T> keys, Int width) {
+LOs comparison_sort_by_keys(Read<T> keys, Int width) {
   if (width == 1) return sort_by_keys_tmpl<1>(keys);
   if (width == 2) return sort_by_keys_tmpl<2>(keys);
   if (width == 3) return sort_by_keys_tmpl<3>(keys);
@@ -107,7 +108,166 @@ LOs sort_by_keys(Read<T> keys, Int width) {
   OMEGA_H_NORETURN(LOs());
 }
 
-#define INST(T) template LOs sort_by_keys(Read<T> keys, Int width);
+#if !defined(OMEGA_H_USE_KOKKOS)
+
+/* LSD radix sort of the permutation.
+   tuple entries are processed from last to first, and each entry one byte
+   at a time starting from the least significant one.
+   every pass is a stable counting sort, so the result is identical to
+   that of the comparison sort.
+   the array is split into one block per thread; each pass counts the
+   digits of every block, scans the counts in (digit, block) order and then
+   scatters every block to its own offsets. passes in which all keys share
+   the same digit (e.g. the high bytes of small indices) are skipped. */
+
+template <typename T>
+struct RadixKey;
+
+template <>
+struct RadixKey<I32> {
+  typedef std::uint32_t type;
+};
+
+template <>
+struct RadixKey<I64> {
+  typedef std::uint64_t type;
+};
+
+constexpr Int radix_bits = 8;
+constexpr Int radix_buckets = 1 << radix_bits;
+
+/* flipping the sign bit maps the signed order onto the unsigned order */
+template <typename T>
+static inline typename RadixKey<T>::type to_radix_key(T x) {
+  using U = typename RadixKey<T>::type;
+  return U(x) ^ (U(1) << (sizeof(U) * 8 - 1));
+}
+
+static void get_radix_block(LO n, int nblocks, int block, LO* begin, LO* end) {
+  auto const quotient = n / nblocks;
+  auto const remainder = n % nblocks;
+  *begin = quotient * block + min2(block, remainder);
+  *end = *begin + quotient + ((block < remainder) ? 1 : 0);
+}
+
+static int get_radix_nblocks(LO n) {
+#if defined(OMEGA_H_USE_OPENMP)
+  /* not worth waking up threads for small arrays */
+  if (n >= (LO(1) << 16)) return omp_get_max_threads();
+#endif
+  (void)n;
+  return 1;
+}
+
+template <typename U>
+static void radix_pass(LO n, Int shift, U const* keys_in, LO const* perm_in,
+    U* keys_out, LO* perm_out, int nblocks, std::vector<LO>& counts) {
+  counts.assign(std::size_t(nblocks * radix_buckets), 0);
+  LO* const c = counts.data();
+#if defined(OMEGA_H_USE_OPENMP)
+#pragma omp parallel for schedule(static, 1)
+#endif
+  for (int b = 0; b < nblocks; ++b) {
+    LO begin, end;
+    get_radix_block(n, nblocks, b, &begin, &end);
+    auto const bc = c + b * radix_buckets;
+    for (LO i = begin; i < end; ++i) {
+      ++bc[(keys_in[i] >> shift) & (radix_buckets - 1)];
+    }
+  }
+  LO offset = 0;
+  for (Int d = 0; d < radix_buckets; ++d) {
+    for (int b = 0; b < nblocks; ++b) {
+      auto const count = c[b * radix_buckets + d];
+      c[b * radix_buckets + d] = offset;
+      offset += count;
+    }
+  }
+#if defined(OMEGA_H_USE_OPENMP)
+#pragma omp parallel for schedule(static, 1)
+#endif
+  for (int b = 0; b < nblocks; ++b) {
+    LO begin, end;
+    get_radix_block(n, nblocks, b, &begin, &end);
+    auto const bc = c + b * radix_buckets;
+    for (LO i = begin; i < end; ++i) {
+      auto const pos = bc[(keys_in[i] >> shift) & (radix_buckets - 1)]++;
+      keys_out[pos] = keys_in[i];
+      perm_out[pos] = perm_in[i];
+    }
+  }
+}
+
+template <Int N, typename T>
+static LOs radix_sort_by_keys_tmpl(Read<T> keys) {
+  using U = typename RadixKey<T>::type;
+  begin_code("radix_sort_by_keys");
+  auto const n = divide_no_remainder(keys.size(), N);
+  auto const nblocks = get_radix_nblocks(n);
+  T const* const keyptr = keys.data();
+  Write<LO> perm(n, 0, 1);
+  std::vector<LO> perm_tmp(static_cast<std::size_t>(n));
+  std::vector<U> digits(static_cast<std::size_t>(n));
+  std::vector<U> digits_tmp(static_cast<std::size_t>(n));
+  std::vector<LO> counts;
+  LO* perm_in = perm.data();
+  LO* perm_out = perm_tmp.data();
+  for (Int j = N - 1; j >= 0 && n > 0; --j) {
+    U* const digits_in = digits.data();
+    /* bits in which some key differs from the first one */
+    U const first = to_radix_key(keyptr[perm_in[0] * N + j]);
+    U varying = 0;
+#if defined(OMEGA_H_USE_OPENMP)
+#pragma omp parallel for reduction(| : varying)
+#endif
+    for (LO i = 0; i < n; ++i) {
+      auto const digit = to_radix_key(keyptr[perm_in[i] * N + j]);
+      digits_in[i] = digit;
+      varying |= digit ^ first;
+    }
+    U* keys_in = digits.data();
+    U* keys_out = digits_tmp.data();
+    for (Int shift = 0; shift < Int(sizeof(U) * 8); shift += radix_bits) {
+      if (((varying >> shift) & (radix_buckets - 1)) == 0) continue;
+      radix_pass(
+          n, shift, keys_in, perm_in, keys_out, perm_out, nblocks, counts);
+      std::swap(keys_in, keys_out);
+      std::swap(perm_in, perm_out);
+    }
+  }
+  if (perm_in != perm.data()) std::copy(perm_in, perm_in + n, perm.data());
+  end_code();
+  return perm;
+}
+
+template <typename T>
+LOs radix_sort_by_keys(Read<T> keys, Int width) {
+  if (width == 1) return radix_sort_by_keys_tmpl<1>(keys);
+  if (width == 2) return radix_sort_by_keys_tmpl<2>(keys);
+  if (width == 3) return radix_sort_by_keys_tmpl<3>(keys);
+  if (width == 4) return radix_sort_by_keys_tmpl<4>(keys);
+  OMEGA_H_NORETURN(LOs());
+}
+
+#else
+
+/* device arrays can't be sorted by the host radix sort */
+template <typename T>
+LOs radix_sort_by_keys(Read<T> keys, Int width) {
+  return comparison_sort_by_keys(keys, width);
+}
+
+#endif
+
+template <typename T>
+LOs sort_by_keys(Read<T> keys, Int width) {
+  return radix_sort_by_keys(keys, width);
+}
+
+#define INST(T)                                                                \
+  template LOs sort_by_keys(Read<T> keys, Int width);                          \
+  template LOs comparison_sort_by_keys(Read<T> keys, Int width);               \
+  template LOs radix_sort_by_keys(Read<T> keys, Int width);
 INST(LO)
 INST(GO)
 #undef INST
@@ -21,8 +21,19 @@ namespace Omega_h {
 template <typename T>
 LOs sort_by_keys(Read<T> keys, Int width = 1);
 
+/* The two algorithms behind sort_by_keys, which produce identical results.
+   sort_by_keys uses the LSD radix sort on the host backends (serial and
+   OpenMP); with Kokkos enabled both functions use the comparison sort.
+ */
+template <typename T>
+LOs comparison_sort_by_keys(Read<T> keys, Int width = 1);
+template <typename T>
+LOs radix_sort_by_keys(Read<T> keys, Int width = 1);
+
 #define OMEGA_H_INST_DECL(T)                                                   \
-  extern template LOs sort_by_keys(Read<T> keys, Int width);
+  extern template LOs sort_by_keys(Read<T> keys, Int width);                   \
+  extern template LOs comparison_sort_by_keys(Read<T> keys, Int width);        \
+  extern template LOs radix_sort_by_keys(Read<T> keys, Int width);
 OMEGA_H_INST_DECL(LO)
 OMEGA_H_INST_DECL(GO)
 #undef OMEGA_H_INST_DECL
@@ -0,0 +1,92 @@
+#include "Omega_h_structured.hpp"
+
+#include "Omega_h_fail.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_int_scan.hpp"
+#include "Omega_h_profile.hpp"
+
+namespace Omega_h {
+
+StructuredBox make_structured_box(LO nx, LO ny, LO nz) {
+  OMEGA_H_CHECK(nx > 0);
+  OMEGA_H_CHECK(ny >= 0);
+  OMEGA_H_CHECK(nz >= 0);
+  OMEGA_H_CHECK(!(ny == 0 && nz > 0));
+  StructuredBox box;
+  box.dim = (ny == 0) ? 1 : ((nz == 0) ? 2 : 3);
+  box.n[0] = nx;
+  box.n[1] = (box.dim >= 2) ? ny : 1;
+  box.n[2] = (box.dim >= 3) ? nz : 1;
+  return box;
+}
+
+static Adj structured_down(StructuredBox const& box, Int from, Int to) {
+  auto const nhighs = box.nents(from);
+  auto const deg = hypercube_degree(from, to);
+  Write<LO> hl2l(nhighs * deg);
+  Write<I8> codes;
+  if (to != VERT) codes = Write<I8>(nhighs * deg);
+  auto f = OMEGA_H_LAMBDA(LO h) {
+    for (Int which = 0; which < deg; ++which) {
+      I8 code;
+      hl2l[h * deg + which] = box.down(from, h, to, which, &code);
+      if (to != VERT) codes[h * deg + which] = code;
+    }
+  };
+  parallel_for(nhighs, std::move(f), "structured_down");
+  if (to == VERT) return Adj(LOs(hl2l));
+  return Adj(LOs(hl2l), Read<I8>(codes));
+}
+
+static Adj structured_up(StructuredBox const& box, Int from, Int to) {
+  auto const nlows = box.nents(from);
+  Write<LO> degrees(nlows);
+  auto count = OMEGA_H_LAMBDA(LO l) {
+    LO highs[12];
+    I8 codes[12];
+    degrees[l] = box.up(from, l, to, highs, codes);
+  };
+  parallel_for(nlows, std::move(count), "structured_up(count)");
+  auto const l2lh = offset_scan(LOs(degrees));
+  Write<LO> lh2h(l2lh.last());
+  Write<I8> lh_codes(l2lh.last());
+  auto fill = OMEGA_H_LAMBDA(LO l) {
+    LO highs[12];
+    I8 codes[12];
+    auto const nhighs = box.up(from, l, to, highs, codes);
+    auto const begin = l2lh[l];
+    for (Int i = 0; i < nhighs; ++i) {
+      lh2h[begin + i] = highs[i];
+      lh_codes[begin + i] = codes[i];
+    }
+  };
+  parallel_for(nlows, std::move(fill), "structured_up(fill)");
+  return Adj(l2lh, LOs(lh2h), Read<I8>(lh_codes));
+}
+
+Adj structured_adj(StructuredBox const& box, Int from, Int to) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(0 <= from && from <= box.dim);
+  OMEGA_H_CHECK(0 <= to && to <= box.dim);
+  if (to < from) return structured_down(box, from, to);
+  if (from < to) return structured_up(box, from, to);
+  Omega_h_fail("structured_adj: no formula from dimension %d to itself\n",
+      from);
+  OMEGA_H_NORETURN(Adj());
+}
+
+Reals structured_coords(StructuredBox const& box, Real x, Real y, Real z) {
+  auto const dim = box.dim;
+  auto const nverts = box.nents(VERT);
+  Real const h[3] = {x / box.n[0], y / box.n[1], z / box.n[2]};
+  Write<Real> coords(nverts * dim);
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    LO c[3];
+    box.decode(VERT, v, c);
+    for (Int a = 0; a < dim; ++a) coords[v * dim + a] = c[a] * h[a];
+  };
+  parallel_for(nverts, std::move(f), "structured_coords");
+  return coords;
+}
+
+}  // end namespace Omega_h
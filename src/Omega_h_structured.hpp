@@ -0,0 +1,218 @@
+#ifndef OMEGA_H_STRUCTURED_HPP
+#define OMEGA_H_STRUCTURED_HPP
+
+#include <Omega_h_adj.hpp>
+#include <Omega_h_align.hpp>
+#include <Omega_h_hypercube.hpp>
+
+namespace Omega_h {
+
+/* the connectivity of a box of n[0] * n[1] * n[2] hypercubes,
+   as a set of formulas instead of arrays.
+
+   an entity of dimension d is identified by the set of axes it spans
+   (a bit mask with d bits set, its "group") and the (i,j,k) index of
+   its lowest corner vertex. the entities of one dimension are numbered
+   group by group in increasing mask order, and lexicographically by
+   (i,j,k) within a group, i fastest. in 3D for example the edges along x
+   come first, then those along y, then those along z; vertices and
+   elements follow make_3d_box().
+
+   vertices of an entity start at its lowest corner:
+     edge along a:          c, c+a
+     face spanning a < b:   c, c+a, c+a+b, c+b
+     hexahedron:            the order of make_3d_box()
+   which is also the canonical orientation of get_codes_to_canonical().
+   downward and upward adjacencies and their alignment codes are then
+   the ones the unstructured derivation would produce for this numbering.
+
+   everything here is callable from device code and takes constant time
+   per entity; structured_adj() builds whole arrays out of it. */
+struct StructuredBox {
+  Int dim;
+  /* cells along each axis, 1 for axes beyond dim */
+  LO n[3];
+
+  OMEGA_H_INLINE static Int count_bits(Int mask) {
+    Int c = 0;
+    for (; mask; mask >>= 1) c += (mask & 1);
+    return c;
+  }
+  /* entities of a group along an axis */
+  OMEGA_H_INLINE LO extent(Int mask, Int axis) const {
+    if (axis >= dim) return 1;
+    return ((mask >> axis) & 1) ? n[axis] : (n[axis] + 1);
+  }
+  OMEGA_H_INLINE LO group_size(Int mask) const {
+    LO s = 1;
+    for (Int a = 0; a < dim; ++a) s *= extent(mask, a);
+    return s;
+  }
+  OMEGA_H_INLINE LO group_offset(Int ent_dim, Int mask) const {
+    LO offset = 0;
+    for (Int m = 0; m < mask; ++m) {
+      if (count_bits(m) == ent_dim) offset += group_size(m);
+    }
+    return offset;
+  }
+  OMEGA_H_INLINE LO nents(Int ent_dim) const {
+    return group_offset(ent_dim, Int(1) << dim);
+  }
+  OMEGA_H_INLINE LO encode(Int ent_dim, Int mask, LO const c[]) const {
+    auto const e0 = extent(mask, 0);
+    auto const e1 = extent(mask, 1);
+    return group_offset(ent_dim, mask) + c[0] + e0 * (c[1] + e1 * c[2]);
+  }
+  OMEGA_H_INLINE Int decode(Int ent_dim, LO ent, LO c[]) const {
+    Int mask = 0;
+    for (Int m = 0; m < (Int(1) << dim); ++m) {
+      if (count_bits(m) != ent_dim) continue;
+      auto const size = group_size(m);
+      mask = m;
+      if (ent < size) break;
+      ent -= size;
+    }
+    auto const e0 = extent(mask, 0);
+    auto const e1 = extent(mask, 1);
+    c[0] = ent % e0;
+    c[1] = (ent / e0) % e1;
+    c[2] = ent / (e0 * e1);
+    return mask;
+  }
+  OMEGA_H_INLINE LO vert(LO i, LO j, LO k) const {
+    LO const c[3] = {i, j, k};
+    return encode(VERT, 0, c);
+  }
+  /* the vertices of an entity, in the order described above */
+  OMEGA_H_INLINE void ent_verts(Int ent_dim, LO ent, LO v[]) const {
+    LO c[3];
+    auto const mask = decode(ent_dim, ent, c);
+    if (ent_dim == VERT) {
+      v[0] = ent;
+      return;
+    }
+    Int axes[2] = {0, 0};
+    Int naxes = 0;
+    for (Int a = 0; a < dim && naxes < 2; ++a) {
+      if ((mask >> a) & 1) axes[naxes++] = a;
+    }
+    LO d[3] = {0, 0, 0};
+    /* corners of the square spanned by the first two axes,
+       in counterclockwise order */
+    Int const square[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+    auto const nsquare = (ent_dim == EDGE) ? 2 : 4;
+    auto const nlayers = (ent_dim == REGION) ? 2 : 1;
+    for (Int layer = 0; layer < nlayers; ++layer) {
+      for (Int s = 0; s < nsquare; ++s) {
+        d[0] = d[1] = d[2] = 0;
+        d[axes[0]] += square[s][0];
+        if (ent_dim >= FACE) d[axes[1]] += square[s][1];
+        if (layer) d[2] += 1;
+        v[layer * nsquare + s] = vert(c[0] + d[0], c[1] + d[1], c[2] + d[2]);
+      }
+    }
+  }
+  /* the entity of dimension ent_dim whose vertices are v[0..nv) */
+  OMEGA_H_INLINE LO find_ent(Int ent_dim, LO const v[], Int nv) const {
+    LO lo[3];
+    decode(VERT, v[0], lo);
+    Int mask = 0;
+    for (Int j = 1; j < nv; ++j) {
+      LO c[3];
+      decode(VERT, v[j], c);
+      for (Int a = 0; a < 3; ++a) {
+        if (c[a] != lo[a]) mask |= (Int(1) << a);
+        if (c[a] < lo[a]) lo[a] = c[a];
+      }
+    }
+    return encode(ent_dim, mask, lo);
+  }
+  /* the alignment code of the vertex list a relative to entity vertices b,
+     as reflect_down() computes it */
+  OMEGA_H_INLINE static I8 match_code(Int deg, LO const a[], LO const b[]) {
+    Int which = 0;
+    while (b[which] != a[0]) ++which;
+    if (deg == 2) return make_code(false, which, 0);
+    auto const is_flipped = (a[1] != b[(which + 1) % 4]);
+    return make_code(is_flipped, rotation_to_first(4, which), 0);
+  }
+  /* the which-th entity of dimension low_dim adjacent to the given
+     entity of dimension high_dim, with its alignment code */
+  OMEGA_H_INLINE LO down(
+      Int high_dim, LO high, Int low_dim, Int which, I8* code) const {
+    LO hv[8];
+    ent_verts(high_dim, high, hv);
+    auto const deg = hypercube_degree(low_dim, VERT);
+    LO lv[4];
+    for (Int j = 0; j < deg; ++j) {
+      lv[j] = hv[hypercube_down_template(high_dim, low_dim, which, j)];
+    }
+    auto const low = find_ent(low_dim, lv, deg);
+    *code = 0;
+    if (low_dim != VERT) {
+      LO bv[4];
+      ent_verts(low_dim, low, bv);
+      *code = match_code(deg, lv, bv);
+    }
+    return low;
+  }
+  /* the entities of dimension high_dim adjacent to the given entity of
+     dimension low_dim, in increasing order, with the codes invert_adj()
+     gives them. returns how many there are, at most 12 */
+  OMEGA_H_INLINE Int up(
+      Int low_dim, LO low, Int high_dim, LO highs[], I8 codes[]) const {
+    LO c[3];
+    auto const low_mask = decode(low_dim, low, c);
+    Int nhighs = 0;
+    for (Int mask = 0; mask < (Int(1) << dim); ++mask) {
+      if (count_bits(mask) != high_dim) continue;
+      if ((mask & low_mask) != low_mask) continue;
+      auto const free_axes = mask & ~low_mask;
+      /* the high entity may start at the low corner or one step below it
+         along each axis it spans beyond the low entity */
+      for (Int shift = 0; shift < (Int(1) << dim); ++shift) {
+        if ((shift & free_axes) != shift) continue;
+        LO hc[3];
+        bool inside = true;
+        for (Int a = 0; a < 3; ++a) {
+          hc[a] = c[a] - ((shift >> a) & 1);
+          if (hc[a] < 0 || hc[a] >= extent(mask, a)) inside = false;
+        }
+        if (inside) highs[nhighs++] = encode(high_dim, mask, hc);
+      }
+    }
+    for (Int i = 1; i < nhighs; ++i) {
+      for (Int j = i; j > 0 && highs[j] < highs[j - 1]; --j) {
+        auto const tmp = highs[j];
+        highs[j] = highs[j - 1];
+        highs[j - 1] = tmp;
+      }
+    }
+    auto const deg = hypercube_degree(high_dim, low_dim);
+    for (Int i = 0; i < nhighs; ++i) {
+      for (Int which = 0; which < deg; ++which) {
+        I8 code;
+        if (down(high_dim, highs[i], low_dim, which, &code) == low) {
+          codes[i] =
+              make_code(code_is_flipped(code), code_rotation(code), which);
+          break;
+        }
+      }
+    }
+    return nhighs;
+  }
+};
+
+/* a box of nx * ny * nz elements, with ny = nz = 0 in 1D
+   and nz = 0 in 2D, like build_box() */
+StructuredBox make_structured_box(LO nx, LO ny, LO nz);
+
+/* the adjacency from one dimension to another, from != to */
+Adj structured_adj(StructuredBox const& box, Int from, Int to);
+
+/* vertex coordinates of the box spanning [0,x] * [0,y] * [0,z] */
+Reals structured_coords(StructuredBox const& box, Real x, Real y, Real z);
+
+}  // end namespace Omega_h
+
+#endif
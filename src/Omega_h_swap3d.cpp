@@ -2,6 +2,7 @@
 
 #include <iostream>
 
+#include "Omega_h_arena.hpp"
 #include "Omega_h_indset.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
@@ -18,7 +19,7 @@ static bool swap3d_ghosted(Mesh* mesh, AdaptOpts const& opts) {
   auto cands2edges = collect_marked(edges_are_cands);
   auto cand_quals = Reals();
   auto cand_configs = Read<I8>();
-  swap3d_qualities(mesh, opts, cands2edges, &cand_quals, &cand_configs);
+  ask_swap3d_qualities(mesh, opts, cands2edges, &cand_quals, &cand_configs);
   auto edge_configs =
       map_onto(cand_configs, cands2edges, mesh->nedges(), I8(-1), 1);
   auto keep_cands = filter_swap_improve(mesh, cands2edges, cand_quals);
@@ -26,7 +27,8 @@ static bool swap3d_ghosted(Mesh* mesh, AdaptOpts const& opts) {
   if (comm->reduce_and(cands2edges.size() == 0)) return false;
   edges_are_cands = mark_image(cands2edges, mesh->nedges());
   auto edge_quals = map_onto(cand_quals, cands2edges, mesh->nedges(), -1.0, 1);
-  auto edges_are_keys = find_indset(mesh, EDGE, edge_quals, edges_are_cands);
+  auto edges_are_keys =
+      find_indset(mesh, EDGE, edge_quals, edges_are_cands, opts);
   Graph edges2cav_elems;
   edges2cav_elems = mesh->ask_up(EDGE, mesh->dim());
   mesh->add_tag(EDGE, "key", 1, edges_are_keys);
@@ -37,6 +39,7 @@ static bool swap3d_ghosted(Mesh* mesh, AdaptOpts const& opts) {
 }
 
 static void swap3d_element_based(Mesh* mesh, AdaptOpts const& opts) {
+  ScopedArena arena;
   auto comm = mesh->comm();
   auto edges_are_keys = mesh->get_array<I8>(EDGE, "key");
   mesh->remove_tag(EDGE, "key");
@@ -57,7 +60,8 @@ static void swap3d_element_based(Mesh* mesh, AdaptOpts const& opts) {
   auto keys2prods = swap3d_keys_to_prods(mesh, keys2edges);
   auto prod_verts2verts =
       swap3d_topology(mesh, keys2edges, edges_configs, keys2prods);
-  auto old_lows2new_lows = LOs(mesh->nverts(), 0, 1);
+  auto const old_verts2new_verts = LOs(mesh->nverts(), 0, 1);
+  auto old_lows2new_lows = old_verts2new_verts;
   for (Int ent_dim = EDGE; ent_dim <= mesh->dim(); ++ent_dim) {
     auto prods2new_ents = LOs();
     auto same_ents2old_ents = LOs();
@@ -66,7 +70,7 @@ static void swap3d_element_based(Mesh* mesh, AdaptOpts const& opts) {
     modify_ents_adapt(mesh, &new_mesh, ent_dim, EDGE, keys2edges,
         keys2prods[ent_dim], prod_verts2verts[ent_dim], old_lows2new_lows,
         &prods2new_ents, &same_ents2old_ents, &same_ents2new_ents,
-        &old_ents2new_ents);
+        &old_ents2new_ents, old_verts2new_verts);
     transfer_swap(mesh, opts.xfer_opts, &new_mesh, ent_dim, keys2edges,
         keys2prods[ent_dim], prods2new_ents, same_ents2old_ents,
         same_ents2new_ents);
@@ -1,7 +1,10 @@
 #include "Omega_h_swap3d.hpp"
 
 #include "Omega_h_for.hpp"
+#include "Omega_h_map.hpp"
+#include "Omega_h_profile.hpp"
 #include "Omega_h_quality.hpp"
+#include "Omega_h_quality_cache.hpp"
 #include "Omega_h_swap3d_choice.hpp"
 #include "Omega_h_swap3d_loop.hpp"
 
@@ -74,4 +77,52 @@ void swap3d_qualities(Mesh* mesh, AdaptOpts const& opts, LOs cands2edges,
   OMEGA_H_NORETURN();
 }
 
+void ask_swap3d_qualities(Mesh* mesh, AdaptOpts const& opts, LOs cands2edges,
+    Reals* cand_quals, Read<I8>* cand_configs) {
+  if (!mesh->has_tag(EDGE, SWAP_QUALITIES)) {
+    swap3d_qualities(mesh, opts, cands2edges, cand_quals, cand_configs);
+    return;
+  }
+  auto max_length = opts.max_length_allowed;
+  auto edge_data = mesh->get_array<Real>(EDGE, SWAP_QUALITIES);
+  auto cached = read(unmap(cands2edges, edge_data, 3));
+  auto ncands = cands2edges.size();
+  Write<I8> are_misses(ncands);
+  auto find_misses = OMEGA_H_LAMBDA(LO cand) {
+    are_misses[cand] = (cached[cand * 3 + 0] == UNKNOWN_QUALITY ||
+                        cached[cand * 3 + 2] != max_length);
+  };
+  parallel_for(ncands, std::move(find_misses), "ask_swap3d_qualities(misses)");
+  /* the misses are rank-local, but swap3d_qualities() fills copies from
+     their owners, so a miss on a copy has to be a miss on its owner too.
+     see ask_coarsen_qualities() for why it is */
+  auto misses2cands = collect_marked(read(are_misses));
+  count_event("swap quality cache miss", std::size_t(misses2cands.size()));
+  count_event(
+      "swap quality cache hit", std::size_t(ncands - misses2cands.size()));
+  auto misses2edges = unmap(misses2cands, cands2edges, 1);
+  Reals miss_quals;
+  Read<I8> miss_configs;
+  swap3d_qualities(mesh, opts, misses2edges, &miss_quals, &miss_configs);
+  Write<Real> new_edge_data = deep_copy(edge_data);
+  auto remember = OMEGA_H_LAMBDA(LO miss) {
+    auto e = misses2edges[miss];
+    new_edge_data[e * 3 + 0] = miss_quals[miss];
+    new_edge_data[e * 3 + 1] = Real(miss_configs[miss]);
+    new_edge_data[e * 3 + 2] = max_length;
+  };
+  parallel_for(misses2cands.size(), std::move(remember), "ask_swap3d_qualities");
+  mesh->set_tag(EDGE, SWAP_QUALITIES, Reals(new_edge_data), true);
+  Write<Real> quals(ncands);
+  Write<I8> configs(ncands);
+  auto gather = OMEGA_H_LAMBDA(LO cand) {
+    auto e = cands2edges[cand];
+    quals[cand] = new_edge_data[e * 3 + 0];
+    configs[cand] = static_cast<I8>(new_edge_data[e * 3 + 1]);
+  };
+  parallel_for(ncands, std::move(gather), "ask_swap3d_qualities(gather)");
+  *cand_quals = quals;
+  *cand_configs = configs;
+}
+
 }  // end namespace Omega_h
@@ -1,5 +1,16 @@
 #include "Omega_h_tag.hpp"
 
+#include <algorithm>
+#include <unordered_map>
+
+#ifdef OMEGA_H_USE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "Omega_h_arena.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_profile.hpp"
+
 namespace Omega_h {
 
 TagBase::TagBase(std::string const& name_in, Int ncomps_in)
@@ -36,6 +47,10 @@ LOs TagBase::class_ids() const { return class_ids_; }
 
 ArrayType TagBase::array_type() const { return array_type_; }
 
+std::size_t TagBase::naccesses() const { return naccesses_; }
+
+void TagBase::reset_naccesses() const { naccesses_ = 0; }
+
 template <typename T>
 bool is(TagBase const* t) {
   return nullptr != dynamic_cast<Tag<T> const*>(t);
@@ -70,38 +85,233 @@ Tag<T>::Tag(std::string const& name_in, Int ncomps_in, LOs class_ids_in,
     ArrayType array_type_in)
     : TagBase(name_in, ncomps_in, class_ids_in, array_type_in) {}
 
+/* byte i of element j goes to position i * n + j, so the slowly varying
+   high bytes of neighboring values end up next to each other */
+static void shuffle_bytes(unsigned char const* in, unsigned char* out,
+    std::size_t n, std::size_t width) {
+  for (std::size_t j = 0; j < n; ++j) {
+    for (std::size_t i = 0; i < width; ++i) {
+      out[i * n + j] = in[j * width + i];
+    }
+  }
+}
+
+static void unshuffle_bytes(unsigned char const* in, unsigned char* out,
+    std::size_t n, std::size_t width) {
+  for (std::size_t j = 0; j < n; ++j) {
+    for (std::size_t i = 0; i < width; ++i) {
+      out[j * width + i] = in[i * n + j];
+    }
+  }
+}
+
 template <typename T>
 Read<T> Tag<T>::array() const {
+  ++naccesses_;
+  if (!segments_.empty()) concatenate();
+  if (compressed_.empty()) return array_;
+#ifdef OMEGA_H_USE_ZLIB
+  ScopedTimer timer("Tag::decompress");
+  auto const n = static_cast<std::size_t>(compressed_size_);
+  std::vector<unsigned char> shuffled(n * sizeof(T));
+  uLongf dest_bytes = static_cast<uLongf>(shuffled.size());
+  int ret = ::uncompress(shuffled.data(), &dest_bytes, compressed_.data(),
+      static_cast<uLong>(compressed_.size()));
+  OMEGA_H_CHECK(ret == Z_OK);
+  OMEGA_H_CHECK(dest_bytes == shuffled.size());
+  HostWrite<T> host(compressed_size_, name());
+  unshuffle_bytes(shuffled.data(),
+      reinterpret_cast<unsigned char*>(nonnull(host.data())), n, sizeof(T));
+  array_ = promote_from_arena(Read<T>(host.write()));
+  std::vector<unsigned char>().swap(compressed_);
+  compressed_size_ = 0;
+  count_event("tag decompress");
+#endif
   return array_;
 }
 
 template <typename T>
 void Tag<T>::set_array(Read<T> array_in) {
+  ++naccesses_;
   array_ = array_in;
+  std::vector<unsigned char>().swap(compressed_);
+  compressed_size_ = 0;
+  segments_.clear();
+  segment_offsets_.clear();
 }
 
 template <typename T>
-struct TagTraits;
+void Tag<T>::set_segments(std::vector<TagSegment<T>> segments_in) {
+  set_array(Read<T>());
+  segment_offsets_.assign(1, 0);
+  /* distinct arrays the segments point into */
+  std::unordered_map<T const*, LO> sources;
+  std::size_t nsource_values = 0;
+  for (auto const& segment : segments_in) {
+    if (segment.size == 0) continue;
+    OMEGA_H_CHECK(segment.begin >= 0 && segment.size > 0);
+    OMEGA_H_CHECK(segment.begin + segment.size <= segment.array.size());
+    auto const source = segment.array.data();
+    if (!segments_.empty() && segments_.back().array.data() == source &&
+        segments_.back().begin + segments_.back().size == segment.begin) {
+      segments_.back().size += segment.size;
+      segment_offsets_.back() += segment.size;
+      continue;
+    }
+    segments_.push_back(segment);
+    segment_offsets_.push_back(segment_offsets_.back() + segment.size);
+    if (sources.emplace(source, segment.array.size()).second) {
+      nsource_values += std::size_t(segment.array.size());
+    }
+  }
+  auto const n = segment_offsets_.back();
+  if (segments_.empty()) {
+    segment_offsets_.clear();
+    array_ = Write<T>(0, name());
+    return;
+  }
+  if (segments_.size() == 1 && segments_[0].begin == 0 &&
+      segments_[0].size == segments_[0].array.size()) {
+    array_ = segments_[0].array;
+    segments_.clear();
+    segment_offsets_.clear();
+    return;
+  }
+  if (LO(segments_.size()) > n / TAG_SEGMENT_MIN_SIZE ||
+      nsource_values > 2 * std::size_t(n)) {
+    concatenate();
+  }
+}
 
-template <>
-struct TagTraits<I8> {
-  static Omega_h_Type type() { return OMEGA_H_I8; }
-};
+template <typename T>
+bool Tag<T>::is_segmented() const {
+  return !segments_.empty();
+}
 
-template <>
-struct TagTraits<I32> {
-  static Omega_h_Type type() { return OMEGA_H_I32; }
-};
+template <typename T>
+std::vector<TagSegment<T>> Tag<T>::segments(LO begin, LO end) const {
+  OMEGA_H_CHECK(0 <= begin && begin <= end);
+  std::vector<TagSegment<T>> out;
+  if (segments_.empty()) {
+    auto const a = array();
+    OMEGA_H_CHECK(end <= a.size());
+    if (end > begin) out.push_back({a, begin, end - begin});
+    return out;
+  }
+  ++naccesses_;
+  OMEGA_H_CHECK(end <= segment_offsets_.back());
+  auto i = std::size_t(std::upper_bound(segment_offsets_.begin(),
+                           segment_offsets_.end(), begin) -
+                       segment_offsets_.begin() - 1);
+  for (; begin < end; ++i) {
+    auto const& segment = segments_[i];
+    auto const size = std::min(end, segment_offsets_[i + 1]) - begin;
+    out.push_back(
+        {segment.array, segment.begin + begin - segment_offsets_[i], size});
+    begin += size;
+  }
+  return out;
+}
+
+/* long segments are split into pieces of this many values,
+   which are copied in parallel */
+constexpr LO TAG_CONCATENATE_PIECE = 1024;
+
+template <typename T>
+void Tag<T>::concatenate() const {
+  ScopedTimer timer("Tag::concatenate");
+  Write<T> out(segment_offsets_.back(), name());
+  /* one kernel per distinct source array */
+  std::unordered_map<T const*, std::vector<std::size_t>> sources;
+  for (std::size_t i = 0; i < segments_.size(); ++i) {
+    sources[segments_[i].array.data()].push_back(i);
+  }
+  for (auto const& source : sources) {
+    std::vector<LO> from_begins, to_begins, sizes;
+    for (auto const i : source.second) {
+      auto const& segment = segments_[i];
+      for (LO j = 0; j < segment.size; j += TAG_CONCATENATE_PIECE) {
+        from_begins.push_back(segment.begin + j);
+        to_begins.push_back(segment_offsets_[i] + j);
+        sizes.push_back(std::min(TAG_CONCATENATE_PIECE, segment.size - j));
+      }
+    }
+    auto const npieces = LO(sizes.size());
+    HostWrite<LO> h_from_begins(npieces), h_to_begins(npieces), h_sizes(npieces);
+    for (LO p = 0; p < npieces; ++p) {
+      h_from_begins[p] = from_begins[std::size_t(p)];
+      h_to_begins[p] = to_begins[std::size_t(p)];
+      h_sizes[p] = sizes[std::size_t(p)];
+    }
+    auto const piece_from_begins = LOs(h_from_begins.write());
+    auto const piece_to_begins = LOs(h_to_begins.write());
+    auto const piece_sizes = LOs(h_sizes.write());
+    auto const from = segments_[source.second.front()].array;
+    auto f = OMEGA_H_LAMBDA(LO p) {
+      auto const from_begin = piece_from_begins[p];
+      auto const to_begin = piece_to_begins[p];
+      for (LO j = 0; j < piece_sizes[p]; ++j) {
+        out[to_begin + j] = from[from_begin + j];
+      }
+    };
+    parallel_for(npieces, std::move(f), "Tag::concatenate");
+  }
+  /* this runs whenever the array is first read, possibly while an
+     arena is open */
+  array_ = promote_from_arena(Read<T>(out));
+  segments_.clear();
+  segment_offsets_.clear();
+  count_event("tag concatenate");
+}
+
+template <typename T>
+bool Tag<T>::compress() const {
+  if (!compressed_.empty()) return true;
+  /* segmented arrays mostly share memory with other tags */
+  if (!segments_.empty()) return false;
+#ifdef OMEGA_H_USE_ZLIB
+  if (!array_.exists()) return false;
+  auto const n = static_cast<std::size_t>(array_.size());
+  auto const nbytes = n * sizeof(T);
+  if (nbytes < TAG_COMPRESSION_MIN_BYTES) return false;
+  ScopedTimer timer("Tag::compress");
+  HostRead<T> host(array_);
+  std::vector<unsigned char> shuffled(nbytes);
+  shuffle_bytes(reinterpret_cast<unsigned char const*>(nonnull(host.data())),
+      shuffled.data(), n, sizeof(T));
+  uLongf dest_bytes = ::compressBound(static_cast<uLong>(nbytes));
+  std::vector<unsigned char> compressed(dest_bytes);
+  int ret = ::compress2(compressed.data(), &dest_bytes, shuffled.data(),
+      static_cast<uLong>(nbytes), Z_BEST_SPEED);
+  OMEGA_H_CHECK(ret == Z_OK);
+  /* not worth it unless a quarter of the memory is saved */
+  if (dest_bytes > nbytes / 4 * 3) return false;
+  compressed.resize(dest_bytes);
+  compressed.shrink_to_fit();
+  compressed_ = std::move(compressed);
+  compressed_size_ = array_.size();
+  array_ = Read<T>();
+  count_event("tag compress");
+  return true;
+#else
+  return false;
+#endif
+}
 
-template <>
-struct TagTraits<I64> {
-  static Omega_h_Type type() { return OMEGA_H_I64; }
-};
+template <typename T>
+bool Tag<T>::is_compressed() const {
+  return !compressed_.empty();
+}
 
-template <>
-struct TagTraits<Real> {
-  static Omega_h_Type type() { return OMEGA_H_F64; }
-};
+template <typename T>
+std::size_t Tag<T>::nbytes() const {
+  if (!compressed_.empty()) return compressed_.size();
+  if (!segments_.empty()) {
+    return static_cast<std::size_t>(segment_offsets_.back()) * sizeof(T);
+  }
+  if (!array_.exists()) return 0;
+  return static_cast<std::size_t>(array_.size()) * sizeof(T);
+}
 
 template <typename T>
 Omega_h_Type Tag<T>::type() const {
@@ -116,6 +326,7 @@ Omega_h_Type Tag<T>::type() const {
 INST(I8)
 INST(I32)
 INST(I64)
+INST(F32)
 INST(Real)
 #undef INST
 
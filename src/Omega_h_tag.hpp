@@ -2,6 +2,7 @@
 #define OMEGA_H_TAG_HPP
 
 #include <unordered_map>
+#include <vector>
 #include <Omega_h_array.hpp>
 #ifdef OMEGA_H_USE_MPI
 #include <mpi.h>
@@ -13,6 +14,35 @@ inline void check_tag_name(std::string const& name) {
   OMEGA_H_CHECK(!name.empty());
 }
 
+/* the Omega_h_Type of each tag type */
+template <typename T>
+struct TagTraits;
+
+template <>
+struct TagTraits<I8> {
+  static Omega_h_Type type() { return OMEGA_H_I8; }
+};
+
+template <>
+struct TagTraits<I32> {
+  static Omega_h_Type type() { return OMEGA_H_I32; }
+};
+
+template <>
+struct TagTraits<I64> {
+  static Omega_h_Type type() { return OMEGA_H_I64; }
+};
+
+template <>
+struct TagTraits<F32> {
+  static Omega_h_Type type() { return OMEGA_H_F32; }
+};
+
+template <>
+struct TagTraits<Real> {
+  static Omega_h_Type type() { return OMEGA_H_F64; }
+};
+
 enum class ArrayType {
   VectorND, // vector with N components
   SymmetricSquareMatrix, // symmetric matrix with dim*(dim+1)/2 components
@@ -41,6 +71,17 @@ class TagBase {
   virtual Omega_h_Type type() const = 0;
   LOs class_ids() const;
   ArrayType array_type() const;
+  /* in-memory compression of rarely read arrays, see Tag<T>::compress */
+  virtual bool compress() const = 0;
+  virtual bool is_compressed() const = 0;
+  /* bytes held by the array as currently stored */
+  virtual std::size_t nbytes() const = 0;
+  /* number of reads of the array since the last reset */
+  std::size_t naccesses() const;
+  void reset_naccesses() const;
+
+ protected:
+  mutable std::size_t naccesses_ = 0;
 
  private:
   std::string name_;
@@ -49,6 +90,21 @@ class TagBase {
   ArrayType array_type_ = ArrayType::VectorND;
 };
 
+/* arrays smaller than this are never compressed */
+constexpr std::size_t TAG_COMPRESSION_MIN_BYTES = 4096;
+
+/* values [begin, begin + size) of array */
+template <typename T>
+struct TagSegment {
+  Read<T> array;
+  LO begin;
+  LO size;
+};
+
+/* a segmented array whose segments average fewer values than this
+   is concatenated right away */
+constexpr LO TAG_SEGMENT_MIN_SIZE = 64;
+
 template <typename T>
 class Tag : public TagBase {
  public:
@@ -57,12 +113,36 @@ class Tag : public TagBase {
   Tag(std::string const& name_in, Int ncomps_in, ArrayType array_type_in);
   Tag(std::string const& name_in, Int ncomps_in, LOs class_ids_in,
       ArrayType array_type_in);
+  /* decompresses the array first if it was compressed, or concatenates
+     it if it was segmented */
   Read<T> array() const;
   void set_array(Read<T> array_in);
+  /* sets the array to the concatenation of the given slices of other
+     arrays, which stay shared with their owners (typically the same tag
+     on the mesh before a modification) until array() is called.
+     the array is concatenated right away if the segments are short or
+     keep alive more than twice its own size */
+  void set_segments(std::vector<TagSegment<T>> segments_in);
+  bool is_segmented() const;
+  /* the values [begin, end) of the array as slices of other arrays,
+     without concatenating a segmented array */
+  std::vector<TagSegment<T>> segments(LO begin, LO end) const;
   virtual Omega_h_Type type() const override;
+  /* replaces the array by a byte-shuffled, zlib-compressed host copy
+     if that saves memory. returns whether the tag is now compressed.
+     without zlib this does nothing */
+  virtual bool compress() const override;
+  virtual bool is_compressed() const override;
+  virtual std::size_t nbytes() const override;
 
  private:
-  Read<T> array_;
+  void concatenate() const;
+  mutable Read<T> array_;
+  mutable std::vector<unsigned char> compressed_;
+  mutable LO compressed_size_ = 0;
+  mutable std::vector<TagSegment<T>> segments_;
+  /* offset of each segment in the array, and the array size last */
+  mutable std::vector<LO> segment_offsets_;
 };
 
 template <typename T>
@@ -81,6 +161,7 @@ Tag<T>* as(TagBase* t);
 OMEGA_H_EXPL_INST_DECL(I8)
 OMEGA_H_EXPL_INST_DECL(I32)
 OMEGA_H_EXPL_INST_DECL(I64)
+OMEGA_H_EXPL_INST_DECL(F32)
 OMEGA_H_EXPL_INST_DECL(Real)
 #undef OMEGA_H_EXPL_INST_DECL
 
@@ -0,0 +1,238 @@
+#include <Omega_h_fail.hpp>
+#include <Omega_h_thread_pool.hpp>
+
+#include <algorithm>
+
+#if defined(OMEGA_H_USE_KOKKOS)
+#include <Omega_h_kokkos.hpp>
+#elif defined(OMEGA_H_USE_OPENMP)
+#include <omp.h>
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Omega_h {
+
+/* loops shorter than this are not worth waking other threads for */
+constexpr LO THREAD_POOL_MIN_PARALLEL = 4096;
+/* nor is splitting them into chunks smaller than this */
+constexpr LO THREAD_POOL_MIN_CHUNK = 1024;
+/* chunks per thread, the slack that work stealing balances */
+constexpr LO THREAD_POOL_CHUNKS_PER_THREAD = 8;
+
+#if defined(OMEGA_H_USE_THREADS) ||                                           \
+    (defined(OMEGA_H_USE_OPENMP) && !defined(OMEGA_H_USE_KOKKOS))
+static int default_num_threads() {
+  int const n = int(std::thread::hardware_concurrency());
+  return (n > 0) ? n : 1;
+}
+#endif
+
+#ifdef OMEGA_H_USE_THREADS
+
+namespace {
+
+/* the chunks a worker owns for the current loop, [next, end).
+   padded so that workers claiming chunks don't share cache lines. */
+struct alignas(64) WorkerShare {
+  std::atomic<LO> next;
+  LO end;
+};
+
+/* set on every thread while it executes chunks,
+   nested loops then run serially instead of deadlocking on the pool */
+thread_local bool in_thread_pool = false;
+
+class ThreadPool {
+ public:
+  explicit ThreadPool(int nthreads);
+  ~ThreadPool();
+  ThreadPool(ThreadPool const&) = delete;
+  ThreadPool& operator=(ThreadPool const&) = delete;
+  int size() const { return nthreads_; }
+  void run(LO n, LO nchunks, ChunkFunction const& f);
+
+ private:
+  void work(int worker);
+  void worker_main(int worker);
+  int nthreads_;
+  std::unique_ptr<WorkerShare[]> shares_;
+  std::vector<std::thread> threads_;
+  /* one loop at a time, even if several user threads call in */
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  unsigned generation_;
+  bool stopping_;
+  std::atomic<int> nbusy_;
+  ChunkFunction const* f_;
+  LO n_;
+  LO nchunks_;
+};
+
+ThreadPool::ThreadPool(int nthreads)
+    : nthreads_(nthreads),
+      shares_(new WorkerShare[std::size_t(nthreads)]),
+      generation_(0),
+      stopping_(false),
+      nbusy_(0),
+      f_(nullptr),
+      n_(0),
+      nchunks_(0) {
+  OMEGA_H_CHECK(nthreads_ >= 1);
+  for (int i = 0; i < nthreads_; ++i) {
+    shares_[i].next = 0;
+    shares_[i].end = 0;
+  }
+  threads_.reserve(std::size_t(nthreads_ - 1));
+  for (int i = 1; i < nthreads_; ++i) {
+    threads_.emplace_back(&ThreadPool::worker_main, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto& thread : threads_) thread.join();
+}
+
+void ThreadPool::work(int worker) {
+  auto const f = f_;
+  auto const n = n_;
+  auto const nchunks = nchunks_;
+  /* drain our own share first, then steal from the others in turn */
+  for (int k = 0; k < nthreads_; ++k) {
+    auto& share = shares_[(worker + k) % nthreads_];
+    while (true) {
+      auto const chunk = share.next.fetch_add(1, std::memory_order_relaxed);
+      if (chunk >= share.end) break;
+      auto const begin = LO((I64(n) * chunk) / nchunks);
+      auto const end = LO((I64(n) * (chunk + 1)) / nchunks);
+      (*f)(chunk, begin, end);
+    }
+  }
+}
+
+void ThreadPool::worker_main(int worker) {
+  in_thread_pool = true;
+  unsigned seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+      if (stopping_) return;
+      seen = generation_;
+    }
+    work(worker);
+    if (nbusy_.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_.notify_one();
+    }
+  }
+}
+
+void ThreadPool::run(LO n, LO nchunks, ChunkFunction const& f) {
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int i = 0; i < nthreads_; ++i) {
+      shares_[i].next = LO((I64(nchunks) * i) / nthreads_);
+      shares_[i].end = LO((I64(nchunks) * (i + 1)) / nthreads_);
+    }
+    f_ = &f;
+    n_ = n;
+    nchunks_ = nchunks;
+    nbusy_ = nthreads_ - 1;
+    ++generation_;
+  }
+  wake_.notify_all();
+  in_thread_pool = true;
+  work(0);
+  in_thread_pool = false;
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [&] { return nbusy_ == 0; });
+  f_ = nullptr;
+}
+
+std::unique_ptr<ThreadPool> global_thread_pool;
+std::mutex global_thread_pool_mutex;
+int requested_num_threads = 0;
+
+ThreadPool* get_thread_pool() {
+  std::lock_guard<std::mutex> lock(global_thread_pool_mutex);
+  if (!global_thread_pool) {
+    auto const n = (requested_num_threads > 0) ? requested_num_threads
+                                               : default_num_threads();
+    global_thread_pool.reset(new ThreadPool(n));
+  }
+  return global_thread_pool.get();
+}
+
+}  // end anonymous namespace
+
+int get_num_threads() { return get_thread_pool()->size(); }
+
+void set_num_threads(int n) {
+  OMEGA_H_CHECK(!in_thread_pool);
+  std::lock_guard<std::mutex> lock(global_thread_pool_mutex);
+  requested_num_threads = n;
+  /* the workers are started again lazily by the next loop */
+  global_thread_pool.reset();
+}
+
+#elif defined(OMEGA_H_USE_KOKKOS)
+
+int get_num_threads() {
+  return Kokkos::DefaultHostExecutionSpace().concurrency();
+}
+
+void set_num_threads(int) {}
+
+#elif defined(OMEGA_H_USE_OPENMP)
+
+int get_num_threads() { return omp_get_max_threads(); }
+
+void set_num_threads(int n) {
+  omp_set_num_threads((n > 0) ? n : default_num_threads());
+}
+
+#else
+
+int get_num_threads() { return 1; }
+
+void set_num_threads(int) {}
+
+#endif
+
+LO get_num_chunks(LO n) {
+  if (n < THREAD_POOL_MIN_PARALLEL) return (n > 0) ? 1 : 0;
+  auto const nthreads = LO(get_num_threads());
+  if (nthreads == 1) return 1;
+  return std::max(LO(1), std::min(nthreads * THREAD_POOL_CHUNKS_PER_THREAD,
+                             n / THREAD_POOL_MIN_CHUNK));
+}
+
+void thread_pool_run(LO n, LO nchunks, ChunkFunction const& f) {
+  if (nchunks <= 0) return;
+#ifdef OMEGA_H_USE_THREADS
+  if (nchunks > 1 && !in_thread_pool) {
+    get_thread_pool()->run(n, nchunks, f);
+    return;
+  }
+#endif
+  for (LO chunk = 0; chunk < nchunks; ++chunk) {
+    f(chunk, LO((I64(n) * chunk) / nchunks),
+        LO((I64(n) * (chunk + 1)) / nchunks));
+  }
+}
+
+}  // end namespace Omega_h
@@ -0,0 +1,43 @@
+#ifndef OMEGA_H_THREAD_POOL_HPP
+#define OMEGA_H_THREAD_POOL_HPP
+
+#include <Omega_h_defines.hpp>
+
+#include <functional>
+
+namespace Omega_h {
+
+/* the body of a parallel loop, called with the index of a chunk
+   and the [begin, end) range of iterations it covers */
+using ChunkFunction = std::function<void(LO chunk, LO begin, LO end)>;
+
+/* number of threads that execute parallel loops, including the caller.
+   with Kokkos this is the concurrency of the host execution space. */
+int get_num_threads();
+
+/* changes the number of threads used by later parallel loops.
+   n <= 0 selects std::thread::hardware_concurrency().
+   with OpenMP this calls omp_set_num_threads(), with Kokkos it has
+   no effect (Kokkos is configured through its own arguments). */
+void set_num_threads(int n);
+
+/* how many chunks a loop of n iterations should be cut into:
+   one for short loops, otherwise several per thread so that
+   idle threads have something left to steal */
+LO get_num_chunks(LO n);
+
+/* calls f once for every chunk of [0, n), chunk c covering
+   [c * n / nchunks, (c + 1) * n / nchunks), and returns when all
+   of them are done. callers that keep one partial result per chunk
+   (reductions, scans) size their storage with the same nchunks.
+   with Omega_h_USE_Threads the chunks are spread over a pool of
+   std::thread workers: each worker starts on its own contiguous share
+   of the chunks and then steals from the shares of the others.
+   the calling thread takes part as worker zero, and loops started from
+   inside a chunk run serially on the thread that started them.
+   in other configurations the chunks are run in order by the caller. */
+void thread_pool_run(LO n, LO nchunks, ChunkFunction const& f);
+
+}  // end namespace Omega_h
+
+#endif
@@ -7,9 +7,16 @@
 #include "Omega_h_map.hpp"
 #include "Omega_h_metric.hpp"
 #include "Omega_h_quality.hpp"
+#include "Omega_h_quality_cache.hpp"
 #include "Omega_h_shape.hpp"
+#include "Omega_h_sort.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <numeric>
+
 namespace Omega_h {
 
 bool is_transfer_required(
@@ -42,7 +49,8 @@ bool should_interpolate(
           name == "coordinates" || name == "warp")) {
     return false;
   }
-  return dim == VERT && tag->type() == OMEGA_H_REAL;
+  return dim == VERT &&
+         (tag->type() == OMEGA_H_REAL || tag->type() == OMEGA_H_F32);
 }
 
 bool should_fit(
@@ -168,32 +176,304 @@ void transfer_common2(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
   transfer_common3(new_mesh, ent_dim, tagbase, new_data);
 }
 
+namespace {
+
+/* the new entities of a modification as maximal pieces of consecutive
+   new entities that are either consecutive old entities kept as they
+   are or products. every tag of the modified dimension has this layout,
+   so its unchanged values can be shared with the old tag (see
+   Tag<T>::set_segments) instead of being copied */
+struct SameLayout {
+  LOs same_ents2old_ents;
+  LOs same_ents2new_ents;
+  LOs prods2new_ents;
+  /* false if the pieces are too short to be worth sharing */
+  bool is_segmented;
+  /* the products in increasing order of their new entity */
+  LOs sorted_prods;
+  /* per piece, in increasing order of new entities: the number of
+     entities and the first old entity, or -1 for products */
+  std::vector<LO> sizes;
+  std::vector<LO> old_begins;
+};
+
+std::shared_ptr<SameLayout const> make_same_layout(LOs same_ents2old_ents,
+    LOs same_ents2new_ents, LOs prods2new_ents, LO nnew_ents) {
+  auto layout = std::make_shared<SameLayout>();
+  layout->same_ents2old_ents = same_ents2old_ents;
+  layout->same_ents2new_ents = same_ents2new_ents;
+  layout->prods2new_ents = prods2new_ents;
+  layout->is_segmented = false;
+  auto const nsame = same_ents2old_ents.size();
+  if (nsame + prods2new_ents.size() != nnew_ents) return layout;
+  Write<I8> are_starts(nsame);
+  auto f = OMEGA_H_LAMBDA(LO same) {
+    are_starts[same] = (same == 0 ||
+        same_ents2old_ents[same] != same_ents2old_ents[same - 1] + 1 ||
+        same_ents2new_ents[same] != same_ents2new_ents[same - 1] + 1);
+  };
+  parallel_for(nsame, std::move(f), "make_same_layout");
+  auto const runs2same = collect_marked(read(are_starts));
+  auto const nruns = runs2same.size();
+  /* products add at most one piece per run */
+  if (LO(2 * nruns + 1) > nnew_ents / TAG_SEGMENT_MIN_SIZE) return layout;
+  HostRead<LO> h_runs2same(runs2same);
+  HostRead<LO> h_runs2old(unmap(runs2same, same_ents2old_ents, 1));
+  HostRead<LO> h_runs2new(unmap(runs2same, same_ents2new_ents, 1));
+  std::vector<LO> runs(static_cast<std::size_t>(nruns));
+  std::iota(runs.begin(), runs.end(), 0);
+  std::sort(runs.begin(), runs.end(),
+      [&](LO a, LO b) { return h_runs2new[a] < h_runs2new[b]; });
+  LO next_new = 0;
+  for (auto run : runs) {
+    auto const new_begin = h_runs2new[run];
+    if (new_begin > next_new) {
+      layout->sizes.push_back(new_begin - next_new);
+      layout->old_begins.push_back(-1);
+    }
+    auto const end = (run + 1 < nruns) ? h_runs2same[run + 1] : nsame;
+    auto const size = end - h_runs2same[run];
+    layout->sizes.push_back(size);
+    layout->old_begins.push_back(h_runs2old[run]);
+    next_new = new_begin + size;
+  }
+  if (nnew_ents > next_new) {
+    layout->sizes.push_back(nnew_ents - next_new);
+    layout->old_begins.push_back(-1);
+  }
+  layout->sorted_prods = sort_by_keys(prods2new_ents);
+  layout->is_segmented = true;
+  return layout;
+}
+
+bool same_arrays(LOs a, LOs b) {
+  return a.size() == b.size() && (a.size() == 0 || a.data() == b.data());
+}
+
+/* while a modification transfers its tags, the layout of each modified
+   dimension is computed for the first tag and reused for the others.
+   the layouts hold the maps they were made from, so comparing maps
+   by address is safe */
+class ScopedSameLayouts {
+ public:
+  ScopedSameLayouts();
+  ~ScopedSameLayouts();
+  ScopedSameLayouts(ScopedSameLayouts const&) = delete;
+  ScopedSameLayouts& operator=(ScopedSameLayouts const&) = delete;
+  std::vector<std::shared_ptr<SameLayout const>> layouts;
+
+ private:
+  ScopedSameLayouts* outer_;
+};
+
+thread_local ScopedSameLayouts* innermost_same_layouts = nullptr;
+
+ScopedSameLayouts::ScopedSameLayouts() : outer_(innermost_same_layouts) {
+  innermost_same_layouts = this;
+}
+
+ScopedSameLayouts::~ScopedSameLayouts() { innermost_same_layouts = outer_; }
+
+std::shared_ptr<SameLayout const> get_same_layout(LOs same_ents2old_ents,
+    LOs same_ents2new_ents, LOs prods2new_ents, LO nnew_ents) {
+  auto const scope = innermost_same_layouts;
+  if (scope) {
+    for (auto const& layout : scope->layouts) {
+      if (same_arrays(layout->same_ents2old_ents, same_ents2old_ents) &&
+          same_arrays(layout->same_ents2new_ents, same_ents2new_ents) &&
+          same_arrays(layout->prods2new_ents, prods2new_ents)) {
+        return layout;
+      }
+    }
+  }
+  auto const layout = make_same_layout(
+      same_ents2old_ents, same_ents2new_ents, prods2new_ents, nnew_ents);
+  if (scope) scope->layouts.push_back(layout);
+  return layout;
+}
+
+template <typename T>
+void transfer_segmented(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
+    SameLayout const& layout, TagBase const* tagbase, Read<T> prod_data) {
+  auto const& name = tagbase->name();
+  auto const ncomps = tagbase->ncomps();
+  auto const old_tag = old_mesh->get_tag<T>(ent_dim, name);
+  auto const sorted_prod_data = unmap(layout.sorted_prods, prod_data, ncomps);
+  std::vector<TagSegment<T>> segments;
+  LO prod = 0;
+  for (std::size_t i = 0; i < layout.sizes.size(); ++i) {
+    auto const size = layout.sizes[i];
+    auto const old_begin = layout.old_begins[i];
+    if (old_begin == -1) {
+      segments.push_back({sorted_prod_data, prod * ncomps, size * ncomps});
+      prod += size;
+    } else {
+      auto const old_segments = old_tag->segments(
+          old_begin * ncomps, (old_begin + size) * ncomps);
+      segments.insert(
+          segments.end(), old_segments.begin(), old_segments.end());
+    }
+  }
+  new_mesh->add_segmented_tag(ent_dim, name, ncomps, std::move(segments));
+}
+
+}  // end anonymous namespace
+
 template <typename T>
 void transfer_common(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
     LOs same_ents2old_ents, LOs same_ents2new_ents, LOs prods2new_ents,
     TagBase const* tagbase, Read<T> prod_data) {
   auto nnew_ents = new_mesh->nents(ent_dim);
   auto ncomps = tagbase->ncomps();
+  auto const layout = get_same_layout(
+      same_ents2old_ents, same_ents2new_ents, prods2new_ents, nnew_ents);
+  if (layout->is_segmented) {
+    transfer_segmented(
+        old_mesh, new_mesh, ent_dim, *layout, tagbase, prod_data);
+    return;
+  }
   auto new_data = Write<T>(nnew_ents * ncomps);
   map_into(prod_data, prods2new_ents, new_data, ncomps);
   transfer_common2(old_mesh, new_mesh, ent_dim, same_ents2old_ents,
       same_ents2new_ents, tagbase, new_data);
 }
 
+std::vector<std::vector<TagBase const*>> batch_tags(
+    Mesh* mesh, std::vector<TagBase const*> const& tags) {
+  auto const max_size = mesh->library()
+                            ? mesh->library()->transfer_batch_size()
+                            : TRANSFER_BATCH_SIZE;
+  std::vector<std::vector<TagBase const*>> batches;
+  for (auto tag : tags) {
+    auto it = std::find_if(batches.begin(), batches.end(), [&](auto& batch) {
+      return batch.size() < std::size_t(max_size) &&
+             batch[0]->type() == tag->type() &&
+             batch[0]->ncomps() == tag->ncomps();
+    });
+    if (it == batches.end()) {
+      batches.push_back({tag});
+    } else {
+      it->push_back(tag);
+    }
+  }
+  for (auto const& batch : batches) {
+    if (batch.size() > 1) {
+      count_event("transfer kernel launches saved", batch.size() - 1);
+    }
+  }
+  return batches;
+}
+
+template <typename T>
+static std::vector<Write<T>> make_prod_arrays(
+    std::vector<TagBase const*> const& tags, LO nprods) {
+  std::vector<Write<T>> prod_arrays;
+  for (auto tag : tags) prod_arrays.push_back(Write<T>(nprods * tag->ncomps()));
+  return prod_arrays;
+}
+
+/* prod_data[prod] = old_data[prods2olds[prod]] for all tags of the batch,
+   products without a source (-1) are left alone */
+template <typename T>
+static void gather_batch(TransferBatch<T> batch, LOs prods2olds) {
+  auto f = OMEGA_H_LAMBDA(LO prod) {
+    auto const old = prods2olds[prod];
+    if (old < 0) return;
+    for (Int t = 0; t < batch.ntags; ++t) {
+      for (Int comp = 0; comp < batch.ncomps; ++comp) {
+        batch.prod_data[t][prod * batch.ncomps + comp] =
+            batch.old_data[t][old * batch.ncomps + comp];
+      }
+    }
+  };
+  parallel_for(prods2olds.size(), std::move(f), "gather_batch");
+}
+
+/* the transfer_common calls of batched tags. they are made once all
+   batches are done, in the order of the tags, so that the new mesh
+   lists its tags in the same order as without batching */
+using TransferCommons =
+    std::vector<std::pair<TagBase const*, std::function<void()>>>;
+
+template <typename T>
+static void transfer_common_batch(Mesh* old_mesh, Mesh* new_mesh,
+    Int prod_dim, LOs same_ents2old_ents, LOs same_ents2new_ents,
+    LOs prods2new_ents, std::vector<TagBase const*> const& tags,
+    std::vector<Write<T>> const& prod_arrays, TransferCommons* commons) {
+  for (std::size_t i = 0; i < tags.size(); ++i) {
+    auto const tag = tags[i];
+    auto const prod_data = Read<T>(prod_arrays[i]);
+    commons->emplace_back(tag, [=]() {
+      transfer_common(old_mesh, new_mesh, prod_dim, same_ents2old_ents,
+          same_ents2new_ents, prods2new_ents, tag, prod_data);
+    });
+  }
+}
+
+static void finish_transfer_commons(
+    std::vector<TagBase const*> const& tags, TransferCommons const& commons) {
+  for (auto tag : tags) {
+    for (auto const& common : commons) {
+      if (common.first == tag) common.second();
+    }
+  }
+}
+
+/* sums are accumulated in double precision, as in average_field */
+template <typename T>
+static void transfer_linear_interp_tmpl(Mesh* old_mesh, Mesh* new_mesh,
+    LOs keys2edges, LOs keys2midverts, LOs same_verts2old_verts,
+    LOs same_verts2new_verts, std::vector<TagBase const*> const& tags,
+    TransferCommons* commons) {
+  ScopedTimer timer("transfer_linear_interp(batch)");
+  auto const nkeys = keys2edges.size();
+  auto const prod_arrays = make_prod_arrays<T>(tags, nkeys);
+  std::vector<Read<T>> old_arrays;
+  auto const batch =
+      make_transfer_batch(old_mesh, VERT, tags, prod_arrays, &old_arrays);
+  auto const ev2v = old_mesh->ask_verts_of(EDGE);
+  auto f = OMEGA_H_LAMBDA(LO key) {
+    auto const edge = keys2edges[key];
+    auto const v0 = ev2v[edge * 2 + 0];
+    auto const v1 = ev2v[edge * 2 + 1];
+    for (Int t = 0; t < batch.ntags; ++t) {
+      for (Int comp = 0; comp < batch.ncomps; ++comp) {
+        Real sum = 0;
+        sum += Real(batch.old_data[t][v0 * batch.ncomps + comp]);
+        sum += Real(batch.old_data[t][v1 * batch.ncomps + comp]);
+        sum /= 2;
+        batch.prod_data[t][key * batch.ncomps + comp] = static_cast<T>(sum);
+      }
+    }
+  };
+  parallel_for(nkeys, std::move(f), "transfer_linear_interp");
+  transfer_common_batch(old_mesh, new_mesh, VERT, same_verts2old_verts,
+      same_verts2new_verts, keys2midverts, tags, prod_arrays, commons);
+}
+
 static void transfer_linear_interp(Mesh* old_mesh, TransferOpts const& opts,
     Mesh* new_mesh, LOs keys2edges, LOs keys2midverts, LOs same_verts2old_verts,
     LOs same_verts2new_verts) {
+  std::vector<TagBase const*> tags;
   for (Int i = 0; i < old_mesh->ntags(VERT); ++i) {
     auto tagbase = old_mesh->get_tag(VERT, i);
     if (should_interpolate(old_mesh, opts, VERT, tagbase)) {
-      auto ncomps = tagbase->ncomps();
-      auto old_data = old_mesh->get_array<Real>(VERT, tagbase->name());
-      auto prod_data =
-          average_field(old_mesh, EDGE, keys2edges, ncomps, old_data);
-      transfer_common(old_mesh, new_mesh, VERT, same_verts2old_verts,
-          same_verts2new_verts, keys2midverts, tagbase, prod_data);
+      tags.push_back(tagbase);
+    }
+  }
+  TransferCommons commons;
+  for (auto const& batch : batch_tags(old_mesh, tags)) {
+    if (batch[0]->type() == OMEGA_H_F32) {
+      transfer_linear_interp_tmpl<F32>(old_mesh, new_mesh, keys2edges,
+          keys2midverts, same_verts2old_verts, same_verts2new_verts, batch,
+          &commons);
+    } else {
+      transfer_linear_interp_tmpl<Real>(old_mesh, new_mesh, keys2edges,
+          keys2midverts, same_verts2old_verts, same_verts2new_verts, batch,
+          &commons);
     }
   }
+  finish_transfer_commons(tags, commons);
 }
 
 static void transfer_metric(Mesh* old_mesh, TransferOpts const& opts,
@@ -210,22 +490,73 @@ static void transfer_metric(Mesh* old_mesh, TransferOpts const& opts,
   }
 }
 
+/* every product inherits the values of the entity of dimension old_dim
+   given by prods2olds */
 template <typename T>
-void transfer_inherit_refine(Mesh* old_mesh, Mesh* new_mesh, LOs keys2edges,
-    Int prod_dim, LOs keys2prods, LOs prods2new_ents, LOs same_ents2old_ents,
-    LOs same_ents2new_ents, std::string const& name) {
-  auto old_tag = old_mesh->get_tag<T>(prod_dim, name);
-  auto ncomps = old_tag->ncomps();
+static void transfer_inherit_batch(Mesh* old_mesh, Mesh* new_mesh,
+    Int old_dim, Int prod_dim, LOs prods2olds, LOs prods2new_ents,
+    LOs same_ents2old_ents, LOs same_ents2new_ents,
+    std::vector<TagBase const*> const& tags, TransferCommons* commons) {
+  ScopedTimer timer("transfer_inherit(batch)");
+  auto const prod_arrays = make_prod_arrays<T>(tags, prods2olds.size());
+  std::vector<Read<T>> old_arrays;
+  gather_batch(
+      make_transfer_batch(old_mesh, old_dim, tags, prod_arrays, &old_arrays),
+      prods2olds);
+  transfer_common_batch(old_mesh, new_mesh, prod_dim, same_ents2old_ents,
+      same_ents2new_ents, prods2new_ents, tags, prod_arrays, commons);
+}
+
+static void transfer_inherit(Mesh* old_mesh, Mesh* new_mesh, Int old_dim,
+    Int prod_dim, LOs prods2olds, LOs prods2new_ents, LOs same_ents2old_ents,
+    LOs same_ents2new_ents, std::vector<TagBase const*> const& tags) {
+  TransferCommons commons;
+  for (auto const& batch : batch_tags(old_mesh, tags)) {
+    switch (batch[0]->type()) {
+      case OMEGA_H_I8:
+        transfer_inherit_batch<I8>(old_mesh, new_mesh, old_dim, prod_dim,
+            prods2olds, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
+            batch, &commons);
+        break;
+      case OMEGA_H_I32:
+        transfer_inherit_batch<I32>(old_mesh, new_mesh, old_dim, prod_dim,
+            prods2olds, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
+            batch, &commons);
+        break;
+      case OMEGA_H_I64:
+        transfer_inherit_batch<I64>(old_mesh, new_mesh, old_dim, prod_dim,
+            prods2olds, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
+            batch, &commons);
+        break;
+      case OMEGA_H_F32:
+        transfer_inherit_batch<F32>(old_mesh, new_mesh, old_dim, prod_dim,
+            prods2olds, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
+            batch, &commons);
+        break;
+      case OMEGA_H_F64:
+        transfer_inherit_batch<Real>(old_mesh, new_mesh, old_dim, prod_dim,
+            prods2olds, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
+            batch, &commons);
+        break;
+    }
+  }
+  finish_transfer_commons(tags, commons);
+}
+
+/* the entities of dimension dom_dim whose values the products of
+   refinement inherit: for each key edge, pairs of products inherit from
+   the adjacent entities of dimension prod_dim, and the products cutting
+   adjacent entities of dimension prod_dim + 1 inherit from those.
+   products that inherit from the other dimension get -1 */
+static LOs get_refine_inherit_doms(Mesh* old_mesh, LOs keys2edges,
+    Int prod_dim, LOs keys2prods, Int dom_dim) {
   auto nprods = keys2prods.last();
-  auto prod_data = Write<T>(nprods * ncomps);
   auto nkeys = keys2edges.size();
-  /* transfer pairs */
-  if (prod_dim > VERT) {
-    auto dom_dim = prod_dim;
-    auto dom_data = old_mesh->get_array<T>(dom_dim, name);
-    auto edges2doms = old_mesh->ask_graph(EDGE, dom_dim);
-    auto edges2edge_doms = edges2doms.a2ab;
-    auto edge_doms2doms = edges2doms.ab2b;
+  auto prods2doms = Write<LO>(nprods, -1);
+  auto edges2doms = old_mesh->ask_graph(EDGE, dom_dim);
+  auto edges2edge_doms = edges2doms.a2ab;
+  auto edge_doms2doms = edges2doms.ab2b;
+  if (dom_dim == prod_dim) {
     auto f = OMEGA_H_LAMBDA(LO key) {
       auto edge = keys2edges[key];
       auto prod = keys2prods[key];
@@ -233,21 +564,13 @@ void transfer_inherit_refine(Mesh* old_mesh, Mesh* new_mesh, LOs keys2edges,
            edge_dom < edges2edge_doms[edge + 1]; ++edge_dom) {
         auto dom = edge_doms2doms[edge_dom];
         for (Int pair = 0; pair < 2; ++pair) {
-          for (Int comp = 0; comp < ncomps; ++comp) {
-            prod_data[prod * ncomps + comp] = dom_data[dom * ncomps + comp];
-          }
+          prods2doms[prod] = dom;
           ++prod;
         }
       }
     };
     parallel_for(nkeys, f, "transfer_inherit_refine(pairs)");
-  }
-  if (prod_dim < old_mesh->dim()) {
-    auto dom_dim = prod_dim + 1;
-    auto dom_data = old_mesh->get_array<T>(dom_dim, name);
-    auto edges2doms = old_mesh->ask_graph(EDGE, dom_dim);
-    auto edges2edge_doms = edges2doms.a2ab;
-    auto edge_doms2doms = edges2doms.ab2b;
+  } else {
     auto f = OMEGA_H_LAMBDA(LO key) {
       auto edge = keys2edges[key];
       auto ndoms = edges2edge_doms[edge + 1] - edges2edge_doms[edge];
@@ -255,84 +578,139 @@ void transfer_inherit_refine(Mesh* old_mesh, Mesh* new_mesh, LOs keys2edges,
       for (auto edge_dom = edges2edge_doms[edge];
            edge_dom < edges2edge_doms[edge + 1]; ++edge_dom) {
         auto dom = edge_doms2doms[edge_dom];
-        for (Int comp = 0; comp < ncomps; ++comp) {
-          prod_data[prod * ncomps + comp] = dom_data[dom * ncomps + comp];
-        }
+        prods2doms[prod] = dom;
         ++prod;
       }
     };
     parallel_for(nkeys, f, "transfer_inherit_refine(cuts)");
   }
-  transfer_common(old_mesh, new_mesh, prod_dim, same_ents2old_ents,
-      same_ents2new_ents, prods2new_ents, old_tag, Read<T>(prod_data));
+  return prods2doms;
 }
 
-void transfer_inherit_refine(Mesh* old_mesh, Mesh* new_mesh, LOs keys2edges,
-    Int prod_dim, LOs keys2prods, LOs prods2new_ents, LOs same_ents2old_ents,
-    LOs same_ents2new_ents, TagBase const* tagbase) {
-  switch (tagbase->type()) {
-    case OMEGA_H_I8:
-      transfer_inherit_refine<I8>(old_mesh, new_mesh, keys2edges, prod_dim,
-          keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
-          tagbase->name());
-      break;
-    case OMEGA_H_I32:
-      transfer_inherit_refine<I32>(old_mesh, new_mesh, keys2edges, prod_dim,
-          keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
-          tagbase->name());
-      break;
-    case OMEGA_H_I64:
-      transfer_inherit_refine<I64>(old_mesh, new_mesh, keys2edges, prod_dim,
-          keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
-          tagbase->name());
-      break;
-    case OMEGA_H_F64:
-      transfer_inherit_refine<Real>(old_mesh, new_mesh, keys2edges, prod_dim,
-          keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
-          tagbase->name());
-      break;
+/* where the products of dimension prod_dim inherit their values from,
+   found once per transfer_refine call for all the tags that inherit */
+struct RefineInheritSources {
+  LOs prods2pair_doms;
+  LOs prods2cut_doms;
+};
+
+static RefineInheritSources get_refine_inherit_sources(
+    Mesh* old_mesh, LOs keys2edges, Int prod_dim, LOs keys2prods) {
+  RefineInheritSources sources;
+  if (prod_dim > VERT) {
+    sources.prods2pair_doms = get_refine_inherit_doms(
+        old_mesh, keys2edges, prod_dim, keys2prods, prod_dim);
+  }
+  if (prod_dim < old_mesh->dim()) {
+    sources.prods2cut_doms = get_refine_inherit_doms(
+        old_mesh, keys2edges, prod_dim, keys2prods, prod_dim + 1);
   }
+  return sources;
 }
 
-static void transfer_inherit_refine(Mesh* old_mesh, TransferOpts const& opts,
-    Mesh* new_mesh, LOs keys2edges, Int prod_dim, LOs keys2prods,
-    LOs prods2new_ents, LOs same_ents2old_ents, LOs same_ents2new_ents) {
-  for (Int i = 0; i < old_mesh->ntags(prod_dim); ++i) {
-    auto tagbase = old_mesh->get_tag(prod_dim, i);
-    if (should_inherit(old_mesh, opts, prod_dim, tagbase)) {
-      transfer_inherit_refine(old_mesh, new_mesh, keys2edges, prod_dim,
-          keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
-          tagbase);
-    }
+template <typename T>
+static void transfer_inherit_refine_batch(Mesh* old_mesh, Mesh* new_mesh,
+    Int prod_dim, LOs prods2new_ents, LOs same_ents2old_ents,
+    LOs same_ents2new_ents, RefineInheritSources const& sources,
+    std::vector<TagBase const*> const& tags, TransferCommons* commons) {
+  ScopedTimer timer("transfer_inherit_refine(batch)");
+  auto const prod_arrays = make_prod_arrays<T>(tags, prods2new_ents.size());
+  std::vector<Read<T>> old_arrays;
+  if (sources.prods2pair_doms.exists()) {
+    gather_batch(make_transfer_batch(
+                     old_mesh, prod_dim, tags, prod_arrays, &old_arrays),
+        sources.prods2pair_doms);
   }
+  if (sources.prods2cut_doms.exists()) {
+    gather_batch(make_transfer_batch(
+                     old_mesh, prod_dim + 1, tags, prod_arrays, &old_arrays),
+        sources.prods2cut_doms);
+  }
+  transfer_common_batch(old_mesh, new_mesh, prod_dim, same_ents2old_ents,
+      same_ents2new_ents, prods2new_ents, tags, prod_arrays, commons);
 }
 
-static void transfer_density_refine(Mesh* old_mesh, TransferOpts const& opts,
-    Mesh* new_mesh, LOs keys2edges, LOs keys2prods, LOs prods2new_ents,
-    LOs same_ents2old_ents, LOs same_ents2new_ents) {
-  auto dim = old_mesh->dim();
-  for (Int i = 0; i < old_mesh->ntags(dim); ++i) {
-    auto tagbase = old_mesh->get_tag(dim, i);
-    if (should_transfer_density(old_mesh, opts, dim, tagbase)) {
-      /* just inherit the density field */
-      transfer_inherit_refine(old_mesh, new_mesh, keys2edges, old_mesh->dim(),
-          keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
-          tagbase);
+static void transfer_inherit_refine(Mesh* old_mesh, Mesh* new_mesh,
+    Int prod_dim, LOs prods2new_ents, LOs same_ents2old_ents,
+    LOs same_ents2new_ents, RefineInheritSources const& sources,
+    std::vector<TagBase const*> const& tags) {
+  TransferCommons commons;
+  for (auto const& batch : batch_tags(old_mesh, tags)) {
+    switch (batch[0]->type()) {
+      case OMEGA_H_I8:
+        transfer_inherit_refine_batch<I8>(old_mesh, new_mesh, prod_dim,
+            prods2new_ents, same_ents2old_ents, same_ents2new_ents, sources,
+            batch, &commons);
+        break;
+      case OMEGA_H_I32:
+        transfer_inherit_refine_batch<I32>(old_mesh, new_mesh, prod_dim,
+            prods2new_ents, same_ents2old_ents, same_ents2new_ents, sources,
+            batch, &commons);
+        break;
+      case OMEGA_H_I64:
+        transfer_inherit_refine_batch<I64>(old_mesh, new_mesh, prod_dim,
+            prods2new_ents, same_ents2old_ents, same_ents2new_ents, sources,
+            batch, &commons);
+        break;
+      case OMEGA_H_F32:
+        transfer_inherit_refine_batch<F32>(old_mesh, new_mesh, prod_dim,
+            prods2new_ents, same_ents2old_ents, same_ents2new_ents, sources,
+            batch, &commons);
+        break;
+      case OMEGA_H_F64:
+        transfer_inherit_refine_batch<Real>(old_mesh, new_mesh, prod_dim,
+            prods2new_ents, same_ents2old_ents, same_ents2new_ents, sources,
+            batch, &commons);
+        break;
     }
   }
+  finish_transfer_commons(tags, commons);
 }
 
-static void transfer_pointwise_refine(Mesh* old_mesh, TransferOpts const& opts,
-    Mesh* new_mesh, LOs keys2edges, LOs keys2prods, LOs prods2new_ents,
-    LOs same_ents2old_ents, LOs same_ents2new_ents) {
-  auto dim = old_mesh->dim();
+template <typename T>
+void transfer_inherit_refine(Mesh* old_mesh, Mesh* new_mesh, LOs keys2edges,
+    Int prod_dim, LOs keys2prods, LOs prods2new_ents, LOs same_ents2old_ents,
+    LOs same_ents2new_ents, std::string const& name) {
+  auto old_tag = old_mesh->get_tag<T>(prod_dim, name);
+  auto const sources =
+      get_refine_inherit_sources(old_mesh, keys2edges, prod_dim, keys2prods);
+  transfer_inherit_refine(old_mesh, new_mesh, prod_dim, prods2new_ents,
+      same_ents2old_ents, same_ents2new_ents, sources,
+      std::vector<TagBase const*>{old_tag});
+}
+
+using ShouldTransfer = bool (*)(
+    Mesh*, TransferOpts const&, Int, TagBase const*);
+
+static std::vector<TagBase const*> get_transfer_tags(Mesh* old_mesh,
+    TransferOpts const& opts, Int dim, ShouldTransfer should_transfer) {
+  std::vector<TagBase const*> tags;
   for (Int i = 0; i < old_mesh->ntags(dim); ++i) {
     auto tagbase = old_mesh->get_tag(dim, i);
-    if (should_fit(old_mesh, opts, dim, tagbase)) {
-      transfer_inherit_refine(old_mesh, new_mesh, keys2edges, dim, keys2prods,
-          prods2new_ents, same_ents2old_ents, same_ents2new_ents, tagbase);
-    }
+    if (should_transfer(old_mesh, opts, dim, tagbase)) tags.push_back(tagbase);
   }
+  return tags;
+}
+
+/* densities (just inherited) and pointwise fields are inherited from the
+   same sources as the inherited tags, but they come after the size and
+   quality of the new elements */
+static void transfer_inherit_refine(Mesh* old_mesh, TransferOpts const& opts,
+    Mesh* new_mesh, Int prod_dim, LOs prods2new_ents, LOs same_ents2old_ents,
+    LOs same_ents2new_ents, RefineInheritSources const& sources,
+    ShouldTransfer should_transfer) {
+  auto const tags =
+      get_transfer_tags(old_mesh, opts, prod_dim, should_transfer);
+  if (tags.empty()) return;
+  transfer_inherit_refine(old_mesh, new_mesh, prod_dim, prods2new_ents,
+      same_ents2old_ents, same_ents2new_ents, sources, tags);
+}
+
+static bool should_inherit_refine(
+    Mesh* mesh, TransferOpts const& opts, Int dim, TagBase const* tag) {
+  return should_inherit(mesh, opts, dim, tag) ||
+         (dim == mesh->dim() && (should_transfer_density(mesh, opts, dim, tag) ||
+                                    should_fit(mesh, opts, dim, tag)));
 }
 
 void transfer_length(Mesh* old_mesh, Mesh* new_mesh, LOs same_ents2old_ents,
@@ -393,8 +771,15 @@ void transfer_refine(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
     LOs keys2edges, LOs keys2midverts, Int prod_dim, LOs keys2prods,
     LOs prods2new_ents, LOs same_ents2old_ents, LOs same_ents2new_ents) {
   begin_code("transfer_refine");
-  transfer_inherit_refine(old_mesh, opts, new_mesh, keys2edges, prod_dim,
-      keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents);
+  ScopedSameLayouts same_layouts;
+  RefineInheritSources sources;
+  if (!get_transfer_tags(old_mesh, opts, prod_dim, should_inherit_refine)
+           .empty()) {
+    sources =
+        get_refine_inherit_sources(old_mesh, keys2edges, prod_dim, keys2prods);
+  }
+  transfer_inherit_refine(old_mesh, opts, new_mesh, prod_dim, prods2new_ents,
+      same_ents2old_ents, same_ents2new_ents, sources, should_inherit);
   if (prod_dim == VERT) {
     transfer_linear_interp(old_mesh, opts, new_mesh, keys2edges, keys2midverts,
         same_ents2old_ents, same_ents2new_ents);
@@ -408,17 +793,20 @@ void transfer_refine(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
     transfer_face_flux(old_mesh, new_mesh, same_ents2old_ents,
         same_ents2new_ents, prods2new_ents);
   }
+  transfer_cavity_quality_caches(old_mesh, new_mesh, prod_dim,
+      same_ents2old_ents, same_ents2new_ents, prods2new_ents);
   if (prod_dim == old_mesh->dim()) {
     transfer_size(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
         prods2new_ents);
     transfer_quality(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
         prods2new_ents);
-    transfer_density_refine(old_mesh, opts, new_mesh, keys2edges, keys2prods,
-        prods2new_ents, same_ents2old_ents, same_ents2new_ents);
+    transfer_inherit_refine(old_mesh, opts, new_mesh, prod_dim, prods2new_ents,
+        same_ents2old_ents, same_ents2new_ents, sources,
+        should_transfer_density);
     transfer_conserve_refine(old_mesh, opts, new_mesh, keys2edges, keys2prods,
         prods2new_ents, same_ents2old_ents, same_ents2new_ents);
-    transfer_pointwise_refine(old_mesh, opts, new_mesh, keys2edges, keys2prods,
-        prods2new_ents, same_ents2old_ents, same_ents2new_ents);
+    transfer_inherit_refine(old_mesh, opts, new_mesh, prod_dim, prods2new_ents,
+        same_ents2old_ents, same_ents2new_ents, sources, should_fit);
   }
   if (opts.user_xfer) {
     opts.user_xfer->refine(*old_mesh, *new_mesh, keys2edges, keys2midverts,
@@ -428,50 +816,18 @@ void transfer_refine(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
   end_code();
 }
 
-template <typename T>
-static void transfer_inherit_coarsen_tmpl(Mesh* old_mesh, Mesh* new_mesh,
-    Adj keys2doms, Int prod_dim, LOs prods2new_ents, LOs same_ents2old_ents,
-    LOs same_ents2new_ents, TagBase const* tagbase) {
-  auto name = tagbase->name();
-  auto old_tag = as<T>(tagbase);
-  auto ncomps = old_tag->ncomps();
-  auto dom_data = old_tag->array();
-  auto key_doms2doms = keys2doms.ab2b;
-  auto prod_data = read(unmap(key_doms2doms, dom_data, ncomps));
-  transfer_common(old_mesh, new_mesh, prod_dim, same_ents2old_ents,
-      same_ents2new_ents, prods2new_ents, old_tag, prod_data);
-}
-
 static void transfer_inherit_coarsen(Mesh* old_mesh, TransferOpts const& opts,
     Mesh* new_mesh, Adj keys2doms, Int prod_dim, LOs prods2new_ents,
     LOs same_ents2old_ents, LOs same_ents2new_ents) {
+  std::vector<TagBase const*> tags;
   for (Int i = 0; i < old_mesh->ntags(prod_dim); ++i) {
     auto tagbase = old_mesh->get_tag(prod_dim, i);
     if (should_inherit(old_mesh, opts, prod_dim, tagbase)) {
-      switch (tagbase->type()) {
-        case OMEGA_H_I8:
-          transfer_inherit_coarsen_tmpl<I8>(old_mesh, new_mesh, keys2doms,
-              prod_dim, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
-              tagbase);
-          break;
-        case OMEGA_H_I32:
-          transfer_inherit_coarsen_tmpl<I32>(old_mesh, new_mesh, keys2doms,
-              prod_dim, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
-              tagbase);
-          break;
-        case OMEGA_H_I64:
-          transfer_inherit_coarsen_tmpl<I64>(old_mesh, new_mesh, keys2doms,
-              prod_dim, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
-              tagbase);
-          break;
-        case OMEGA_H_F64:
-          transfer_inherit_coarsen_tmpl<Real>(old_mesh, new_mesh, keys2doms,
-              prod_dim, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
-              tagbase);
-          break;
-      }
+      tags.push_back(tagbase);
     }
   }
+  transfer_inherit(old_mesh, new_mesh, prod_dim, prod_dim, keys2doms.ab2b,
+      prods2new_ents, same_ents2old_ents, same_ents2new_ents, tags);
 }
 
 template <typename T>
@@ -504,6 +860,10 @@ static void transfer_no_products(Mesh* old_mesh, TransferOpts const& opts,
           transfer_no_products_tmpl<I64>(old_mesh, new_mesh, prod_dim,
               same_ents2old_ents, same_ents2new_ents, tagbase);
           break;
+        case OMEGA_H_F32:
+          transfer_no_products_tmpl<F32>(old_mesh, new_mesh, prod_dim,
+              same_ents2old_ents, same_ents2new_ents, tagbase);
+          break;
         case OMEGA_H_F64:
           transfer_no_products_tmpl<Real>(old_mesh, new_mesh, prod_dim,
               same_ents2old_ents, same_ents2new_ents, tagbase);
@@ -513,14 +873,15 @@ static void transfer_no_products(Mesh* old_mesh, TransferOpts const& opts,
   }
 }
 
+/* each product takes the values of the old element of its key's cavity
+   that is closest to containing its centroid. the search is done once per
+   product for all the tags of the batch */
 template <Int dim>
-void transfer_pointwise_tmpl(Mesh* old_mesh, Mesh* new_mesh, Int key_dim,
-    LOs keys2kds, LOs keys2prods, LOs prods2new_elems, LOs same_elems2old_elems,
-    LOs same_elems2new_elems, TagBase const* tagbase) {
-  auto name = tagbase->name();
-  auto old_tag = as<Real>(tagbase);
-  auto ncomps = old_tag->ncomps();
-  auto old_data = old_tag->array();
+static void transfer_pointwise_tmpl(Mesh* old_mesh, Mesh* new_mesh,
+    Int key_dim, LOs keys2kds, LOs keys2prods, LOs prods2new_elems,
+    LOs same_elems2old_elems, LOs same_elems2new_elems,
+    std::vector<TagBase const*> const& tags, TransferCommons* commons) {
+  ScopedTimer timer("transfer_pointwise(batch)");
   auto kds2elems = old_mesh->ask_up(key_dim, dim);
   auto kds2kd_elems = kds2elems.a2ab;
   auto kd_elems2elems = kds2elems.ab2b;
@@ -530,7 +891,10 @@ void transfer_pointwise_tmpl(Mesh* old_mesh, Mesh* new_mesh, Int key_dim,
   auto new_coords = new_mesh->coords();
   auto nkeys = keys2kds.size();
   auto nprods = keys2prods.last();
-  auto prod_data_w = Write<Real>(nprods * ncomps);
+  auto const prod_arrays = make_prod_arrays<Real>(tags, nprods);
+  std::vector<Reals> old_arrays;
+  auto const batch =
+      make_transfer_batch(old_mesh, dim, tags, prod_arrays, &old_arrays);
   auto f = OMEGA_H_LAMBDA(LO key) {
     auto kd = keys2kds[key];
     for (auto prod = keys2prods[key]; prod < keys2prods[key + 1]; ++prod) {
@@ -551,42 +915,44 @@ void transfer_pointwise_tmpl(Mesh* old_mesh, Mesh* new_mesh, Int key_dim,
           best_distance = distance;
         }
       }
-      for (Int comp = 0; comp < ncomps; ++comp) {
-        prod_data_w[prod * ncomps + comp] =
-            old_data[best_old_elem * ncomps + comp];
+      for (Int t = 0; t < batch.ntags; ++t) {
+        for (Int comp = 0; comp < batch.ncomps; ++comp) {
+          batch.prod_data[t][prod * batch.ncomps + comp] =
+              batch.old_data[t][best_old_elem * batch.ncomps + comp];
+        }
       }
     }
   };
   parallel_for(nkeys, f, "transfer_pointwise");
-  auto prod_data = Reals(prod_data_w);
-  transfer_common(old_mesh, new_mesh, dim, same_elems2old_elems,
-      same_elems2new_elems, prods2new_elems, old_tag, prod_data);
+  transfer_common_batch(old_mesh, new_mesh, dim, same_elems2old_elems,
+      same_elems2new_elems, prods2new_elems, tags, prod_arrays, commons);
 }
 
 void transfer_pointwise(Mesh* old_mesh, TransferOpts const& opts,
     Mesh* new_mesh, Int key_dim, LOs keys2kds, LOs keys2prods,
     LOs prods2new_ents, LOs same_ents2old_ents, LOs same_ents2new_ents) {
   auto dim = new_mesh->dim();
-  for (Int i = 0; i < old_mesh->ntags(dim); ++i) {
-    auto tagbase = old_mesh->get_tag(dim, i);
-    if (should_fit(old_mesh, opts, dim, tagbase)) {
-      if (dim == 3) {
-        transfer_pointwise_tmpl<3>(old_mesh, new_mesh, key_dim, keys2kds,
-            keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
-            tagbase);
-      } else if (dim == 2) {
-        transfer_pointwise_tmpl<2>(old_mesh, new_mesh, key_dim, keys2kds,
-            keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
-            tagbase);
-      }
+  auto const tags = get_transfer_tags(old_mesh, opts, dim, should_fit);
+  TransferCommons commons;
+  for (auto const& batch : batch_tags(old_mesh, tags)) {
+    if (dim == 3) {
+      transfer_pointwise_tmpl<3>(old_mesh, new_mesh, key_dim, keys2kds,
+          keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
+          batch, &commons);
+    } else if (dim == 2) {
+      transfer_pointwise_tmpl<2>(old_mesh, new_mesh, key_dim, keys2kds,
+          keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
+          batch, &commons);
     }
   }
+  finish_transfer_commons(tags, commons);
 }
 
 void transfer_coarsen(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
     LOs keys2verts, Adj keys2doms, Int prod_dim, LOs prods2new_ents,
     LOs same_ents2old_ents, LOs same_ents2new_ents) {
   begin_code("transfer_coarsen");
+  ScopedSameLayouts same_layouts;
   if (prod_dim == VERT) {
     transfer_no_products(old_mesh, opts, new_mesh, prod_dim, same_ents2old_ents,
         same_ents2new_ents);
@@ -601,6 +967,8 @@ void transfer_coarsen(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
     transfer_face_flux(old_mesh, new_mesh, same_ents2old_ents,
         same_ents2new_ents, prods2new_ents);
   }
+  transfer_cavity_quality_caches(old_mesh, new_mesh, prod_dim,
+      same_ents2old_ents, same_ents2new_ents, prods2new_ents);
   if (prod_dim == old_mesh->dim()) {
     transfer_size(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
         prods2new_ents);
@@ -644,6 +1012,9 @@ void transfer_copy(
         case OMEGA_H_I64:
           transfer_copy_tmpl<I64>(new_mesh, prod_dim, tagbase);
           break;
+        case OMEGA_H_F32:
+          transfer_copy_tmpl<F32>(new_mesh, prod_dim, tagbase);
+          break;
         case OMEGA_H_F64:
           transfer_copy_tmpl<Real>(new_mesh, prod_dim, tagbase);
           break;
@@ -653,56 +1024,27 @@ void transfer_copy(
   if (opts.user_xfer) opts.user_xfer->swap_copy_verts(*old_mesh, *new_mesh);
 }
 
-template <typename T>
-static void transfer_inherit_swap_tmpl(Mesh* old_mesh, Mesh* new_mesh,
-    Int prod_dim, LOs keys2edges, LOs keys2prods, LOs prods2new_ents,
-    LOs same_ents2old_ents, LOs same_ents2new_ents, TagBase const* tagbase) {
-  auto const& name = tagbase->name();
-  auto old_tag = old_mesh->get_tag<T>(EDGE, name);
-  auto ncomps = old_tag->ncomps();
-  auto edge_data = old_tag->array();
-  auto key_data = read(unmap(keys2edges, edge_data, ncomps));
-  auto prod_data = expand(key_data, keys2prods, ncomps);
-  transfer_common(old_mesh, new_mesh, prod_dim, same_ents2old_ents,
-      same_ents2new_ents, prods2new_ents, old_tag, prod_data);
-}
-
 static void transfer_inherit_swap(Mesh* old_mesh, TransferOpts const& opts,
     Mesh* new_mesh, Int prod_dim, LOs keys2edges, LOs keys2prods,
     LOs prods2new_ents, LOs same_ents2old_ents, LOs same_ents2new_ents) {
+  std::vector<TagBase const*> tags;
   for (Int i = 0; i < old_mesh->ntags(prod_dim); ++i) {
     auto tagbase = old_mesh->get_tag(prod_dim, i);
     if (should_inherit(old_mesh, opts, prod_dim, tagbase)) {
-      switch (tagbase->type()) {
-        case OMEGA_H_I8:
-          transfer_inherit_swap_tmpl<I8>(old_mesh, new_mesh, prod_dim,
-              keys2edges, keys2prods, prods2new_ents, same_ents2old_ents,
-              same_ents2new_ents, tagbase);
-          break;
-        case OMEGA_H_I32:
-          transfer_inherit_swap_tmpl<I32>(old_mesh, new_mesh, prod_dim,
-              keys2edges, keys2prods, prods2new_ents, same_ents2old_ents,
-              same_ents2new_ents, tagbase);
-          break;
-        case OMEGA_H_I64:
-          transfer_inherit_swap_tmpl<I64>(old_mesh, new_mesh, prod_dim,
-              keys2edges, keys2prods, prods2new_ents, same_ents2old_ents,
-              same_ents2new_ents, tagbase);
-          break;
-        case OMEGA_H_F64:
-          transfer_inherit_swap_tmpl<Real>(old_mesh, new_mesh, prod_dim,
-              keys2edges, keys2prods, prods2new_ents, same_ents2old_ents,
-              same_ents2new_ents, tagbase);
-          break;
-      }
+      tags.push_back(tagbase);
     }
   }
+  if (tags.empty()) return;
+  auto prods2edges = expand(keys2edges, keys2prods, 1);
+  transfer_inherit(old_mesh, new_mesh, EDGE, prod_dim, prods2edges,
+      prods2new_ents, same_ents2old_ents, same_ents2new_ents, tags);
 }
 
 void transfer_swap(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
     Int prod_dim, LOs keys2edges, LOs keys2prods, LOs prods2new_ents,
     LOs same_ents2old_ents, LOs same_ents2new_ents) {
   begin_code("transfer_swap");
+  ScopedSameLayouts same_layouts;
   OMEGA_H_CHECK(prod_dim != VERT);
   transfer_inherit_swap(old_mesh, opts, new_mesh, prod_dim, keys2edges,
       keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents);
@@ -713,6 +1055,8 @@ void transfer_swap(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
     transfer_face_flux(old_mesh, new_mesh, same_ents2old_ents,
         same_ents2new_ents, prods2new_ents);
   }
+  transfer_cavity_quality_caches(old_mesh, new_mesh, prod_dim,
+      same_ents2old_ents, same_ents2new_ents, prods2new_ents);
   if (prod_dim == old_mesh->dim()) {
     transfer_size(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
         prods2new_ents);
@@ -746,6 +1090,7 @@ void transfer_swap(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
 INST(I8)
 INST(I32)
 INST(I64)
+INST(F32)
 INST(Real)
 #undef INST
 
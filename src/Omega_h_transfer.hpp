@@ -1,8 +1,12 @@
 #ifndef OMEGA_H_TRANSFER_HPP
 #define OMEGA_H_TRANSFER_HPP
 
+#include <vector>
+
 #include <Omega_h_adapt.hpp>
 #include <Omega_h_adj.hpp>
+#include <Omega_h_few.hpp>
+#include <Omega_h_mesh.hpp>
 #include <Omega_h_tag.hpp>
 
 namespace Omega_h {
@@ -63,6 +67,45 @@ void transfer_inherit_refine(Mesh* old_mesh, Mesh* new_mesh, LOs keys2edges,
     Int prod_dim, LOs keys2prods, LOs prods2new_ents, LOs same_ents2old_ents,
     LOs same_ents2new_ents, std::string const& name);
 
+/* tags transferred the same way are handled in batches of up to this
+   many tags of the same type and number of components. one kernel per
+   batch reads the keys and their cavities once for all its tags.
+   Library::transfer_batch_size() can lower the limit, down to 1 */
+constexpr Int TRANSFER_BATCH_SIZE = 8;
+
+/* groups tags by type and number of components, in order of appearance */
+std::vector<std::vector<TagBase const*>> batch_tags(
+    Mesh* mesh, std::vector<TagBase const*> const& tags);
+
+/* device pointers to the source arrays of a batch of tags and to the
+   arrays their transferred values are written to */
+template <typename T>
+struct TransferBatch {
+  Int ntags;
+  Int ncomps;
+  Few<T const*, TRANSFER_BATCH_SIZE> old_data;
+  Few<T*, TRANSFER_BATCH_SIZE> prod_data;
+};
+
+/* points to the arrays of a batch's tags on dimension old_dim and to
+   prod_arrays. old_arrays keeps the former alive */
+template <typename T>
+TransferBatch<T> make_transfer_batch(Mesh* old_mesh, Int old_dim,
+    std::vector<TagBase const*> const& tags,
+    std::vector<Write<T>> const& prod_arrays,
+    std::vector<Read<T>>* old_arrays) {
+  TransferBatch<T> batch;
+  batch.ntags = Int(tags.size());
+  batch.ncomps = tags[0]->ncomps();
+  for (Int i = 0; i < batch.ntags; ++i) {
+    auto const t = std::size_t(i);
+    old_arrays->push_back(old_mesh->get_array<T>(old_dim, tags[t]->name()));
+    batch.old_data[i] = old_arrays->back().data();
+    batch.prod_data[i] = prod_arrays[t].data();
+  }
+  return batch;
+}
+
 void transfer_length(Mesh* old_mesh, Mesh* new_mesh, LOs same_ents2old_ents,
     LOs same_ents2new_ents, LOs prods2new_ents);
 void transfer_quality(Mesh* old_mesh, Mesh* new_mesh, LOs same_ents2old_ents,
@@ -89,6 +132,7 @@ void transfer_pointwise(Mesh* old_mesh, TransferOpts const& opts,
 INST_DECL(I8)
 INST_DECL(I32)
 INST_DECL(I64)
+INST_DECL(F32)
 INST_DECL(Real)
 #undef INST_DECL
 
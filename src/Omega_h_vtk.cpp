@@ -90,6 +90,11 @@ struct IntTraits<false, 8> {
   inline static char const* name() { return "UInt64"; }
 };
 
+template <>
+struct FloatTraits<4> {
+  inline static char const* name() { return "Float32"; }
+};
+
 template <>
 struct FloatTraits<8> {
   inline static char const* name() { return "Float64"; }
@@ -137,6 +142,8 @@ static bool read_array_start_tag(std::istream& stream, Omega_h_Type* type_out,
     *type_out = OMEGA_H_I32;
   else if (type_name == "Int64")
     *type_out = OMEGA_H_I64;
+  else if (type_name == "Float32")
+    *type_out = OMEGA_H_F32;
   else if (type_name == "Float64")
     *type_out = OMEGA_H_F64;
   *name_out = st.attribs["Name"];
@@ -663,6 +670,9 @@ static void write_p_data_array2(std::ostream& stream, std::string const& name,
     case OMEGA_H_I64:
       write_p_data_array<I64>(stream, name, ncomps, array_type);
       break;
+    case OMEGA_H_F32:
+      write_p_data_array<F32>(stream, name, ncomps, array_type);
+      break;
     case OMEGA_H_F64:
       write_p_data_array<Real>(stream, name, ncomps, array_type);
       break;
@@ -1344,6 +1354,7 @@ void FullWriter::write() {
 OMEGA_H_EXPL_INST(I8)
 OMEGA_H_EXPL_INST(I32)
 OMEGA_H_EXPL_INST(I64)
+OMEGA_H_EXPL_INST(F32)
 OMEGA_H_EXPL_INST(Real)
 #undef OMEGA_H_EXPL_INST
 
@@ -16,7 +16,10 @@ void pybind11_adapt(py::module& module) {
       module, "AdaptOpts", "Options controlling adaptation behavior")
       .def(py::init<Mesh*>())
       .def_readwrite("verbosity", &AdaptOpts::verbosity)
-      .def_readwrite("min_quality_allowed", &AdaptOpts::min_quality_allowed);
+      .def_readwrite("min_quality_allowed", &AdaptOpts::min_quality_allowed)
+      .def_readwrite(
+          "should_randomize_indset", &AdaptOpts::should_randomize_indset)
+      .def_readwrite("indset_local_rounds", &AdaptOpts::indset_local_rounds);
   py::class_<MetricSource>(
       module, "MetricSource", "Describes a single source metric field")
       .def(py::init<Omega_h_Source, Real, std::string const&, Omega_h_Isotropy,
@@ -36,6 +39,8 @@ void pybind11_adapt(py::module& module) {
       .def_readwrite("max_gradation_rate", &MetricInput::max_gradation_rate)
       .def_readwrite("gradation_convergence_tolerance",
           &MetricInput::gradation_convergence_tolerance)
+      .def_readwrite("should_use_gradation_worklist",
+          &MetricInput::should_use_gradation_worklist)
       .def_readwrite("should_limit_element_count",
           &MetricInput::should_limit_element_count)
       .def_readwrite("max_element_count", &MetricInput::max_element_count)
@@ -0,0 +1,100 @@
+#include "Omega_h_adj.hpp"
+#include "Omega_h_array_ops.hpp"
+#include "Omega_h_build.hpp"
+#include "Omega_h_cmdline.hpp"
+#include "Omega_h_library.hpp"
+#include "Omega_h_mesh.hpp"
+#include "Omega_h_timer.hpp"
+
+#include <cstdio>
+
+using namespace Omega_h;
+
+static void check_same_entities(Mesh* mesh) {
+  auto const dim = mesh->dim();
+  auto const ev2v = mesh->ask_elem_verts();
+  for (Int ldim = 1; ldim < dim; ++ldim) {
+    disable_hashed_dedup();
+    auto const sorted_lv2v = find_unique(ev2v, mesh->family(), dim, ldim);
+    enable_hashed_dedup();
+    auto const hashed_lv2v = find_unique(ev2v, mesh->family(), dim, ldim);
+    OMEGA_H_CHECK(hashed_lv2v.size() == sorted_lv2v.size());
+    /* every use matches exactly one of the hashed entities */
+    disable_hashed_dedup();
+    reflect_down(
+        ev2v, hashed_lv2v, mesh->family(), mesh->nverts(), dim, ldim);
+    /* and both matching methods agree */
+    auto const sorted_down = reflect_down(
+        ev2v, sorted_lv2v, mesh->family(), mesh->nverts(), dim, ldim);
+    auto const hashed_down =
+        reflect_down_hashed(ev2v, sorted_lv2v, mesh->family(), dim, ldim);
+    OMEGA_H_CHECK(hashed_down.ab2b == sorted_down.ab2b);
+    OMEGA_H_CHECK(hashed_down.codes == sorted_down.codes);
+  }
+}
+
+static void check_build(Library* lib) {
+  enable_hashed_dedup();
+  auto hashed =
+      build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+  disable_hashed_dedup();
+  auto sorted =
+      build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+  for (Int dim = 0; dim <= 3; ++dim) {
+    OMEGA_H_CHECK(hashed.nents(dim) == sorted.nents(dim));
+  }
+  OMEGA_H_CHECK(hashed.ask_down(3, 1).ab2b.size() ==
+                sorted.ask_down(3, 1).ab2b.size());
+}
+
+static void benchmark(Mesh* mesh) {
+  auto const dim = mesh->dim();
+  auto const ev2v = mesh->ask_elem_verts();
+  std::printf("%d elements, %d vertices\n", mesh->nelems(), mesh->nverts());
+  for (Int ldim = 1; ldim < dim; ++ldim) {
+    disable_hashed_dedup();
+    auto t0 = now();
+    auto lv2v = find_unique(ev2v, mesh->family(), dim, ldim);
+    auto t1 = now();
+    reflect_down(ev2v, lv2v, mesh->family(), mesh->nverts(), dim, ldim);
+    auto t2 = now();
+    enable_hashed_dedup();
+    auto t3 = now();
+    lv2v = find_unique(ev2v, mesh->family(), dim, ldim);
+    auto t4 = now();
+    reflect_down(ev2v, lv2v, mesh->family(), mesh->nverts(), dim, ldim);
+    auto t5 = now();
+    disable_hashed_dedup();
+    std::printf("dim %d: find_unique sort %.3f s, hash %.3f s; "
+                "reflect_down sort %.3f s, hash %.3f s\n",
+        ldim, t1 - t0, t4 - t3, t2 - t1, t5 - t4);
+  }
+}
+
+int main(int argc, char** argv) {
+  auto lib = Library(&argc, &argv);
+  auto world = lib.world();
+  CmdLine cmdline;
+  auto& benchmark_flag = cmdline.add_flag(
+      "--benchmark", "time both methods on an n x n x n box of tetrahedra");
+  benchmark_flag.add_arg<int>("n");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  auto const was_enabled = is_hashed_dedup_enabled();
+  {
+    auto mesh = build_box(world, OMEGA_H_SIMPLEX, 1., 1., 1., 4, 4, 4);
+    check_same_entities(&mesh);
+  }
+  {
+    auto mesh = build_box(world, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+    check_same_entities(&mesh);
+  }
+  check_build(&lib);
+  if (cmdline.parsed("--benchmark")) {
+    auto const n = cmdline.get<int>("--benchmark", "n");
+    disable_hashed_dedup();
+    auto mesh = build_box(world, OMEGA_H_SIMPLEX, 1., 1., 1., n, n, n);
+    benchmark(&mesh);
+  }
+  if (was_enabled) enable_hashed_dedup();
+  return 0;
+}
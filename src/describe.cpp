@@ -103,6 +103,8 @@ int main(int argc, char** argv)
                 printTagInfo<Omega_h::I32>(mesh, oss, dim, tag, "I32");
             if (tagbase->type() == OMEGA_H_I64)
                 printTagInfo<Omega_h::I64>(mesh, oss, dim, tag, "I64");
+            if (tagbase->type() == OMEGA_H_F32)
+                printTagInfo<Omega_h::F32>(mesh, oss, dim, tag, "F32");
             if (tagbase->type() == OMEGA_H_F64)
                 printTagInfo<Omega_h::Real>(mesh, oss, dim, tag, "F64");
         }
@@ -150,6 +152,8 @@ int main(int argc, char** argv)
             numEq = getNumEq<Omega_h::I32>(mesh, name, dim, value);
         if (tagbase->type() == OMEGA_H_I64)
             numEq = getNumEq<Omega_h::I64>(mesh, name, dim, value);
+        if (tagbase->type() == OMEGA_H_F32)
+            numEq = getNumEq<Omega_h::F32>(mesh, name, dim, value);
         if (tagbase->type() == OMEGA_H_F64)
             numEq = getNumEq<Omega_h::Real>(mesh, name, dim, value);
         
@@ -2,10 +2,74 @@
 #include "Omega_h_library.hpp"
 #include <Omega_h_file.hpp>
 #include <Omega_h_array.hpp>
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_for.hpp>
+#include <Omega_h_mesh.hpp>
 #include <Omega_h_remotes.hpp>
+#include <Omega_h_tag.hpp>
+#include <Omega_h_timer.hpp>
+
+#include <iostream>
 
 using namespace Omega_h;
 
+template <typename T>
+static Read<T> get_tag_values(GOs globals, Int ncomps, Int seed) {
+  Write<T> values(globals.size() * ncomps);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    for (Int c = 0; c < ncomps; ++c) {
+      values[i * ncomps + c] = T(globals[i] * 7 + c + seed);
+    }
+  };
+  parallel_for(globals.size(), f);
+  return values;
+}
+
+static Omega_h_Type const test_tag_types[] = {
+    OMEGA_H_I8, OMEGA_H_I32, OMEGA_H_I64, OMEGA_H_F64};
+
+/* tags of every type and a few widths on each dimension, either added
+   to the mesh or checked against the values they were added with */
+static void apply_test_tags(Mesh* mesh, Int ntags, bool add) {
+  for (Int dim = 0; dim <= mesh->dim(); ++dim) {
+    auto const globals = mesh->globals(dim);
+    for (Int i = 0; i < ntags; ++i) {
+      auto const name = "tag_" + std::to_string(i);
+      auto const ncomps = 1 + i % 3;
+      apply_to_omega_h_types(test_tag_types[i % 4], [&](auto t) {
+        using T = decltype(t);
+        auto const values = get_tag_values<T>(globals, ncomps, i);
+        if (add) {
+          mesh->add_tag(dim, name, ncomps, values);
+        } else {
+          OMEGA_H_CHECK(mesh->get_array<T>(dim, name) == values);
+        }
+      });
+    }
+  }
+}
+
+/* times ghosting and rebalancing a mesh that carries many tags, each
+   of which has to arrive with the entities it belongs to */
+static void time_tagged_migration(CommPtr world) {
+  auto mesh = build_box(world, OMEGA_H_SIMPLEX, 1., 1., 0., 64, 64, 0);
+  Int const ntags = 32;
+  apply_test_tags(&mesh, ntags, true);
+  auto const t0 = now();
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto const t1 = now();
+  apply_test_tags(&mesh, ntags, false);
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  auto const t2 = now();
+  mesh.balance();
+  auto const t3 = now();
+  apply_test_tags(&mesh, ntags, false);
+  if (world->rank() == 0) {
+    std::cout << "migrating " << ntags << " tags per dimension: ghosting "
+              << (t1 - t0) << " s, balancing " << (t3 - t2) << " s\n";
+  }
+}
+
 int main(int argc, char** argv) {
   auto lib = Library(&argc, &argv);
   auto world = lib.world();
@@ -38,6 +102,7 @@ int main(int argc, char** argv) {
     OMEGA_H_CHECK(mesh.nelems()==3);
   }
   Omega_h::vtk::write_parallel("box_after.vtk", &mesh, mesh.dim());
+  time_tagged_migration(world);
   return 0;
 }
 
@@ -1,13 +1,20 @@
+#include <Omega_h_arena.hpp>
 #include <Omega_h_array_ops.hpp>
 #include <Omega_h_bipart.hpp>
 #include <Omega_h_build.hpp>
 #include <Omega_h_compare.hpp>
 #include <Omega_h_for.hpp>
 #include <Omega_h_inertia.hpp>
+#include <Omega_h_laplace.hpp>
+#include <Omega_h_map.hpp>
+#include <Omega_h_mark.hpp>
+#include <Omega_h_metric.hpp>
 #include <Omega_h_owners.hpp>
 #include <Omega_h_vtk.hpp>
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
 
 using namespace Omega_h;
 
@@ -315,6 +322,51 @@ static void test_two_ranks_exch_sum(CommPtr comm) {
   }
 }
 
+/* the same pattern as test_two_ranks_dist() and test_two_ranks_exch_sum(),
+   repeated through plans that reuse their buffers */
+static void test_two_ranks_exch_plan(CommPtr comm) {
+  Dist dist;
+  dist.set_parent_comm(comm);
+  if (comm->rank() == 0) {
+    dist.set_dest_ranks(Read<I32>({1, 1, 0}));
+    dist.set_dest_idxs(LOs({1, 0, 2}), 3);
+  } else {
+    dist.set_dest_ranks(Read<I32>({0, 0}));
+    dist.set_dest_idxs(LOs({1, 0}), 2);
+  }
+  ExchPlan<Real> plan(dist, 2);
+  ExchPlan<Real> inverse_plan(dist.invert(), 2);
+  for (Real i = 0.; i < 3.; ++i) {
+    Reals a;
+    if (comm->rank() == 0) {
+      a = Reals({0., i, 1., i, 2., i});
+    } else {
+      a = Reals({3., i, 4., i});
+    }
+    auto b = plan.exch(a);
+    OMEGA_H_CHECK(b == dist.exch(a, 2));
+    OMEGA_H_CHECK(inverse_plan.exch(b) == a);
+  }
+  Dist sum_dist;
+  sum_dist.set_parent_comm(comm);
+  if (comm->rank() == 0) {
+    sum_dist.set_dest_ranks(Read<I32>({0, 0, 0}));
+    sum_dist.set_dest_idxs(LOs({0, 1, 2}), 3);
+  } else {
+    sum_dist.set_dest_ranks(Read<I32>({0, 0, 1}));
+    sum_dist.set_dest_idxs(LOs({1, 2, 0}), 1);
+  }
+  ExchPlan<LO> sum_plan(sum_dist, 1);
+  for (LO i = 1; i < 3; ++i) {
+    auto recvd = sum_plan.exch_reduce(LOs({i, i, i}), OMEGA_H_SUM);
+    if (comm->rank() == 0) {
+      OMEGA_H_CHECK(recvd == LOs({i, 2 * i, 2 * i}));
+    } else {
+      OMEGA_H_CHECK(recvd == LOs({i}));
+    }
+  }
+}
+
 static void test_two_ranks_owners(CommPtr comm) {
   test_two_ranks_eq_owners(comm);
   test_two_ranks_uneq_owners(comm);
@@ -401,6 +453,7 @@ static void test_two_ranks(Library* lib, CommPtr comm) {
   test_two_ranks_owners(comm);
   test_two_ranks_bipart(comm);
   test_two_ranks_exch_sum(comm);
+  test_two_ranks_exch_plan(comm);
   test_resolve_derived(comm);
   test_construct(lib, comm);
   test_read_vtu(lib, comm);
@@ -437,6 +490,332 @@ void test_rib(CommPtr comm) {
   OMEGA_H_CHECK(masses == Reals(n, 1));
 }
 
+/* every rank sends to every rank, a different number of items to each */
+static Dist build_all_to_all_dist(CommPtr comm) {
+  auto const rank = comm->rank();
+  auto const size = comm->size();
+  std::vector<I32> ranks;
+  for (I32 k = 0; k < size; ++k) {
+    auto const dst = (rank + k) % size;
+    for (I32 j = 0; j <= (rank + dst) % 3; ++j) ranks.push_back(dst);
+  }
+  auto const n = LO(ranks.size());
+  HostWrite<I32> h_ranks(n);
+  HostWrite<LO> h_idxs(n);
+  for (LO i = 0; i < n; ++i) {
+    h_ranks[i] = ranks[std::size_t(i)];
+    h_idxs[i] = (rank * 7 + i) % 5;
+  }
+  Dist dist;
+  dist.set_parent_comm(comm);
+  dist.set_dest_ranks(h_ranks.write());
+  dist.set_dest_idxs(h_idxs.write(), 5);
+  return dist;
+}
+
+/* the values received by each destination root, sorted by item */
+static std::vector<std::vector<Real>> sort_per_root(
+    Dist const& dist, Reals recvd, Int width) {
+  auto const roots2items = HostRead<LO>(dist.invert().roots2items());
+  auto const h_recvd = HostRead<Real>(recvd);
+  std::vector<std::vector<Real>> out;
+  for (LO root = 0; root + 1 < roots2items.size(); ++root) {
+    std::vector<std::vector<Real>> items;
+    for (auto item = roots2items[root]; item < roots2items[root + 1]; ++item) {
+      std::vector<Real> values;
+      for (Int c = 0; c < width; ++c) {
+        values.push_back(h_recvd[item * width + c]);
+      }
+      items.push_back(values);
+    }
+    std::sort(items.begin(), items.end());
+    std::vector<Real> root_values;
+    for (auto const& values : items) {
+      root_values.insert(root_values.end(), values.begin(), values.end());
+    }
+    out.push_back(root_values);
+  }
+  return out;
+}
+
+static void test_node_aware_dist(Library* lib, CommPtr comm, I32 node_size) {
+  auto flat = build_all_to_all_dist(comm);
+  lib->set_node_aware_comm(true, node_size);
+  auto aware = build_all_to_all_dist(comm);
+  lib->set_node_aware_comm(false);
+  OMEGA_H_CHECK(!flat.is_node_aware());
+  OMEGA_H_CHECK(aware.is_node_aware() == (comm->size() > 1));
+  auto const n = flat.nitems();
+  Write<Real> w(n * 2);
+  auto const rank = comm->rank();
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    w[i * 2 + 0] = rank * 100 + i;
+    w[i * 2 + 1] = -i;
+  };
+  parallel_for(n, f);
+  auto const a = Reals(w);
+  /* the order of messages follows the order in which the graph
+     communicators discovered their sources, so the items of each root
+     are compared as sets */
+  OMEGA_H_CHECK(sort_per_root(aware, aware.exch(a, 2), 2) ==
+                sort_per_root(flat, flat.exch(a, 2), 2));
+  OMEGA_H_CHECK(aware.exch_reduce(a, 2, OMEGA_H_MAX) ==
+                flat.exch_reduce(a, 2, OMEGA_H_MAX));
+  OMEGA_H_CHECK(aware.exch_reduce(a, 2, OMEGA_H_MIN) ==
+                flat.exch_reduce(a, 2, OMEGA_H_MIN));
+  auto const ones = LOs(n, 1);
+  OMEGA_H_CHECK(aware.exch_reduce(ones, 1, OMEGA_H_SUM) ==
+                flat.exch_reduce(ones, 1, OMEGA_H_SUM));
+  auto const roots = Reals(5, 1.0);
+  OMEGA_H_CHECK(aware.invert().exch(roots, 1) == flat.invert().exch(roots, 1));
+  OMEGA_H_CHECK(aware.items2dests().idxs == flat.items2dests().idxs);
+}
+
+/* a mesh built with node-aware Dists is the same mesh */
+static void test_node_aware_mesh(Library* lib, CommPtr comm, I32 node_size) {
+  auto flat = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+  flat.set_parting(OMEGA_H_GHOSTED);
+  lib->set_node_aware_comm(true, node_size);
+  auto aware = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+  aware.set_parting(OMEGA_H_GHOSTED);
+  OMEGA_H_CHECK(aware.coords() == flat.coords());
+  OMEGA_H_CHECK(aware.globals(VERT) == flat.globals(VERT));
+  auto const globals = aware.globals(FACE);
+  OMEGA_H_CHECK(aware.sync_array(FACE, globals, 1) == globals);
+  lib->set_node_aware_comm(false);
+}
+
+/* the worklist limits gradation like the Jacobi sweeps do, also when
+   vertices are shared between ranks. the slow rate carries the corner's
+   refinement into parts that don't see the corner */
+static void test_gradation_worklist(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 16, 16, 0);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  OMEGA_H_CHECK(mesh.could_be_shared(VERT) == (comm->size() > 1));
+  auto coords = mesh.coords();
+  Write<Real> metrics_w(mesh.nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto x = get_vector<2>(coords, v);
+    auto h = (norm(x) < 0.1) ? 0.005 : 0.5;
+    metrics_w[v] = metric_eigenvalue_from_length(h);
+  };
+  parallel_for(mesh.nverts(), f);
+  auto metrics = Reals(metrics_w);
+  auto jacobi = limit_metric_gradation(&mesh, metrics, 0.2, 1e-6);
+  auto worklist = limit_metric_gradation_worklist(&mesh, metrics, 0.2, 1e-6);
+  OMEGA_H_CHECK(!comm->reduce_and(are_close(jacobi, metrics)));
+  OMEGA_H_CHECK(comm->reduce_and(are_close(jacobi, worklist, 1e-4)));
+  /* copies agree with their owners */
+  OMEGA_H_CHECK(mesh.sync_array(VERT, worklist, 1) == worklist);
+}
+
+/* a linear field is harmonic on the symmetric stencils of build_box */
+static void test_laplacian(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto coords = mesh.coords();
+  auto interior = mark_by_class_dim(&mesh, VERT, mesh.dim());
+  Write<Real> initial_w(mesh.nverts() * 2);
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto x = get_vector<2>(coords, v);
+    auto fx = interior[v] ? 0.0 : (2.0 * x[0] + x[1]);
+    auto fy = interior[v] ? 0.0 : (1.0 - x[1]);
+    initial_w[v * 2 + 0] = fx;
+    initial_w[v * 2 + 1] = fy;
+  };
+  parallel_for(mesh.nverts(), f);
+  auto solution = solve_laplacian(&mesh, initial_w, 2, 1e-10);
+  Write<Real> expected_w(mesh.nverts() * 2);
+  auto g = OMEGA_H_LAMBDA(LO v) {
+    auto x = get_vector<2>(coords, v);
+    expected_w[v * 2 + 0] = 2.0 * x[0] + x[1];
+    expected_w[v * 2 + 1] = 1.0 - x[1];
+  };
+  parallel_for(mesh.nverts(), g);
+  OMEGA_H_CHECK(
+      comm->reduce_and(are_close(solution, Reals(expected_w), 1e-8, 1e-8)));
+}
+
+/* the packed exchanges of arrays and tags of mixed types and widths
+   agree with one exchange per array */
+static void test_packed_sync(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  OMEGA_H_CHECK(mesh.could_be_shared(VERT) == (comm->size() > 1));
+  auto owned = mesh.owned(VERT);
+  auto globals = mesh.globals(VERT);
+  auto nverts = mesh.nverts();
+  Write<I8> i8(nverts);
+  Write<I32> i32(nverts * 2);
+  Write<I64> i64(nverts);
+  Write<F32> f32(nverts * 3);
+  Write<Real> f64(nverts * 2);
+  /* copies start out wrong so that syncing changes them */
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto g = owned[v] ? globals[v] : GO(-1);
+    i8[v] = I8(g % 100);
+    for (Int c = 0; c < 2; ++c) i32[v * 2 + c] = I32(g * 2 + c);
+    i64[v] = g * 1000000000000;
+    for (Int c = 0; c < 3; ++c) f32[v * 3 + c] = F32(g) + F32(c) / 4;
+    for (Int c = 0; c < 2; ++c) f64[v * 2 + c] = Real(g) / 3 + c;
+  };
+  parallel_for(nverts, f);
+  std::vector<AnyArray> const arrays = {AnyArray(read(i8), 1),
+      AnyArray(read(i32), 2), AnyArray(read(i64), 1), AnyArray(read(f32), 3),
+      AnyArray(read(f64), 2)};
+  auto are_same = [](AnyArray const& a, AnyArray const& b) {
+    if (a.type() != b.type() || a.ncomps() != b.ncomps()) return false;
+    auto f2 = [&](auto type) {
+      using T = decltype(type);
+      return a.get<T>() == b.get<T>();
+    };
+    return apply_to_omega_h_types(a.type(), std::move(f2));
+  };
+  auto check_same = [&](std::vector<AnyArray> const& a,
+                        std::vector<AnyArray> const& b) {
+    OMEGA_H_CHECK(a.size() == b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      OMEGA_H_CHECK(are_same(a[i], b[i]));
+    }
+  };
+  /* each array on its own, with sync_array() or reduce_array() */
+  auto one_by_one = [&](bool is_reduce, Omega_h_Op op) {
+    std::vector<AnyArray> out;
+    for (auto const& a : arrays) {
+      auto f2 = [&](auto type) {
+        using T = decltype(type);
+        auto const x = a.get<T>();
+        auto const y = is_reduce ? mesh.reduce_array(VERT, x, a.ncomps(), op)
+                                 : mesh.sync_array(VERT, x, a.ncomps());
+        out.push_back(AnyArray(y, a.ncomps()));
+      };
+      apply_to_omega_h_types(a.type(), std::move(f2));
+    }
+    return out;
+  };
+  auto const synced = one_by_one(false, OMEGA_H_MAX);
+  if (comm->size() > 1) {
+    for (std::size_t i = 0; i < arrays.size(); ++i) {
+      OMEGA_H_CHECK(comm->reduce_or(!are_same(synced[i], arrays[i])));
+    }
+  }
+  check_same(mesh.sync_arrays(VERT, arrays), synced);
+  for (auto op : {OMEGA_H_MIN, OMEGA_H_MAX, OMEGA_H_SUM}) {
+    check_same(mesh.reduce_arrays(VERT, arrays, op), one_by_one(true, op));
+  }
+  bool called_back = false;
+  auto future = mesh.isync_arrays(
+      VERT, arrays, [&](std::vector<AnyArray> const& out) {
+        called_back = true;
+        check_same(out, synced);
+      });
+  while (!future.completed()) {
+  }
+  check_same(future.get(), synced);
+  OMEGA_H_CHECK(called_back);
+  /* and the same through tags */
+  std::vector<std::string> const names = {"i8", "i32", "i64", "f32", "f64"};
+  auto add_tags = [&](std::string const& suffix) {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      auto f2 = [&](auto type) {
+        using T = decltype(type);
+        mesh.add_tag(VERT, names[i] + suffix, arrays[i].ncomps(),
+            arrays[i].get<T>());
+      };
+      apply_to_omega_h_types(arrays[i].type(), std::move(f2));
+    }
+  };
+  auto with_suffix = [&](std::string const& suffix) {
+    auto out = names;
+    for (auto& name : out) name += suffix;
+    return out;
+  };
+  auto get_tags = [&](std::string const& suffix) {
+    std::vector<AnyArray> out;
+    for (auto const& name : with_suffix(suffix)) {
+      auto tag = mesh.get_tagbase(VERT, name);
+      auto f2 = [&](auto type) {
+        using T = decltype(type);
+        out.push_back(AnyArray(as<T>(tag)->array(), tag->ncomps()));
+      };
+      apply_to_omega_h_types(tag->type(), std::move(f2));
+    }
+    return out;
+  };
+  add_tags("_sync");
+  mesh.sync_tags(VERT, with_suffix("_sync"));
+  check_same(get_tags("_sync"), synced);
+  add_tags("_isync");
+  mesh.isync_tags(VERT, with_suffix("_isync")).get();
+  check_same(get_tags("_isync"), synced);
+  add_tags("_reduce");
+  mesh.reduce_tags(VERT, with_suffix("_reduce"), OMEGA_H_MAX);
+  check_same(get_tags("_reduce"), one_by_one(true, OMEGA_H_MAX));
+}
+
+/* the owned entities split into the part boundary, those with copies
+   elsewhere, and the part interior. an exchange from the boundary
+   alone gives what sync_array() does */
+static void test_part_split(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  for (Int dim = 0; dim <= mesh.dim(); ++dim) {
+    auto owned = mesh.owned(dim);
+    auto boundary = mesh.ask_part_boundary(dim);
+    auto interior = mesh.ask_part_interior(dim);
+    auto nents = mesh.nents(dim);
+    OMEGA_H_CHECK(comm->reduce_or(boundary.size() > 0) == (comm->size() > 1));
+    /* together they are the owned entities, each once */
+    auto counts = Write<LO>(nents, 0);
+    map_into(LOs(boundary.size(), 1), boundary, counts, 1);
+    map_into(LOs(interior.size(), 1), interior, counts, 1);
+    OMEGA_H_CHECK(read(counts) == array_cast<I32>(owned));
+    /* copies start out wrong, and interior entries are only set after
+       the exchange has started */
+    auto globals = mesh.globals(dim);
+    auto expected = mesh.sync_array(dim, globals, 1);
+    auto a = Write<GO>(nents, GO(-1));
+    auto set_at = [&](LOs ents) {
+      auto f = OMEGA_H_LAMBDA(LO i) { a[ents[i]] = globals[ents[i]]; };
+      parallel_for(ents.size(), f);
+    };
+    set_at(boundary);
+    auto future = mesh.isync_part_boundary(dim, a, 1);
+    set_at(interior);
+    OMEGA_H_CHECK(future.get() == expected);
+  }
+}
+
+/* the Dists and exchange plans a mesh keeps don't come from an arena,
+   which they would outlive */
+static void test_exch_plan_in_arena(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto const globals = mesh.globals(FACE);
+  mesh.ask_owners(FACE);
+  {
+    ScopedArena arena;
+    mesh.ask_exch_plan<GO>(FACE, 5, true);
+    mesh.ask_exch_plan<GO>(FACE, 5, false);
+    OMEGA_H_CHECK(arena.nallocs() == 0);
+  }
+  OMEGA_H_CHECK(mesh.sync_array(FACE, globals, 1) == globals);
+}
+
+static void test_node_aware(Library* lib, CommPtr comm) {
+  /* one rank per node sends everything through leaders, two per node
+     mixes direct and leader messages, zero asks MPI */
+  for (I32 node_size = 0; node_size <= 2; ++node_size) {
+    auto const leader = comm->node_leader(node_size);
+    if (node_size > 0) {
+      OMEGA_H_CHECK(leader == comm->rank() - comm->rank() % node_size);
+    }
+    OMEGA_H_CHECK(comm->node_leader(node_size) == leader);
+    test_node_aware_dist(lib, comm, node_size);
+    test_node_aware_mesh(lib, comm, node_size);
+  }
+}
+
 int main(int argc, char** argv) {
   auto lib = Library(&argc, &argv);
   auto world = lib.world();
@@ -456,4 +835,10 @@ int main(int argc, char** argv) {
   }
   world->barrier();
   test_rib(world);
+  test_node_aware(&lib, world);
+  test_exch_plan_in_arena(world);
+  test_gradation_worklist(world);
+  test_laplacian(world);
+  test_packed_sync(world);
+  test_part_split(world);
 }
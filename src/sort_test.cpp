@@ -5,8 +5,48 @@
 #include "Omega_h_file.hpp"
 #include "Omega_h_atomics.hpp"
 #include "Omega_h_for.hpp"
+#include "Omega_h_timer.hpp"
+#include <cstdio>
 #include <fstream>
 
+/* keys that look like the vertex tuples of entity uses:
+   width entries in [0, nkeys), in no particular order */
+template <typename T>
+static Omega_h::Read<T> make_benchmark_keys(
+    Omega_h::LO nkeys, Omega_h::Int width) {
+  using namespace Omega_h;
+  Write<T> keys(nkeys * width);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto h = std::uint64_t(i) * 0x9E3779B97F4A7C15ULL;
+    for (Int j = 0; j < width; ++j) {
+      h ^= h >> 29;
+      h *= 0xBF58476D1CE4E5B9ULL;
+      keys[i * width + j] = T(h % std::uint64_t(nkeys));
+    }
+  };
+  parallel_for(nkeys, f);
+  return keys;
+}
+
+template <typename T>
+static void benchmark_sort(
+    Omega_h::LO nkeys, Omega_h::Int width, char const* type_name) {
+  using namespace Omega_h;
+  auto keys = make_benchmark_keys<T>(nkeys, width);
+  auto t0 = now();
+  auto comparison_perm = comparison_sort_by_keys(keys, width);
+  auto t1 = now();
+  auto radix_perm = radix_sort_by_keys(keys, width);
+  auto t2 = now();
+  auto comparison_time = t1 - t0;
+  auto radix_time = t2 - t1;
+  std::printf(
+      "%s keys, width %d: comparison %.3f s, radix %.3f s, speedup %.2f\n",
+      type_name, width, comparison_time, radix_time,
+      comparison_time / radix_time);
+  OMEGA_H_CHECK(radix_perm == comparison_perm);
+}
+
 int main(int argc, char** argv) {
   using namespace Omega_h;
   auto lib = Library(&argc, &argv);
@@ -14,7 +54,22 @@ int main(int argc, char** argv) {
   Omega_h::CmdLine cmdline;
   cmdline.add_arg<std::string>("array-in");
   cmdline.add_arg<std::string>("gold-array-in");
+  auto& benchmark_flag = cmdline.add_flag("--benchmark",
+      "time the radix and comparison sorts on this many keys");
+  benchmark_flag.add_arg<int>("nkeys");
   if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  if (cmdline.parsed("--benchmark")) {
+    LO nkeys = cmdline.get<int>("--benchmark", "nkeys");
+    for (Int width = 1; width <= 3; ++width) {
+      benchmark_sort<LO>(nkeys, width, "LO");
+      benchmark_sort<GO>(nkeys, width, "GO");
+    }
+  }
+  {
+    GOs a({-3, 7, -3, 5, 2, -8});
+    OMEGA_H_CHECK(radix_sort_by_keys(a) == LOs({5, 0, 2, 4, 3, 1}));
+    OMEGA_H_CHECK(radix_sort_by_keys(a, 2) == LOs({1, 0, 2}));
+  }
   {
     LOs a({0, 2, 0, 1});
     LOs perm = sort_by_keys(a,1);
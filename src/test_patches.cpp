@@ -1,7 +1,10 @@
 #include <Omega_h_file.hpp>
 #include <Omega_h_library.hpp>
 #include <Omega_h_mesh.hpp>
+#include <Omega_h_array_ops.hpp> //get_min
 #include <Omega_h_build.hpp> //build_box
+#include <Omega_h_map.hpp> //get_degrees
+#include <Omega_h_patches.hpp> //get_bridge_graph
 
 using namespace Omega_h;
 
@@ -67,6 +70,31 @@ void test3D(Omega_h::CommPtr comm) {
   OMEGA_H_CHECK(patches.nnodes() != -1);
 }
 
+void testBridges(Omega_h::CommPtr comm) {
+  OMEGA_H_CHECK(comm->size() == 1);
+  auto mesh = Omega_h::build_box(comm, OMEGA_H_SIMPLEX, 1.0, 1.0, 1.0, 2, 2, 2);
+  //through faces, the same neighbors as the dual graph
+  auto faces = get_bridge_graph(&mesh, REGION, FACE);
+  auto dual = mesh.ask_dual();
+  OMEGA_H_CHECK(faces.a2ab == dual.a2ab);
+  //through vertices, a superset of the neighbors through edges
+  auto edges = get_bridge_graph(&mesh, REGION, EDGE);
+  auto verts = get_bridge_graph(&mesh, REGION, VERT);
+  OMEGA_H_CHECK(faces.nedges() < edges.nedges());
+  OMEGA_H_CHECK(edges.nedges() < verts.nedges());
+  const auto minPatchSize = 20;
+  auto patches = mesh.get_vtx_patches(minPatchSize, REGION, EDGE);
+  OMEGA_H_CHECK(patches.nnodes() == mesh.nverts());
+  OMEGA_H_CHECK(get_min(get_degrees(patches.a2ab)) >= minPatchSize);
+  //the second call is answered from the cache
+  const auto bytes = mesh.cache_bytes();
+  auto again = mesh.get_vtx_patches(minPatchSize, REGION, EDGE);
+  OMEGA_H_CHECK(again.ab2b.data() == patches.ab2b.data());
+  OMEGA_H_CHECK(mesh.cache_bytes() == bytes);
+  auto byFaces = mesh.get_vtx_patches(minPatchSize);
+  OMEGA_H_CHECK(get_min(get_degrees(byFaces.a2ab)) >= minPatchSize);
+}
+
 void testPar(Omega_h::CommPtr comm) {
   OMEGA_H_CHECK(comm->size() == 4);
   const auto x = 1.0;
@@ -103,6 +131,7 @@ int main(int argc, char** argv) {
     test2x2(lib.self());
     test1x5(lib.self());
     test3D(lib.self());
+    testBridges(lib.self());
   }
   if (world->size() == 4) {
     testPar(world);
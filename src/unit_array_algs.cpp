@@ -1,17 +1,25 @@
 #include "Omega_h_adj.hpp"
 #include "Omega_h_align.hpp"
+#include "Omega_h_arena.hpp"
+#include "Omega_h_array_expr.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_expr.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_int_scan.hpp"
 #include "Omega_h_library.hpp"
 #include "Omega_h_linpart.hpp"
+#include "Omega_h_malloc.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mark.hpp"
+#include "Omega_h_pool.hpp"
 #include "Omega_h_sort.hpp"
+#include "Omega_h_thread_pool.hpp"
 #include "Omega_h_atomics.hpp"
 #include "Omega_h_file.hpp"
+#include <cstring>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 using namespace Omega_h;
 
@@ -420,6 +428,188 @@ static void test_filter_marked() {
   }
 }
 
+static void test_pool() {
+  OMEGA_H_CHECK(pool_size_class(0) == pool_size_class(1));
+  for (std::size_t size = 1; size < 100000; size = size * 3 / 2 + 1) {
+    auto const block_size = pool_class_size(pool_size_class(size));
+    OMEGA_H_CHECK(block_size >= size);
+    OMEGA_H_CHECK(size < 4 || block_size <= size + size / 4);
+  }
+  Pool pool(host_malloc, host_free);
+  auto a = allocate(pool, 1000);
+  auto b = allocate(pool, 1100);
+  auto c = allocate(pool, 1000);
+  OMEGA_H_CHECK(pool.stats.bytes_requested == 3100);
+  OMEGA_H_CHECK(pool.stats.misses == 3);
+  deallocate(pool, b, 1100);
+  deallocate(pool, a, 1000);
+  auto d = allocate(pool, 1000);
+  OMEGA_H_CHECK(d == a);
+  OMEGA_H_CHECK(pool.stats.hits == 1);
+  auto const block_size = pool_class_size(pool_size_class(1000));
+  OMEGA_H_CHECK(pool.stats.bytes_in_use == 2 * block_size);
+  deallocate(pool, c, 1000);
+  deallocate(pool, d, 1000);
+  OMEGA_H_CHECK(pool.stats.bytes_in_use == 0);
+  OMEGA_H_CHECK(pool.stats.bytes_requested == 0);
+  OMEGA_H_CHECK(fragmentation(pool.stats) == 1.0);
+  OMEGA_H_CHECK(hit_rate(pool.stats) == 0.25);
+}
+
+static void test_thread_safe_pool() {
+  ThreadSafePool pool(host_malloc, host_free);
+  constexpr int nthreads = 4;
+  constexpr int nblocks = 1000;
+  auto block_size = [](int i) { return std::size_t(8 + (i % 13) * 100); };
+  std::vector<std::vector<void*>> blocks(nthreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nthreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < nblocks; ++i) {
+        auto const p = allocate(pool, block_size(i));
+        std::memset(p, t, block_size(i));
+        blocks[std::size_t(t)].push_back(p);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  threads.clear();
+  /* each thread frees blocks allocated by another one */
+  for (int t = 0; t < nthreads; ++t) {
+    threads.emplace_back([&, t]() {
+      auto& other = blocks[std::size_t((t + 1) % nthreads)];
+      for (int i = 0; i < nblocks; ++i) {
+        deallocate(pool, other[std::size_t(i)], block_size(i));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  /* exiting threads returned their magazines to the shared pool */
+  auto const stats = get_stats(pool);
+  OMEGA_H_CHECK(stats.bytes_in_use == 0);
+  OMEGA_H_CHECK(stats.bytes_requested == 0);
+  auto const nallocs = std::size_t(nthreads * nblocks);
+  OMEGA_H_CHECK(stats.hits + stats.misses == nallocs);
+}
+
+static void test_scoped_arena() {
+#ifndef OMEGA_H_USE_KOKKOS
+  OMEGA_H_CHECK(current_arena() == nullptr);
+  LOs escaped;
+  LOs promoted;
+  {
+    ScopedArena arena(1 << 16);
+    OMEGA_H_CHECK(current_arena() == &arena);
+    LOs a(100, 0, 1);
+    OMEGA_H_CHECK(is_arena_allocated(a.data()));
+    OMEGA_H_CHECK(reinterpret_cast<std::uintptr_t>(a.data()) %
+                      ARENA_ALIGNMENT ==
+                  0);
+    {
+      ScopedArena inner(1 << 16);
+      Write<Real> b(10, 1.0);
+      OMEGA_H_CHECK(inner.owns(b.data()));
+      OMEGA_H_CHECK(!arena.owns(b.data()));
+    }
+    /* too large for this arena */
+    Write<Real> big(1 << 14);
+    OMEGA_H_CHECK(!is_arena_allocated(big.data()));
+    escaped = a;
+    promoted = promote_from_arena(a);
+    OMEGA_H_CHECK(!is_arena_allocated(promoted.data()));
+    OMEGA_H_CHECK(promoted == a);
+    auto const nallocs = arena.nallocs();
+    for (int i = 0; i < 100; ++i) Write<I8> c(100);
+    OMEGA_H_CHECK(arena.nallocs() == nallocs + 100);
+    OMEGA_H_CHECK(arena.bytes_reserved() == (1 << 16));
+  }
+  OMEGA_H_CHECK(current_arena() == nullptr);
+  OMEGA_H_CHECK(escaped == LOs(100, 0, 1));
+  OMEGA_H_CHECK(promoted == escaped);
+  /* arrays handed to other threads die there, both while the arena is
+     open and after it closed */
+  {
+    std::vector<LOs> before(8);
+    std::vector<LOs> after(8);
+    {
+      ScopedArena arena(1 << 16);
+      for (auto& a : before) a = LOs(100, 0, 1);
+      for (auto& a : after) a = LOs(100, 0, 1);
+      std::vector<std::thread> threads;
+      for (auto& a : before) threads.emplace_back([&a]() { a = LOs(); });
+      for (auto& thread : threads) thread.join();
+      /* the chunk is still held by the arrays in after */
+      LOs c(100, 0, 1);
+      OMEGA_H_CHECK(after[0] == c);
+    }
+    std::vector<std::thread> threads;
+    for (auto& a : after) threads.emplace_back([&a]() { a = LOs(); });
+    for (auto& thread : threads) thread.join();
+  }
+#endif
+}
+
+static void test_lazy_expressions(Library* lib) {
+  Reals a({1.0, -2.0, 3.0, -4.0});
+  Reals b({2.0, 2.0, 0.0, 4.0});
+  Reals c({0.5, 0.5, 0.5, 0.5});
+  OMEGA_H_CHECK(are_close(evaluate(lazy(a) * lazy(b) + lazy(c)),
+      add_each(Reals(multiply_each(a, b)), c)));
+  OMEGA_H_CHECK(are_close(evaluate(2.0 * lazy(a) - 1.0),
+      Reals({1.0, -5.0, 5.0, -9.0})));
+  OMEGA_H_CHECK(are_close(evaluate(-lazy(a) / lazy(c)),
+      Reals({-2.0, 4.0, -6.0, 8.0})));
+  Reals z({0.0, 2.0, 0.0, 8.0});
+  OMEGA_H_CHECK(are_close(evaluate(divide_each_maybe_zero(lazy(z), lazy(b))),
+      divide_each_maybe_zero(z, b)));
+  OMEGA_H_CHECK(evaluate(each_lt(fabs_each(lazy(a)), 2.5)) ==
+                Bytes({1, 1, 0, 0}));
+  OMEGA_H_CHECK(
+      evaluate(each_max_with(lazy(a), 0.0)) == each_max_with(a, 0.0));
+  OMEGA_H_CHECK(evaluate(get_component(lazy(a), 2, 1)) ==
+                get_component(a, 2, 1));
+  OMEGA_H_CHECK(evaluate(ternary_each(each_gt(lazy(a), 0.0), lazy(a),
+                    lazy(b))) == Reals({1.0, 2.0, 3.0, 4.0}));
+  OMEGA_H_CHECK(get_sum(lazy(a) * lazy(b)) == -18.0);
+  OMEGA_H_CHECK(get_min(fabs_each(lazy(a))) == 1.0);
+  OMEGA_H_CHECK(get_max(get_component(lazy(a), 2, 0)) == 3.0);
+  OMEGA_H_CHECK(get_min(lib->world(), each_leq_to(lazy(b), 4.0)) == 1);
+  OMEGA_H_CHECK(get_sum(lazy(LOs({1, 2, 3})) * 2) == 12);
+}
+
+static void test_thread_pool(Library* lib) {
+  auto const old_nthreads = lib->num_threads();
+  for (int nthreads : {1, 3, 4}) {
+    lib->set_num_threads(nthreads);
+    LO const n = 100 * 1000 + 7;
+    auto const nchunks = get_num_chunks(n);
+    OMEGA_H_CHECK(nchunks >= 1);
+    /* every iteration is visited exactly once */
+    std::vector<LO> visits(std::size_t(n), 0);
+    std::vector<LO> chunk_of(std::size_t(n), -1);
+    thread_pool_run(n, nchunks, [&](LO chunk, LO begin, LO end) {
+      for (LO i = begin; i < end; ++i) {
+        ++visits[std::size_t(i)];
+        chunk_of[std::size_t(i)] = chunk;
+      }
+    });
+    for (auto v : visits) OMEGA_H_CHECK(v == 1);
+    OMEGA_H_CHECK(chunk_of.front() == 0);
+    OMEGA_H_CHECK(chunk_of.back() == nchunks - 1);
+    /* the backend entry points agree with the serial answers */
+    auto const ones = Read<I8>(n, 1);
+    auto const offsets = offset_scan(ones);
+    OMEGA_H_CHECK(offsets == LOs(n + 1, 0, 1));
+    OMEGA_H_CHECK(get_sum(LOs(n, 0, 1)) == LO((I64(n) * (n - 1)) / 2));
+    OMEGA_H_CHECK(get_max(LOs(n, 0, 1)) == n - 1);
+    Write<LO> counter(1, 0);
+    parallel_for(
+        n, OMEGA_H_LAMBDA(LO) { atomic_increment(&counter[0]); });
+    OMEGA_H_CHECK(counter.get(0) == n);
+  }
+  lib->set_num_threads(old_nthreads);
+}
+
 int main(int argc, char** argv) {
   auto lib = Library(&argc, &argv);
   OMEGA_H_CHECK(std::string(lib.version()) == OMEGA_H_SEMVER);
@@ -447,6 +637,11 @@ int main(int argc, char** argv) {
   test_expr2();
   test_array_from_kokkos();
   test_filter_marked();
+  test_pool();
+  test_thread_safe_pool();
+  test_scoped_arena();
+  test_lazy_expressions(&lib);
+  test_thread_pool(&lib);
   fprintf(stderr, "done\n");
   return 0;
 }
@@ -1220,6 +1220,11 @@ static void test_file(Library* lib) {
     auto mesh0 = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 1, 1, 1);
     test_file(lib, &mesh0);
   }
+  {
+    auto mesh0 = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 1, 1, 1);
+    mesh0.add_tag(VERT, "speed", 1, Read<F32>(mesh0.nverts(), 0.5f, 0.25f));
+    test_file(lib, &mesh0);
+  }
   {
     Mesh mesh0(lib);
     build_empty_mesh(&mesh0, 3);
@@ -1484,6 +1489,8 @@ static void test_read_vtu(Mesh* mesh0) {
 static void test_read_vtu(Library* lib) {
   auto mesh0 = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 1, 1, 1);
   test_read_vtu(&mesh0);
+  mesh0.add_tag(VERT, "speed", 1, Read<F32>(mesh0.nverts(), 0.5f, 0.25f));
+  test_read_vtu(&mesh0);
 }
 
 int main(int argc, char** argv) {
@@ -1,23 +1,38 @@
 #include "Omega_h_align.hpp"
+#include "Omega_h_arena.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_bbox.hpp"
 #include "Omega_h_build.hpp"
+#include "Omega_h_coarsen.hpp"
+#include "Omega_h_collapse.hpp"
 #include "Omega_h_compare.hpp"
 #include "Omega_h_confined.hpp"
+#include "Omega_h_element.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_hilbert.hpp"
 #include "Omega_h_hypercube.hpp"
+#include "Omega_h_indset.hpp"
 #include "Omega_h_inertia.hpp"
 #include "Omega_h_int_scan.hpp"
+#include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
 #include "Omega_h_mesh.hpp"
+#include "Omega_h_metric.hpp"
 #include "Omega_h_quality.hpp"
+#include "Omega_h_quality_cache.hpp"
 #include "Omega_h_recover.hpp"
+#include "Omega_h_refine.hpp"
 #include "Omega_h_refine_qualities.hpp"
 #include "Omega_h_shape.hpp"
+#include "Omega_h_structured.hpp"
+#include "Omega_h_swap.hpp"
 #include "Omega_h_swap2d.hpp"
+#include "Omega_h_swap3d.hpp"
 #include "Omega_h_swap3d_choice.hpp"
 #include "Omega_h_swap3d_loop.hpp"
+#include "Omega_h_transfer.hpp"
 
+#include <algorithm>
 #include <sstream>
 
 using namespace Omega_h;
@@ -323,6 +338,275 @@ static void test_dual(Library* lib) {
   OMEGA_H_CHECK(tt2t == LOs({1, 0}));
 }
 
+static void test_cache_budget(Library* lib) {
+  auto mesh =
+      build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  auto const v2v = mesh.ask_star(VERT);
+  auto const v2r = mesh.ask_up(VERT, REGION);
+  auto const sizes = mesh.ask_sizes();
+  OMEGA_H_CHECK(mesh.has_adj(VERT, VERT));
+  auto const unlimited_bytes = mesh.cache_bytes();
+  OMEGA_H_CHECK(unlimited_bytes > 0);
+  /* only the most recently used entry can stay */
+  mesh.set_cache_budget(1);
+  OMEGA_H_CHECK(!mesh.has_adj(VERT, VERT));
+  OMEGA_H_CHECK(!mesh.has_adj(VERT, REGION));
+  OMEGA_H_CHECK(mesh.has_tag(REGION, "size"));
+  OMEGA_H_CHECK(mesh.cache_bytes() == sizes.size() * sizeof(Real));
+  /* downward adjacencies given by set_ents are never evicted */
+  OMEGA_H_CHECK(mesh.has_adj(REGION, FACE));
+  OMEGA_H_CHECK(mesh.ask_star(VERT).ab2b == v2v.ab2b);
+  OMEGA_H_CHECK(!mesh.has_tag(REGION, "size"));
+  OMEGA_H_CHECK(mesh.ask_up(VERT, REGION).ab2b == v2r.ab2b);
+  OMEGA_H_CHECK(!mesh.has_adj(VERT, VERT));
+  OMEGA_H_CHECK(mesh.ask_sizes() == sizes);
+  mesh.set_cache_budget(0);
+  mesh.ask_star(VERT);
+  mesh.ask_up(VERT, REGION);
+  OMEGA_H_CHECK(mesh.has_adj(VERT, VERT));
+  OMEGA_H_CHECK(mesh.has_tag(REGION, "size"));
+  OMEGA_H_CHECK(mesh.cache_bytes() <= unlimited_bytes);
+}
+
+static void test_cold_tag_compression(Library* lib) {
+#ifdef OMEGA_H_USE_ZLIB
+  auto mesh =
+      build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 8, 8, 8);
+  auto const coords = mesh.coords();
+  auto const cold = deep_copy(coords);
+  mesh.add_tag(VERT, "cold", mesh.dim(), Reals(cold));
+  mesh.set_cold_tag_compression(4);
+  for (Int i = 0; i < 8; ++i) mesh.coords();
+  OMEGA_H_CHECK(mesh.get_tagbase(VERT, "cold")->is_compressed());
+  OMEGA_H_CHECK(!mesh.get_tagbase(VERT, "coordinates")->is_compressed());
+  OMEGA_H_CHECK(mesh.get_tagbase(VERT, "cold")->nbytes() <
+                std::size_t(cold.size()) * sizeof(Real));
+  {
+    /* the mesh keeps what it decompresses, past the arena */
+    ScopedArena arena;
+    auto const decompressed = mesh.get_array<Real>(VERT, "cold");
+    OMEGA_H_CHECK(!is_arena_allocated(decompressed.data()));
+  }
+  OMEGA_H_CHECK(mesh.get_array<Real>(VERT, "cold") == Reals(cold));
+  OMEGA_H_CHECK(!mesh.get_tagbase(VERT, "cold")->is_compressed());
+  /* a lookup that triggers the sweep leaves the tag it returns alone */
+  mesh.set_cold_tag_compression(1);
+  OMEGA_H_CHECK(!mesh.get_tagbase(VERT, "cold")->is_compressed());
+  OMEGA_H_CHECK(mesh.get_tagbase(VERT, "coordinates")->is_compressed());
+#else
+  (void)lib;
+#endif
+}
+
+static void test_segmented_tags(Library* lib) {
+  auto const a = Reals(1000, 0.0, 1.0);
+  auto const b = Reals(1000, 0.0, 1.0);
+  Tag<Real> tag("x", 1);
+  tag.set_segments({{a, 0, 300}, {a, 300, 200}, {b, 500, 500}});
+  OMEGA_H_CHECK(tag.is_segmented());
+  OMEGA_H_CHECK(tag.nbytes() == 1000 * sizeof(Real));
+  auto const middle = tag.segments(400, 600);
+  OMEGA_H_CHECK(middle.size() == 2);
+  OMEGA_H_CHECK(middle[0].begin == 400 && middle[0].size == 100);
+  OMEGA_H_CHECK(middle[1].begin == 500 && middle[1].size == 100);
+  OMEGA_H_CHECK(tag.is_segmented());
+  auto const expected = Reals(1000, 0.0, 1.0);
+  OMEGA_H_CHECK(tag.array() == expected);
+  OMEGA_H_CHECK(!tag.is_segmented());
+  /* too short to be worth keeping apart */
+  tag.set_segments({{a, 0, 10}, {b, 10, 10}});
+  OMEGA_H_CHECK(!tag.is_segmented());
+  OMEGA_H_CHECK(tag.array().size() == 20);
+  /* local refinement shares the unchanged values with the old mesh */
+  auto mesh = build_box(lib->self(), OMEGA_H_SIMPLEX, 1., 1., 0., 64, 64, 0);
+  auto const coords = mesh.coords();
+  auto const nverts = mesh.nverts();
+  auto const near_corner = 0.05;
+  Write<Real> metric(nverts);
+  Write<Real> u(nverts);
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto const x = get_vector<2>(coords, v);
+    auto const h = (x[0] + x[1] < near_corner) ? 1.0 / 256.0 : 1.0 / 32.0;
+    metric[v] = metric_eigenvalue_from_length(h);
+    u[v] = x[0] + 2.0 * x[1];
+  };
+  parallel_for(nverts, std::move(f));
+  mesh.add_tag(VERT, "metric", 1, Reals(metric));
+  mesh.add_tag(VERT, "u", 1, Reals(u));
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  opts.xfer_opts.type_map["u"] = OMEGA_H_LINEAR_INTERP;
+  OMEGA_H_CHECK(refine_by_size(&mesh, opts));
+  OMEGA_H_CHECK(mesh.nverts() > nverts);
+  OMEGA_H_CHECK(mesh.get_tagbase(VERT, "u")->nbytes() ==
+                std::size_t(mesh.nverts()) * sizeof(Real));
+  OMEGA_H_CHECK(as<Real>(mesh.get_tagbase(VERT, "u"))->is_segmented());
+  auto const new_coords = mesh.coords();
+  auto const expected_u =
+      add_each(get_component(new_coords, 2, 0),
+          multiply_each_by(get_component(new_coords, 2, 1), 2.0));
+  OMEGA_H_CHECK(are_close(mesh.get_array<Real>(VERT, "u"), expected_u));
+  OMEGA_H_CHECK(!as<Real>(mesh.get_tagbase(VERT, "u"))->is_segmented());
+}
+
+static void test_f32_tags(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 2, 2, 0);
+  auto x0 = array_cast<F32>(get_component(mesh.coords(), 2, 0));
+  mesh.add_tag(VERT, "x", 1, x0);
+  OMEGA_H_CHECK(mesh.get_tagbase(VERT, "x")->type() == OMEGA_H_F32);
+  mesh.sync_tag(VERT, "x");
+  mesh.reduce_tag(VERT, "x", OMEGA_H_MAX);
+  OMEGA_H_CHECK(get_max(mesh.comm(), mesh.get_array<F32>(VERT, "x")) == 1.0f);
+  auto opts = AdaptOpts(&mesh);
+  opts.xfer_opts.type_map["x"] = OMEGA_H_LINEAR_INTERP;
+  mesh.add_tag(VERT, "metric", 1,
+      Reals(mesh.nverts(), metric_eigenvalue_from_length(0.3)));
+  OMEGA_H_CHECK(refine_by_size(&mesh, opts));
+  OMEGA_H_CHECK(mesh.get_tagbase(VERT, "x")->type() == OMEGA_H_F32);
+  /* a linear field is reproduced exactly at the new midpoints */
+  auto x = array_cast<Real>(mesh.get_array<F32>(VERT, "x"));
+  OMEGA_H_CHECK(are_close(x, get_component(mesh.coords(), 2, 0)));
+}
+
+static void test_batched_transfer(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  auto const x = get_component(mesh.coords(), 2, 0);
+  auto const y = get_component(mesh.coords(), 2, 1);
+  /* inherited on all dimensions */
+  for (Int dim = 0; dim <= mesh.dim(); ++dim) {
+    mesh.add_tag(dim, "e", 1, Reals(mesh.nents(dim), 2.0));
+    mesh.add_tag(dim, "f", 1, Read<I8>(mesh.nents(dim), 3));
+    mesh.add_tag(dim, "g", 1, Reals(mesh.nents(dim), 4.0));
+  }
+  for (auto name : {"e", "f", "g"}) {
+    opts.xfer_opts.type_map[name] = OMEGA_H_INHERIT;
+  }
+  /* linear fields of several types and widths, interleaved so that
+     batches don't follow the order of the tags */
+  mesh.add_tag(VERT, "a", 1, x);
+  mesh.add_tag(VERT, "b", 2, interleave(std::vector<Reals>{x, y}));
+  mesh.add_tag(VERT, "c", 1, array_cast<F32>(y));
+  mesh.add_tag(VERT, "d", 1, y);
+  for (auto name : {"a", "b", "c", "d"}) {
+    opts.xfer_opts.type_map[name] = OMEGA_H_LINEAR_INTERP;
+  }
+  auto tag_order = [](Mesh* m) {
+    std::vector<std::string> names;
+    for (Int i = 0; i < m->ntags(VERT); ++i) {
+      auto const& name = m->get_tag(VERT, i)->name();
+      if (name.size() == 1) names.push_back(name);
+    }
+    return names;
+  };
+  auto const order = tag_order(&mesh);
+  mesh.add_tag(VERT, "metric", 1,
+      Reals(mesh.nverts(), metric_eigenvalue_from_length(0.1)));
+  OMEGA_H_CHECK(refine_by_size(&mesh, opts));
+  OMEGA_H_CHECK(tag_order(&mesh) == order);
+  auto const new_x = get_component(mesh.coords(), 2, 0);
+  auto const new_y = get_component(mesh.coords(), 2, 1);
+  OMEGA_H_CHECK(are_close(mesh.get_array<Real>(VERT, "a"), new_x));
+  OMEGA_H_CHECK(are_close(mesh.get_array<Real>(VERT, "b"),
+      interleave(std::vector<Reals>{new_x, new_y})));
+  OMEGA_H_CHECK(are_close(
+      array_cast<Real>(mesh.get_array<F32>(VERT, "c")), new_y, 1e-6));
+  OMEGA_H_CHECK(are_close(mesh.get_array<Real>(VERT, "d"), new_y));
+  for (Int dim = 0; dim <= mesh.dim(); ++dim) {
+    OMEGA_H_CHECK(mesh.get_array<Real>(dim, "e") ==
+                  Reals(mesh.nents(dim), 2.0));
+    OMEGA_H_CHECK(mesh.get_array<I8>(dim, "f") ==
+                  Read<I8>(mesh.nents(dim), 3));
+    OMEGA_H_CHECK(mesh.get_array<Real>(dim, "g") ==
+                  Reals(mesh.nents(dim), 4.0));
+  }
+  mesh.set_tag(VERT, "metric",
+      Reals(mesh.nverts(), metric_eigenvalue_from_length(0.4)));
+  OMEGA_H_CHECK(coarsen_by_size(&mesh, opts));
+  OMEGA_H_CHECK(tag_order(&mesh) == order);
+  for (Int dim = 0; dim <= mesh.dim(); ++dim) {
+    OMEGA_H_CHECK(mesh.get_array<I8>(dim, "f") ==
+                  Read<I8>(mesh.nents(dim), 3));
+    OMEGA_H_CHECK(mesh.get_array<Real>(dim, "g") ==
+                  Reals(mesh.nents(dim), 4.0));
+  }
+}
+
+/* densities and pointwise fields reach the new elements after their size
+   and quality, as they did before batching, and batching changes no value */
+static void test_batched_element_transfer(Library* lib) {
+  auto adapt = [&](Int batch_size) {
+    lib->set_transfer_batch_size(batch_size);
+    auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+    auto opts = AdaptOpts(&mesh);
+    opts.verbosity = SILENT;
+    /* skew the interior so that there are edges worth swapping */
+    auto const coords = mesh.coords();
+    auto skewed = Write<Real>(coords.size());
+    auto skew = OMEGA_H_LAMBDA(LO v) {
+      auto const x = coords[v * 2 + 0];
+      auto const y = coords[v * 2 + 1];
+      skewed[v * 2 + 0] = x + 3.0 * x * (1.0 - x) * y * (1.0 - y);
+      skewed[v * 2 + 1] = y;
+    };
+    parallel_for(mesh.nverts(), skew);
+    mesh.set_coords(skewed);
+    auto const nelems = mesh.nelems();
+    mesh.add_tag(mesh.dim(), "p", 1, Reals(nelems, 1.0, 0.5));
+    mesh.add_tag(mesh.dim(), "r", 1, Reals(nelems, 2.0, 0.25));
+    mesh.add_tag(mesh.dim(), "q", 2, Reals(2 * nelems, 0.0, 1.0));
+    mesh.add_tag(mesh.dim(), "s", 1, Reals(nelems, 3.0, 0.125));
+    opts.xfer_opts.type_map["p"] = OMEGA_H_POINTWISE;
+    opts.xfer_opts.type_map["q"] = OMEGA_H_POINTWISE;
+    opts.xfer_opts.type_map["r"] = OMEGA_H_DENSITY;
+    opts.xfer_opts.type_map["s"] = OMEGA_H_DENSITY;
+    mesh.add_tag(VERT, "metric", 1,
+        Reals(mesh.nverts(), metric_eigenvalue_from_length(0.25)));
+    /* every element is a swap candidate */
+    auto swap_opts = opts;
+    swap_opts.min_quality_desired = 1.0;
+    OMEGA_H_CHECK(swap_edges(&mesh, swap_opts));
+    mesh.set_tag(VERT, "metric",
+        Reals(mesh.nverts(), metric_eigenvalue_from_length(0.1)));
+    OMEGA_H_CHECK(refine_by_size(&mesh, opts));
+    std::vector<std::string> order;
+    for (Int i = 0; i < mesh.ntags(mesh.dim()); ++i) {
+      order.push_back(mesh.get_tag(mesh.dim(), i)->name());
+    }
+    std::vector<std::string> expected;
+    for (auto name : {"size", "quality", "r", "s", "p", "q"}) {
+      if (mesh.has_tag(mesh.dim(), name)) expected.push_back(name);
+    }
+    auto is_expected = [&](std::string const& name) {
+      return std::find(expected.begin(), expected.end(), name) !=
+             expected.end();
+    };
+    order.erase(std::remove_if(order.begin(), order.end(),
+                    [&](std::string const& name) { return !is_expected(name); }),
+        order.end());
+    OMEGA_H_CHECK(order == expected);
+    mesh.set_tag(VERT, "metric",
+        Reals(mesh.nverts(), metric_eigenvalue_from_length(0.4)));
+    OMEGA_H_CHECK(coarsen_by_size(&mesh, opts));
+    return mesh;
+  };
+  auto batched = adapt(TRANSFER_BATCH_SIZE);
+  auto unbatched = adapt(1);
+  lib->set_transfer_batch_size(TRANSFER_BATCH_SIZE);
+  auto const dim = batched.dim();
+  OMEGA_H_CHECK(batched.nelems() == unbatched.nelems());
+  OMEGA_H_CHECK(batched.ntags(dim) == unbatched.ntags(dim));
+  for (Int i = 0; i < batched.ntags(dim); ++i) {
+    OMEGA_H_CHECK(batched.get_tag(dim, i)->name() ==
+                  unbatched.get_tag(dim, i)->name());
+  }
+  for (auto name : {"p", "q", "r", "s"}) {
+    OMEGA_H_CHECK(batched.get_array<Real>(dim, name) ==
+                  unbatched.get_array<Real>(dim, name));
+  }
+}
+
 static void test_quality() {
   Few<Vector<2>, 3> perfect_tri(
       {vector_2(1, 0), vector_2(0, std::sqrt(3.0)), vector_2(-1, 0)});
@@ -766,6 +1050,232 @@ void test_copy_constructor(Library* lib)
   OMEGA_H_CHECK(!(mesh_a.coords() == mesh_b.coords()));
 }
 
+static void check_same_adj(Adj const& a, Adj const& b) {
+  OMEGA_H_CHECK(a.a2ab.exists() == b.a2ab.exists());
+  if (a.a2ab.exists()) OMEGA_H_CHECK(a.a2ab == b.a2ab);
+  OMEGA_H_CHECK(a.ab2b == b.ab2b);
+  OMEGA_H_CHECK(a.codes.exists() == b.codes.exists());
+  if (a.codes.exists()) OMEGA_H_CHECK(a.codes == b.codes);
+}
+
+static void test_structured_box(Library* lib, LO nx, LO ny, LO nz) {
+  auto mesh = build_structured_box(lib->self(), 1., 1., 1., nx, ny, nz);
+  OMEGA_H_CHECK(mesh.is_structured());
+  auto const dim = mesh.dim();
+  auto const box = *mesh.structured();
+  /* same entity counts as the unstructured box */
+  auto unstructured =
+      build_box(lib->self(), OMEGA_H_HYPERCUBE, 1., 1., 1., nx, ny, nz);
+  for (Int d = 0; d <= dim; ++d) {
+    OMEGA_H_CHECK(mesh.nents(d) == unstructured.nents(d));
+  }
+  /* the formulas match what reflect_down() finds from vertices */
+  Mesh reflected(lib);
+  reflected.set_comm(lib->self());
+  reflected.set_family(OMEGA_H_HYPERCUBE);
+  reflected.set_dim(dim);
+  reflected.set_verts(mesh.nverts());
+  reflected.set_ents(EDGE, structured_adj(box, EDGE, VERT));
+  for (Int d = 2; d <= dim; ++d) {
+    auto const down = reflect_down(mesh.ask_verts_of(d),
+        reflected.ask_verts_of(d - 1), reflected.ask_up(VERT, d - 1),
+        OMEGA_H_HYPERCUBE, d, d - 1);
+    check_same_adj(down, mesh.ask_down(d, d - 1));
+    reflected.set_ents(d, down);
+  }
+  /* and every other adjacency matches the unstructured derivation */
+  for (Int from = 0; from <= dim; ++from) {
+    for (Int to = 0; to <= dim; ++to) {
+      if (from < to) {
+        check_same_adj(mesh.ask_up(from, to), reflected.ask_up(from, to));
+      } else if (to < from) {
+        check_same_adj(mesh.ask_down(from, to), reflected.ask_down(from, to));
+      }
+    }
+  }
+  /* nothing was stored along the way */
+  OMEGA_H_CHECK(mesh.cache_bytes() == 0);
+  check_same_adj(mesh.ask_star(VERT), reflected.ask_star(VERT));
+  check_same_adj(mesh.ask_dual(), reflected.ask_dual());
+  /* except the star and dual, which are cached */
+  OMEGA_H_CHECK(mesh.has_adj(VERT, VERT));
+  OMEGA_H_CHECK(mesh.has_adj(dim, dim));
+  OMEGA_H_CHECK(mesh.cache_bytes() > 0);
+  /* the classification matches the unstructured box */
+  for (Int d = 0; d <= dim; ++d) {
+    OMEGA_H_CHECK(get_sum(mesh.get_array<ClassId>(d, "class_id")) ==
+                  get_sum(unstructured.get_array<ClassId>(d, "class_id")));
+  }
+  /* explicit arrays when asked for, and after a modification */
+  auto materialized = mesh;
+  materialized.materialize_structured();
+  OMEGA_H_CHECK(!materialized.is_structured());
+  OMEGA_H_CHECK(mesh.is_structured());
+  check_same_adj(materialized.ask_up(VERT, dim), mesh.ask_up(VERT, dim));
+  auto reordered = mesh;
+  reorder_by_hilbert(&reordered);
+  OMEGA_H_CHECK(!reordered.is_structured());
+  OMEGA_H_CHECK(reordered.nverts() == mesh.nverts());
+  for (Int d = 1; d <= dim; ++d) {
+    OMEGA_H_CHECK(reordered.nents(d) == mesh.nents(d));
+    OMEGA_H_CHECK(reordered.ask_up(VERT, d).ab2b.size() ==
+                  mesh.ask_up(VERT, d).ab2b.size());
+  }
+}
+
+static void test_structured_box(Library* lib) {
+  test_structured_box(lib, 4, 0, 0);
+  test_structured_box(lib, 3, 2, 0);
+  test_structured_box(lib, 3, 2, 4);
+}
+
+static void test_compressed_graph(Library* lib) {
+  /* large jumps in both directions and an empty row */
+  auto const g = Graph(LOs({0, 3, 4, 4}), LOs({1000000, 0, 2, 5}));
+  auto const cg = compress_graph(g);
+  OMEGA_H_CHECK(cg.bytes.size() == 3 + 3 + 1 + 1);
+  OMEGA_H_CHECK(decompress_graph(cg) == g);
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 4, 4, 4);
+  auto const star = mesh.ask_star(VERT);
+  auto const cstar = mesh.ask_compressed_star(VERT);
+  OMEGA_H_CHECK(decompress_graph(cstar) == star);
+  OMEGA_H_CHECK(cstar.nbytes() <
+                std::size_t(star.a2ab.size() + star.ab2b.size()) * sizeof(LO));
+  OMEGA_H_CHECK(mesh.cache_bytes() >= cstar.nbytes());
+  auto const coords = mesh.coords();
+  for (auto op : {OMEGA_H_MIN, OMEGA_H_MAX, OMEGA_H_SUM}) {
+    OMEGA_H_CHECK(graph_reduce(cstar, coords, 3, op) ==
+                  graph_reduce(star, coords, 3, op));
+  }
+  auto const weights = Reals(star.nedges(), 0.5);
+  OMEGA_H_CHECK(are_close(graph_weighted_average(cstar, weights, coords, 3),
+      graph_weighted_average(star, weights, coords, 3)));
+  mesh.set_cache_budget(1);
+  OMEGA_H_CHECK(mesh.ask_compressed_star(EDGE).a2ab.size() ==
+                mesh.nedges() + 1);
+  OMEGA_H_CHECK(mesh.cache_bytes() ==
+                mesh.ask_compressed_star(EDGE).nbytes());
+}
+
+/* the upward adjacencies modification carried over
+   are the ones that would have been derived */
+static void check_updated_ups(Mesh* mesh) {
+  auto const family = mesh->family();
+  for (Int d = EDGE; d <= mesh->dim(); ++d) {
+    for (Int low_dim : {Int(VERT), Int(d - 1)}) {
+      OMEGA_H_CHECK(mesh->has_adj(low_dim, d));
+      auto const up = mesh->ask_up(low_dim, d);
+      auto const derived = invert_adj(mesh->ask_down(d, low_dim),
+          element_degree(family, d, low_dim), mesh->nents(low_dim), d,
+          low_dim);
+      OMEGA_H_CHECK(up.a2ab == derived.a2ab);
+      OMEGA_H_CHECK(up.ab2b == derived.ab2b);
+      OMEGA_H_CHECK(up.codes == derived.codes);
+    }
+  }
+}
+
+static void test_incremental_up(Library* lib) {
+  auto mesh = build_box(lib->self(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  for (Int d = EDGE; d <= mesh.dim(); ++d) {
+    mesh.ask_up(VERT, d);
+    mesh.ask_up(d - 1, d);
+  }
+  mesh.add_tag(VERT, "metric", 1,
+      Reals(mesh.nverts(), metric_eigenvalue_from_length(0.3)));
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  OMEGA_H_CHECK(refine_by_size(&mesh, opts));
+  check_updated_ups(&mesh);
+  mesh.set_tag(VERT, "metric",
+      Reals(mesh.nverts(), metric_eigenvalue_from_length(0.9)));
+  OMEGA_H_CHECK(coarsen_by_size(&mesh, opts));
+  check_updated_ups(&mesh);
+}
+
+/* cached cavity qualities always match freshly computed ones */
+static void check_cavity_quality_caches(Mesh* mesh, AdaptOpts const& opts) {
+  mesh->set_parting(OMEGA_H_GHOSTED);
+  auto all_edges = LOs(mesh->nedges(), 0, 1);
+  auto codes = Read<I8>(mesh->nedges(), I8(COLLAPSE_BOTH));
+  auto quals = coarsen_qualities(mesh, all_edges, codes);
+  for (Int i = 0; i < 2; ++i) {
+    OMEGA_H_CHECK(ask_coarsen_qualities(mesh, all_edges, codes) == quals);
+  }
+  auto interior = collect_marked(mark_by_class_dim(mesh, EDGE, mesh->dim()));
+  Reals swap_quals, cached_swap_quals;
+  Read<I8> swap_configs, cached_swap_configs;
+  swap3d_qualities(mesh, opts, interior, &swap_quals, &swap_configs);
+  for (Int i = 0; i < 2; ++i) {
+    ask_swap3d_qualities(
+        mesh, opts, interior, &cached_swap_quals, &cached_swap_configs);
+    OMEGA_H_CHECK(cached_swap_quals == swap_quals);
+    OMEGA_H_CHECK(cached_swap_configs == swap_configs);
+  }
+}
+
+static void test_cavity_quality_caches(Library* lib) {
+  for (bool cache_collapses : {true, false}) {
+    auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+    mesh.add_tag(VERT, "metric", 1,
+        Reals(mesh.nverts(), metric_eigenvalue_from_length(0.3)));
+    auto opts = AdaptOpts(&mesh);
+    opts.verbosity = SILENT;
+    opts.should_cache_collapse_qualities = cache_collapses;
+    {
+      ScopedCavityQualityCaches caches(&mesh, opts);
+      OMEGA_H_CHECK(mesh.has_tag(EDGE, COLLAPSE_QUALITIES) == cache_collapses);
+      OMEGA_H_CHECK(mesh.has_tag(EDGE, SWAP_QUALITIES));
+      check_cavity_quality_caches(&mesh, opts);
+      OMEGA_H_CHECK(refine_by_size(&mesh, opts));
+      check_cavity_quality_caches(&mesh, opts);
+      mesh.set_tag(VERT, "metric",
+          Reals(mesh.nverts(), metric_eigenvalue_from_length(0.6)));
+      check_cavity_quality_caches(&mesh, opts);
+      OMEGA_H_CHECK(coarsen_by_size(&mesh, opts));
+      check_cavity_quality_caches(&mesh, opts);
+      /* every element is a swap candidate */
+      auto swap_opts = opts;
+      swap_opts.min_quality_desired = 1.0;
+      swap_edges(&mesh, swap_opts);
+      check_cavity_quality_caches(&mesh, opts);
+      OMEGA_H_CHECK(mesh.has_tag(EDGE, COLLAPSE_QUALITIES) == cache_collapses);
+    }
+    OMEGA_H_CHECK(!mesh.has_tag(EDGE, COLLAPSE_QUALITIES));
+    OMEGA_H_CHECK(!mesh.has_tag(EDGE, SWAP_QUALITIES));
+  }
+}
+
+/* more local rounds only change when decisions are made, not which */
+static void test_indset(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto star = mesh.ask_star(EDGE);
+  auto cands = Read<I8>(mesh.nedges(), 1);
+  auto quals = Reals(mesh.nedges(), 1.0);
+  for (bool randomize : {false, true}) {
+    auto once = find_indset(&mesh, EDGE, quals, cands, randomize, 1);
+    auto often = find_indset(&mesh, EDGE, quals, cands, randomize, 4);
+    OMEGA_H_CHECK(once == often);
+    auto xadj = star.a2ab;
+    auto adj = star.ab2b;
+    auto owned = mesh.owned(EDGE);
+    Write<I8> ok(mesh.nedges());
+    auto f = OMEGA_H_LAMBDA(LO e) {
+      /* only owners see the whole star */
+      if (!owned[e]) {
+        ok[e] = 1;
+        return;
+      }
+      I8 nin = 0;
+      for (auto j = xadj[e]; j < xadj[e + 1]; ++j) nin += (often[adj[j]] == 1);
+      ok[e] = (often[e] == 1) ? (nin == 0) : (nin > 0);
+    };
+    parallel_for(mesh.nedges(), f);
+    OMEGA_H_CHECK(get_min(mesh.comm(), read(ok)) == 1);
+  }
+}
+
 int main(int argc, char** argv) {
   auto lib = Library(&argc, &argv);
   OMEGA_H_CHECK(std::string(lib.version()) == OMEGA_H_SEMVER);
@@ -779,6 +1289,17 @@ int main(int argc, char** argv) {
   test_bbox();
   test_star(&lib);
   test_dual(&lib);
+  test_cache_budget(&lib);
+  test_cold_tag_compression(&lib);
+  test_segmented_tags(&lib);
+  test_structured_box(&lib);
+  test_compressed_graph(&lib);
+  test_incremental_up(&lib);
+  test_f32_tags(&lib);
+  test_batched_transfer(&lib);
+  test_batched_element_transfer(&lib);
+  test_cavity_quality_caches(&lib);
+  test_indset(&lib);
   test_quality();
   test_inertial_bisect(&lib);
   test_average_field(&lib);